@@ -10,6 +10,7 @@
 
 #include "Data.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "eckit/utils/Compressor.h"
@@ -18,6 +19,7 @@
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Assert.h"
 #include "atlas_io/detail/Checksum.h"
+#include "atlas_io/detail/ChunkedCompression.h"
 
 namespace atlas {
 namespace io {
@@ -26,16 +28,32 @@ namespace io {
 
 Data::Data(void* p, size_t size): buffer_(p, size), size_(size) {}
 
+Data::Data(std::shared_ptr<const void> mapping, size_t size): size_(size), mapping_(std::move(mapping)) {}
+
+Data::Data(eckit::Buffer&& buffer, size_t size): buffer_(std::move(buffer)), size_(size) {}
+
+void Data::unmap() {
+    if (mapping_) {
+        eckit::Buffer copy(mapping_.get(), size_);
+        buffer_ = std::move(copy);
+        mapping_.reset();
+    }
+}
+
 std::uint64_t Data::write(Stream& out) const {
     ATLAS_IO_TRACE();
     if (size()) {
-        ATLAS_IO_ASSERT(buffer_.size() >= size());
-        return out.write(buffer_.data(), size());
+        ATLAS_IO_ASSERT(mapped() || buffer_.size() >= size());
+        return out.write(data(), size());
     }
     return 0;
 }
 
 std::uint64_t Data::read(Stream& in, size_t size) {
+    if (mapping_) {
+        mapping_.reset();
+        size_ = std::min(size_, buffer_.size());
+    }
     if (size > size_) {
         buffer_.resize(size);
         size_ = size;
@@ -51,6 +69,7 @@ void Data::compress(const std::string& compression) {
         if (dynamic_cast<eckit::NoCompressor*>(compressor.get())) {
             return;
         }
+        unmap();
         eckit::Buffer compressed(size_t(1.2 * size_));
         size_   = compressor->compress(buffer_, size_, compressed);
         buffer_ = std::move(compressed);
@@ -64,6 +83,7 @@ void Data::decompress(const std::string& compression, size_t uncompressed_size)
     if (dynamic_cast<eckit::NoCompressor*>(compressor.get())) {
         return;
     }
+    unmap();
 
     eckit::Buffer uncompressed(size_t(1.2 * uncompressed_size));
     compressor->uncompress(buffer_, size_, uncompressed, uncompressed_size);
@@ -71,25 +91,58 @@ void Data::decompress(const std::string& compression, size_t uncompressed_size)
     buffer_ = std::move(uncompressed);
 }
 
+void Data::compress(const std::string& compression, size_t chunk_size, size_t threads, bool checksum) {
+    if (chunk_size == 0) {
+        compress(compression);
+        return;
+    }
+    if (size_) {
+        eckit::Buffer compressed;
+        size_   = compress_chunks(compression, chunk_size, data(), size_, compressed, threads, checksum);
+        buffer_ = std::move(compressed);
+        mapping_.reset();
+    }
+}
+
+void Data::decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t threads) {
+    if (chunk_size == 0) {
+        decompress(compression, uncompressed_size);
+        return;
+    }
+    auto index         = read_chunk_index(data(), size_);
+    const char* chunks = static_cast<const char*>(data()) + chunk_index_size(index.size());
+
+    eckit::Buffer uncompressed(uncompressed_size);
+    decompress_chunks(compression, chunk_size, uncompressed_size, index, chunks, 0,
+                      size_ - chunk_index_size(index.size()), 0, uncompressed_size, uncompressed.data(), threads,
+                      false);
+    size_   = uncompressed_size;
+    buffer_ = std::move(uncompressed);
+    mapping_.reset();
+}
+
 void Data::clear() {
     buffer_ = eckit::Buffer{};
     size_   = 0;
+    mapping_.reset();
 }
 
 std::string Data::checksum(const std::string& algorithm) const {
-    return atlas::io::checksum(buffer_, size_, algorithm);
+    return atlas::io::checksum(data(), size_, algorithm);
 }
 
 void Data::assign(const Data& other) {
+    mapping_.reset();
     if (other.size() > buffer_.size()) {
         buffer_.resize(other.size());
     }
     size_ = other.size();
-    buffer_.copy(other.buffer_, size_);
+    buffer_.copy(other.data(), size_);
 }
 
 void Data::assign(const void* p, size_t s) {
-    if (s > size()) {
+    mapping_.reset();
+    if (s > buffer_.size()) {
         buffer_.resize(s);
     }
     size_ = s;
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 #include "eckit/io/Buffer.h"
 
@@ -25,13 +26,18 @@ class Data {
 public:
     Data() = default;
     Data(void*, size_t);
+    Data(std::shared_ptr<const void> mapping, size_t);  // read-only view of memory-mapped data, no copy
+    Data(eckit::Buffer&&, size_t);
     Data(Data&&)            = default;
     Data& operator=(Data&&) = default;
 
     operator const void*() const { return data(); }
-    const void* data() const { return buffer_.data(); }
+    const void* data() const { return mapping_ ? mapping_.get() : buffer_.data(); }
     size_t size() const { return size_; }
 
+    bool mapped() const { return bool(mapping_); }
+    const std::shared_ptr<const void>& mapping() const { return mapping_; }
+
     void assign(const Data& other);
     void assign(const void*, size_t);
     void clear();
@@ -40,11 +46,18 @@ public:
     std::uint64_t read(Stream& in, size_t size);
     void compress(const std::string& compression);
     void decompress(const std::string& compression, size_t uncompressed_size);
+
+    // Chunked variants, see detail/ChunkedCompression.h. A chunk_size of 0 disables chunking.
+    void compress(const std::string& compression, size_t chunk_size, size_t threads, bool checksum = true);
+    void decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t threads);
     std::string checksum(const std::string& algorithm = "") const;
 
 private:
+    void unmap();
+
     eckit::Buffer buffer_;
     size_t size_{0};
+    std::shared_ptr<const void> mapping_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
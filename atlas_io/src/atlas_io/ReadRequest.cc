@@ -33,6 +33,7 @@ static std::string stream_path(Stream stream) {
 ReadRequest::ReadRequest(const std::string& URI, atlas::io::Decoder* decoder):
     uri_(URI), decoder_(decoder), item_(new RecordItem()) {
     do_checksum_ = defaults::checksum_read();
+    do_mmap_     = defaults::read_mmap();
     ATLAS_IO_ASSERT(uri_.size());
 }
 
@@ -57,6 +58,7 @@ ReadRequest::ReadRequest(ReadRequest&& other):
     decoder_(std::move(other.decoder_)),
     item_(std::move(other.item_)),
     do_checksum_{other.do_checksum_},
+    do_mmap_{other.do_mmap_},
     finished_{other.finished_} {
     other.do_checksum_ = true;
     other.finished_    = true;
@@ -80,7 +82,9 @@ void ReadRequest::read() {
             RecordItemReader{stream_, offset_, key_}.read(*item_);
         }
         else {
-            RecordItemReader(uri_).read(*item_);
+            RecordItemReader reader(uri_);
+            reader.mmap(do_mmap_);
+            reader.read(*item_);
         }
     }
 }
@@ -91,6 +95,10 @@ void ReadRequest::checksum(bool b) {
     do_checksum_ = b;
 }
 
+void ReadRequest::mmap(bool b) {
+    do_mmap_ = b;
+}
+
 void ReadRequest::checksum() {
     if (not do_checksum_) {
         return;
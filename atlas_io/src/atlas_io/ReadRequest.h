@@ -50,6 +50,10 @@ public:
 
     void checksum(bool);
 
+    void mmap(bool);
+
+    bool finished() const { return finished_; }
+
 private:
     ReadRequest(const std::string& URI, Decoder* decoder);
     ReadRequest(Stream, size_t offset, const std::string& key, Decoder*);
@@ -64,6 +68,7 @@ private:
     std::unique_ptr<Decoder> decoder_;
     std::unique_ptr<RecordItem> item_;
     bool do_checksum_{true};
+    bool do_mmap_{false};
     bool finished_{false};
 };
 
@@ -280,6 +280,8 @@ void ParsedRecord::parse() {
         item.data.section(item.getInt("data.section", 0));
         item.data.endian(head.endian());
         item.data.compression(item.getString("data.compression.type", "none"));
+        item.data.chunk_size(item.has("data.compression.chunk_size") ? item.getUnsigned("data.compression.chunk_size")
+                                                                      : 0);
         if (item.data.section()) {
             auto& data_section = data_sections.at(size_t(item.data.section() - 1));
             item.data.checksum(data_section.checksum);
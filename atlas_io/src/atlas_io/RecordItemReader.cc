@@ -16,6 +16,9 @@
 #include "atlas_io/Session.h"
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Assert.h"
+#include "atlas_io/detail/ChunkedCompression.h"
+#include "atlas_io/detail/Defaults.h"
+#include "atlas_io/detail/MemoryMap.h"
 #include "atlas_io/detail/ParsedRecord.h"
 #include "atlas_io/detail/RecordSections.h"
 
@@ -79,6 +82,88 @@ static Data read_data(const Record& record, int data_section_index, Stream in) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+static Data map_data(const Record& record, int data_section_index, const std::string& path) {
+    ATLAS_IO_TRACE("map_data(data_section=" + std::to_string(data_section_index) + ")");
+
+    const auto& parsed       = static_cast<const ParsedRecord&>(record);
+    const auto& data_section = parsed.data_sections.at(size_t(data_section_index) - 1);
+
+    auto mapping = map_file(path, data_section.offset, data_section.length);
+    if (not mapping) {
+        return atlas::io::Data();
+    }
+
+    auto data_size = size_t(data_section.length) - sizeof(RecordDataSection::Begin) - sizeof(RecordDataSection::End);
+
+    const char* section    = static_cast<const char*>(mapping.get());
+    const auto* data_begin = reinterpret_cast<const RecordDataSection::Begin*>(section);
+    const auto* data_end =
+        reinterpret_cast<const RecordDataSection::End*>(section + sizeof(RecordDataSection::Begin) + data_size);
+    if (not data_begin->valid() || not data_end->valid()) {
+        throw InvalidRecord("Data section is not valid");
+    }
+    return atlas::io::Data(std::shared_ptr<const void>(mapping, section + sizeof(RecordDataSection::Begin)), data_size);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+static Data read_data_range(const Record& record, const DataInfo& info, Stream in, size_t offset, size_t length) {
+    ATLAS_IO_TRACE("read_data_range(data_section=" + std::to_string(info.section()) + ")");
+    if (offset + length > info.size()) {
+        throw Exception("Requested range [" + std::to_string(offset) + "," + std::to_string(offset + length) +
+                        ") exceeds data size " + std::to_string(info.size()));
+    }
+    if (info.section() == 0 || length == 0) {
+        return atlas::io::Data();
+    }
+
+    const auto& parsed       = static_cast<const ParsedRecord&>(record);
+    const auto& data_section = parsed.data_sections.at(size_t(info.section()) - 1);
+    const size_t data_offset = data_section.offset + sizeof(RecordDataSection::Begin);
+
+    atlas::io::Data data;
+    if (not info.compressed()) {
+        in.seek(data_offset + offset);
+        if (data.read(in, length) != length) {
+            throw InvalidRecord("Data section is not valid");
+        }
+        return data;
+    }
+
+    if (info.chunk_size() == 0) {
+        // Not chunked: the complete data section needs to be decompressed
+        auto all = read_data(record, info.section(), in);
+        all.decompress(info.compression(), info.size());
+        data.assign(static_cast<const char*>(all.data()) + offset, length);
+        return data;
+    }
+
+    const size_t data_size =
+        size_t(data_section.length) - sizeof(RecordDataSection::Begin) - sizeof(RecordDataSection::End);
+    in.seek(data_offset);
+    auto index = read_chunk_index(in, data_size);  // validated to lie within the data section, in increasing order
+    if (index.size() != chunk_count(info.size(), info.chunk_size())) {
+        throw InvalidRecord("Chunk index does not match data size");
+    }
+    const auto& first = index[offset / info.chunk_size()];
+    const auto& last  = index[(offset + length - 1) / info.chunk_size()];
+
+    atlas::io::Data chunks;
+    const size_t chunks_length = last.offset + last.length - first.offset;
+    in.seek(data_offset + chunk_index_size(index.size()) + first.offset);
+    if (chunks.read(in, chunks_length) != chunks_length) {
+        throw InvalidRecord("Data section is not valid");
+    }
+
+    eckit::Buffer uncompressed(length);
+    decompress_chunks(info.compression(), info.chunk_size(), info.size(), index, chunks.data(), first.offset,
+                      chunks_length, offset, length, uncompressed.data(), size_t(defaults::compression_threads()),
+                      defaults::checksum_read());
+    return atlas::io::Data(std::move(uncompressed), length);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 static eckit::PathName make_absolute_path(const std::string& reference_path, RecordItem::URI& uri) {
     eckit::PathName absolute_path = uri.path;
     if (reference_path.size() && uri.path[0] != '/' && uri.path[0] != '~') {
@@ -213,17 +298,56 @@ void RecordItemReader::read(io::Metadata& metadata, io::Data& data) {
 
     if (metadata.link()) {
         Metadata linked;
-        RecordItemReader{absolute_path.dirName(), metadata.link()}.read(linked, data);
+        RecordItemReader linked_reader{absolute_path.dirName(), metadata.link()};
+        linked_reader.mmap(mmap_);
+        linked_reader.read(linked, data);
         metadata.link(std::move(linked));
     }
     else {
         if (metadata.data.section()) {
-            data = atlas::io::read_data(record_, metadata.data.section(), InputFileStream(absolute_path));
+            if (mmap_ && not metadata.data.compressed() && metadata.data.endian() == Endian::native) {
+                data = map_data(record_, metadata.data.section(), absolute_path);
+            }
+            if (not data.mapped()) {
+                data = atlas::io::read_data(record_, metadata.data.section(), InputFileStream(absolute_path));
+            }
         }
     }
 };
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordItemReader::read(io::Metadata& metadata, io::Data& data, size_t offset, size_t length) {
+    ATLAS_IO_TRACE("RecordItemReader::read(" + uri_.path + ":" + uri_.key + ", range)");
+
+    metadata = record_.metadata(uri_.key);
+
+    if (metadata.link()) {
+        if (in_) {
+            throw atlas::io::Exception("Cannot follow links in records that are not file based");
+        }
+        auto absolute_path = make_absolute_path(ref_, uri_);
+        Metadata linked;
+        RecordItemReader{absolute_path.dirName(), metadata.link()}.read(linked, data, offset, length);
+        metadata.link(std::move(linked));
+        return;
+    }
+
+    if (in_) {
+        data = read_data_range(record_, metadata.data, in_, offset, length);
+    }
+    else {
+        data = read_data_range(record_, metadata.data, InputFileStream(make_absolute_path(ref_, uri_)), offset, length);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void RecordItemReader::mmap(bool b) {
+    mmap_ = b;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace io
 }  // namespace atlas
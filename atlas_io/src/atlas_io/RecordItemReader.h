@@ -35,6 +35,14 @@ public:
 
     void read(Metadata&, Data&);
 
+    /// Read only the uncompressed bytes [offset, offset+length) of the item data into Data.
+    /// Only the required part of the data section is read, and for chunked compression (see RecordWriter::chunk_size)
+    /// only the overlapping chunks are decompressed. The Metadata describes the complete item.
+    void read(Metadata&, Data&, size_t offset, size_t length);
+
+    /// Memory-map uncompressed data of native endianness instead of copying it into a buffer (file-based only)
+    void mmap(bool);
+
 private:
     RecordItemReader(const std::string& ref, const std::string& uri);
 
@@ -43,6 +51,8 @@ private:
 
     std::string ref_{};  // directory to which relative URI's are evaluated
     RecordItem::URI uri_;
+
+    bool mmap_{false};
 };
 
 //---------------------------------------------------------------------------------------------------------------------
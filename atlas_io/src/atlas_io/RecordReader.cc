@@ -10,21 +10,136 @@
 
 #include "RecordReader.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "atlas_io/Metadata.h"
 #include "atlas_io/RecordItemReader.h"
+#include "atlas_io/Trace.h"
+#include "atlas_io/detail/Defaults.h"
 
 namespace atlas {
 namespace io {
 
+namespace {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Pool of worker threads completing ReadRequests (checksum, decompress, decode) that have been read by the
+/// calling thread. At most `depth` requests are queued or in progress, which bounds the memory held by items
+/// that were read ahead. Trace hooks are disabled on worker threads.
+class DecodePipeline {
+public:
+    DecodePipeline(size_t threads, size_t depth): depth_{std::max(depth, threads)} {
+        workers_.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ~DecodePipeline() { join(); }
+
+    /// Queue a request that has been read, blocking while the pipeline is full.
+    /// Returns false when a previous request failed, in which case nothing is queued.
+    bool push(ReadRequest& request) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_.wait(lock, [this] { return pending_ < depth_ || error_; });
+        if (error_) {
+            return false;
+        }
+        queue_.push_back(&request);
+        ++pending_;
+        work_.notify_one();
+        return true;
+    }
+
+    /// Complete all queued requests and rethrow the first exception raised by a worker
+    void wait() {
+        join();
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    void join() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        work_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    void work() {
+        TraceHookRegistry::enable_thread(false);
+        while (true) {
+            ReadRequest* request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_.wait(lock, [this] { return done_ || not queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                request = queue_.front();
+                queue_.pop_front();
+                if (error_) {
+                    --pending_;
+                    space_.notify_all();
+                    continue;
+                }
+            }
+            std::exception_ptr error;
+            try {
+                request->wait();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (error && not error_) {
+                    error_ = error;
+                }
+                --pending_;
+            }
+            space_.notify_all();
+        }
+    }
+
+    size_t depth_;
+    size_t pending_{0};
+    bool done_{false};
+    std::exception_ptr error_;
+    std::deque<ReadRequest*> queue_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_;
+    std::condition_variable space_;
+};
+
+}  // namespace
+
 //---------------------------------------------------------------------------------------------------------------------
 
 RecordReader::RecordReader(const Record::URI& ref): RecordReader(ref.path, ref.offset) {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
-RecordReader::RecordReader(const std::string& path, uint64_t offset): session_{}, path_{path}, offset_{offset} {}
+RecordReader::RecordReader(const std::string& path, uint64_t offset):
+    session_{}, path_{path}, offset_{offset}, threads_{defaults::read_threads()} {}
 
-RecordReader::RecordReader(Stream stream, uint64_t offset): session_{}, stream_{stream}, path_{}, offset_{offset} {}
+RecordReader::RecordReader(Stream stream, uint64_t offset):
+    session_{}, stream_{stream}, path_{}, offset_{offset}, threads_{defaults::read_threads()} {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -54,11 +169,32 @@ void RecordReader::wait(const std::string& key) {
 //---------------------------------------------------------------------------------------------------------------------
 
 void RecordReader::wait() {
-    // This can be optimized perhaps to overlap IO with decoding in multithreaded environment
+    std::vector<ReadRequest*> pending;
     for (auto& pair : requests_) {
-        auto& request = pair.second;
-        request.wait();
+        if (not pair.second.finished()) {
+            pending.emplace_back(&pair.second);
+        }
+    }
+
+    size_t threads = std::min<size_t>(std::max(threads_, 1), pending.size());
+    if (threads <= 1) {
+        for (auto* request : pending) {
+            request->wait();
+        }
+        return;
     }
+
+    // Reading remains on the calling thread, which keeps access to the Session and to a shared Stream serial,
+    // while worker threads verify, decompress and decode the items that were already read.
+    ATLAS_IO_TRACE("RecordReader::wait(threads=" + std::to_string(threads) + ")");
+    DecodePipeline pipeline(threads, 2 * threads);
+    for (auto* request : pending) {
+        request->read();
+        if (not pipeline.push(*request)) {
+            break;
+        }
+    }
+    pipeline.wait();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -79,6 +215,14 @@ void RecordReader::checksum(bool b) {
     do_checksum_ = b;
 }
 
+void RecordReader::mmap(bool b) {
+    do_mmap_ = b;
+}
+
+void RecordReader::threads(int n) {
+    threads_ = n;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace io
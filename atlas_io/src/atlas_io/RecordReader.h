@@ -45,6 +45,9 @@ public:
         if (do_checksum_ >= 0) {
             requests_.at(key).checksum(do_checksum_);
         }
+        if (do_mmap_ >= 0) {
+            requests_.at(key).mmap(do_mmap_);
+        }
         return requests_.at(key);
     }
 
@@ -58,6 +61,14 @@ public:
 
     void checksum(bool);
 
+    /// Memory-map uncompressed items of file-based records instead of copying them into intermediate buffers.
+    /// Decoding then copies straight from the page cache, or views the mapping directly (see MappedArray).
+    void mmap(bool);
+
+    /// Number of worker threads used by wait() to verify, decompress and decode items while the calling
+    /// thread reads ahead. A value of 1 (default, or $ATLAS_IO_READ_THREADS) processes requests one at a time.
+    void threads(int);
+
 private:
     Record::URI uri() const;
 
@@ -76,6 +87,10 @@ private:
     std::uint64_t offset_;
 
     int do_checksum_{-1};
+
+    int do_mmap_{-1};
+
+    int threads_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
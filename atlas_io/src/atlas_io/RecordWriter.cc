@@ -15,6 +15,7 @@
 #include "atlas_io/RecordWriter.h"
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Checksum.h"
+#include "atlas_io/detail/ChunkedCompression.h"
 #include "atlas_io/detail/Defaults.h"
 #include "atlas_io/detail/Encoder.h"
 #include "atlas_io/detail/RecordSections.h"
@@ -94,7 +95,7 @@ size_t RecordWriter::write(Stream out) const {
             }
             atlas::io::Data data;
             encode_data(encoder, data);
-            data.compress(info.compression());
+            data.compress(info.compression(), info.chunk_size(), size_t(threads_), do_checksum_);
             auto& data_section  = index[i];
             data_section.offset = position();
             atlas::io::write_struct(out, RecordDataSection::Begin());
@@ -157,6 +158,18 @@ void RecordWriter::checksum(bool on) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordWriter::chunk_size(size_t bytes) {
+    chunk_size_ = bytes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void RecordWriter::threads(int n) {
+    threads_ = n;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordWriter::set(const RecordWriter::Key& key, Link&& link, const eckit::Configuration&) {
     keys_.emplace_back(key);
     encoders_[key] = std::move(Encoder{link});
@@ -170,6 +183,9 @@ void RecordWriter::set(const RecordWriter::Key& key, Encoder&& encoder, const ec
     if (encoder.encodes_data()) {
         ++nb_data_sections_;
         info.compression(config.getString("compression", compression_));
+        if (info.compression() != "none") {
+            info.chunk_size(size_t(config.getLong("chunk_size", long(chunk_size_))));
+        }
         info.section(nb_data_sections_);
     }
     keys_.emplace_back(key);
@@ -215,6 +231,9 @@ size_t RecordWriter::estimateMaximumSize() const {
             atlas::io::Metadata m;
             size_t max_data_size = encode_metadata(encoder, m);
             if (info.compression() != "none") {
+                if (info.chunk_size()) {
+                    max_data_size += chunk_index_size(chunk_count(max_data_size, info.chunk_size()));
+                }
                 max_data_size = size_t(1.2 * max_data_size);
                 max_data_size = std::max<size_t>(max_data_size, 10 * 1024);  // minimum 10KB
             }
@@ -241,13 +260,20 @@ std::string RecordWriter::metadata() const {
             m.set("data.section", info.section());
             if (info.compression() != "none") {
                 m.set("data.compression.type", info.compression());
+                if (info.chunk_size()) {
+                    m.set("data.compression.chunk_size", info.chunk_size());
+                }
             }
         }
         metadata.set(key, m);
     }
     std::stringstream ss;
     atlas::io::write(metadata, ss);
-    return ss.str();
+    std::string str = ss.str();
+    // Pad with whitespace so that all sections before the data keep 8-byte alignment. Uncompressed data then starts
+    // suitably aligned in the file, which allows memory-mapped reads without copying (see MappedArray).
+    str.append((8 - str.size() % 8) % 8, ' ');
+    return str;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -59,6 +59,16 @@ public:
     /// @brief Set checksum off or to default
     void checksum(bool);
 
+    /// @brief Compress items in independent chunks of given uncompressed size in bytes (0: no chunking)
+    ///
+    /// Chunks are compressed concurrently (see threads()), carry their own checksum, and allow readers to
+    /// decompress in parallel or to decompress only a sub-range (RecordItemReader::read(Metadata&,Data&,offset,length)).
+    /// Can be overridden per item with configuration key "chunk_size".
+    void chunk_size(size_t);
+
+    /// @brief Set number of threads used for chunked compression
+    void threads(int);
+
     // -- set( Key, Value ) where Value can be a variety of things
 
     /// @brief Add link to other record item (RecordItem::URI)
@@ -126,6 +136,8 @@ private:
 
     std::string compression_{defaults::compression_algorithm()};
     int do_checksum_{defaults::checksum_write()};
+    size_t chunk_size_{defaults::compression_chunk_size()};
+    int threads_{defaults::compression_threads()};
     int nb_data_sections_{0};
 
     std::string metadata() const;
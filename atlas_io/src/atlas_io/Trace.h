@@ -50,12 +50,19 @@ struct TraceHookRegistry {
     static void enable(size_t id) { instance().enabled_[id] = true; }
     static void disable(size_t id) { instance().enabled_[id] = false; }
     static bool enabled(size_t id) { return instance().enabled_[id]; }
+    // Enable or disable all hooks for the calling thread only, e.g. for worker threads of a parallel read
+    static void enable_thread(bool enable) { thread_enabled_() = enable; }
+    static bool thread_enabled() { return thread_enabled_(); }
     static size_t size() { return instance().hooks.size(); }
     static TraceHookBuilder& hook(size_t id) { return instance().hooks[id]; }
     static size_t invalidId() { return std::numeric_limits<size_t>::max(); }
 
 private:
     TraceHookRegistry() = default;
+    static bool& thread_enabled_() {
+        static thread_local bool enabled{true};
+        return enabled;
+    }
 };
 
 struct Trace {
@@ -10,17 +10,91 @@
 
 #include "Checksum.h"
 
+#include <cstdio>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "eckit/utils/Hash.h"
 #include "eckit/utils/Tokenizer.h"
 
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Defaults.h"
+#include "atlas_io/detail/Parallel.h"
+#include "atlas_io/detail/defines.h"
 
 namespace atlas {
 namespace io {
 
+namespace {
+
+constexpr std::uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotl(std::uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t read64(const unsigned char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if ATLAS_IO_BIG_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+inline std::uint64_t read32(const unsigned char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if ATLAS_IO_BIG_ENDIAN
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+inline std::uint64_t xxh64_round(std::uint64_t acc, std::uint64_t input) {
+    acc += input * prime64_2;
+    acc = rotl(acc, 31);
+    return acc * prime64_1;
+}
+
+inline std::uint64_t xxh64_merge_round(std::uint64_t acc, std::uint64_t val) {
+    acc ^= xxh64_round(0, val);
+    return acc * prime64_1 + prime64_4;
+}
+
+std::string to_hex(std::uint64_t h) {
+    char str[17];
+    std::snprintf(str, sizeof(str), "%016llx", static_cast<unsigned long long>(h));
+    return str;
+}
+
+/// XXH64 of consecutive blocks of checksum_block_size bytes, followed by XXH64 of the little-endian block digests.
+/// A buffer consisting of a single block has the plain XXH64 digest.
+std::string xxh64_blocks(const void* buffer, size_t size, size_t threads) {
+    const auto* data       = static_cast<const unsigned char*>(buffer);
+    const size_t nb_blocks = (size + checksum_block_size - 1) / checksum_block_size;
+    if (nb_blocks <= 1) {
+        return to_hex(xxh64(buffer, size));
+    }
+
+    std::vector<unsigned char> digests(nb_blocks * sizeof(std::uint64_t));
+    parallel_for(nb_blocks, threads, [&](size_t b) {
+        const size_t begin = b * checksum_block_size;
+        std::uint64_t h    = xxh64(data + begin, std::min(checksum_block_size, size - begin));
+        for (size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+            digests[b * sizeof(std::uint64_t) + i] = static_cast<unsigned char>(h >> (8 * i));
+        }
+    });
+    return to_hex(xxh64(digests.data(), digests.size()));
+}
+
+}  // namespace
+
 Checksum::Checksum(const std::string& checksum) {
     std::vector<std::string> tokens;
     eckit::Tokenizer tokenizer(':');
@@ -53,7 +127,58 @@ std::string Checksum::str(size_t size) const {
     return algorithm_ + ":" + checksum_.substr(0, std::min(size, checksum_.size()));
 }
 
-std::string checksum(const void* buffer, size_t size, const std::string& algorithm) {
+std::uint64_t xxh64(const void* buffer, size_t size, std::uint64_t seed) {
+    const auto* p   = static_cast<const unsigned char*>(buffer);
+    const auto* end = p + size;
+
+    std::uint64_t h;
+    if (size >= 32) {
+        const auto* limit = end - 32;
+        std::uint64_t v1  = seed + prime64_1 + prime64_2;
+        std::uint64_t v2  = seed + prime64_2;
+        std::uint64_t v3  = seed;
+        std::uint64_t v4  = seed - prime64_1;
+        do {
+            v1 = xxh64_round(v1, read64(p));
+            v2 = xxh64_round(v2, read64(p + 8));
+            v3 = xxh64_round(v3, read64(p + 16));
+            v4 = xxh64_round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = xxh64_merge_round(h, v1);
+        h = xxh64_merge_round(h, v2);
+        h = xxh64_merge_round(h, v3);
+        h = xxh64_merge_round(h, v4);
+    }
+    else {
+        h = seed + prime64_5;
+    }
+    h += static_cast<std::uint64_t>(size);
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= xxh64_round(0, read64(p));
+        h = rotl(h, 27) * prime64_1 + prime64_4;
+    }
+    if (p + 4 <= end) {
+        h ^= read32(p) * prime64_1;
+        h = rotl(h, 23) * prime64_2 + prime64_3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (*p) * prime64_5;
+        h = rotl(h, 11) * prime64_1;
+    }
+
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string checksum(const void* buffer, size_t size, const std::string& algorithm, size_t threads) {
     auto is_available = [](const std::string& alg) -> bool { return eckit::HashFactory::instance().has(alg); };
 
     auto hash = [&](const std::string& alg) -> std::string {
@@ -64,6 +189,10 @@ std::string checksum(const void* buffer, size_t size, const std::string& algorit
 
     std::string alg = algorithm.empty() ? defaults::checksum_algorithm() : algorithm;
 
+    if (alg == "xxh64-blocks") {
+        ATLAS_IO_TRACE("checksum(" + alg + ")");
+        return alg + ":" + xxh64_blocks(buffer, size, threads ? threads : size_t(defaults::checksum_threads()));
+    }
     if (is_available(alg)) {
         return hash(alg);
     }
@@ -30,7 +30,18 @@ private:
     std::string checksum_;
 };
 
-std::string checksum(const void* buffer, size_t size, const std::string& algorithm = "");
+/// @brief Compute checksum "<algorithm>:<digest>" of buffer
+///
+/// Algorithms are provided by eckit::HashFactory, with the exception of "xxh64-blocks" which is built in:
+/// the buffer is split in blocks of checksum_block_size bytes which are hashed with XXH64 concurrently using up to
+/// `threads` threads, and the block digests are hashed once more. The digest does not depend on the number of threads.
+/// If `threads` is 0, defaults::checksum_threads() is used. Unavailable algorithms fall back to "none".
+std::string checksum(const void* buffer, size_t size, const std::string& algorithm = "", size_t threads = 0);
+
+/// @brief XXH64 hash of buffer, as specified by https://github.com/Cyan4973/xxHash
+std::uint64_t xxh64(const void* buffer, size_t size, std::uint64_t seed = 0);
+
+constexpr size_t checksum_block_size = 1024 * 1024;
 
 
 }  // namespace io
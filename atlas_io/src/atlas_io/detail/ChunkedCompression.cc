@@ -0,0 +1,206 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "ChunkedCompression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "eckit/io/Buffer.h"
+#include "eckit/utils/Compressor.h"
+
+#include "atlas_io/Exceptions.h"
+#include "atlas_io/Stream.h"
+#include "atlas_io/Trace.h"
+#include "atlas_io/detail/Assert.h"
+#include "atlas_io/detail/Checksum.h"
+#include "atlas_io/detail/Parallel.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+size_t chunk_count(size_t size, size_t chunk_size) {
+    return (size + chunk_size - 1) / chunk_size;
+}
+
+size_t chunk_index_size(size_t nb_chunks) {
+    return sizeof(std::uint64_t) + nb_chunks * sizeof(RecordDataIndexSection::Entry);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+size_t compress_chunks(const std::string& compression, size_t chunk_size, const void* in, size_t size,
+                       eckit::Buffer& out, size_t threads, bool checksum) {
+    ATLAS_IO_TRACE("compress_chunks(" + compression + ")");
+    ATLAS_IO_ASSERT(chunk_size > 0);
+
+    const size_t nb_chunks = chunk_count(size, chunk_size);
+    const char* data       = static_cast<const char*>(in);
+
+    ChunkIndex index(nb_chunks);
+    std::vector<eckit::Buffer> compressed(nb_chunks);
+
+    parallel_for(nb_chunks, threads, [&](size_t i) {
+        auto compressor = std::unique_ptr<eckit::Compressor>(eckit::CompressorFactory::instance().build(compression));
+        size_t begin    = i * chunk_size;
+        size_t bytes    = std::min(chunk_size, size - begin);
+
+        eckit::Buffer buffer(size_t(1.2 * bytes) + 64);
+        index[i].length   = compressor->compress(data + begin, bytes, buffer);
+        index[i].checksum =
+            checksum ? atlas::io::checksum(buffer.data(), index[i].length, "", 1) : std::string("none:");
+        compressed[i]     = std::move(buffer);
+    });
+
+    size_t offset = 0;
+    for (auto& entry : index) {
+        entry.offset = offset;
+        offset += entry.length;
+    }
+
+    const size_t header = chunk_index_size(nb_chunks);
+    eckit::Buffer encoded(header + offset);
+    char* p                  = static_cast<char*>(encoded.data());
+    std::uint64_t nb_encoded = nb_chunks;
+    std::memcpy(p, &nb_encoded, sizeof(nb_encoded));
+    std::memcpy(p + sizeof(nb_encoded), index.data(), nb_chunks * sizeof(RecordDataIndexSection::Entry));
+    for (size_t i = 0; i < nb_chunks; ++i) {
+        std::memcpy(p + header + index[i].offset, compressed[i].data(), index[i].length);
+    }
+    out = std::move(encoded);
+    return header + offset;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+// The number of chunks is read from the file: check it against the available bytes before it is used in any size
+// computation or allocation
+void check_chunk_count(std::uint64_t nb_chunks, size_t size) {
+    if (size < sizeof(std::uint64_t) ||
+        nb_chunks > (size - sizeof(std::uint64_t)) / sizeof(RecordDataIndexSection::Entry)) {
+        throw InvalidRecord("Chunk index is not valid: " + std::to_string(nb_chunks) + " chunks do not fit in " +
+                            std::to_string(size) + " bytes");
+    }
+}
+
+}  // namespace
+
+void validate_chunk_index(const ChunkIndex& index, size_t chunks_size) {
+    size_t end = 0;
+    for (size_t i = 0; i < index.size(); ++i) {
+        const auto& entry = index[i];
+        if (entry.offset < end || entry.offset > chunks_size || entry.length > chunks_size - entry.offset) {
+            throw InvalidRecord("Chunk index is not valid: chunk " + std::to_string(i) + " at offset " +
+                                std::to_string(entry.offset) + " with length " + std::to_string(entry.length) +
+                                " is not within " + std::to_string(chunks_size) + " bytes of compressed chunks");
+        }
+        end = entry.offset + entry.length;
+    }
+}
+
+ChunkIndex read_chunk_index(const void* in, size_t size) {
+    const char* p = static_cast<const char*>(in);
+    std::uint64_t nb_chunks;
+    if (size < sizeof(nb_chunks)) {
+        throw InvalidRecord("Chunk index is not valid");
+    }
+    std::memcpy(&nb_chunks, p, sizeof(nb_chunks));
+    check_chunk_count(nb_chunks, size);
+    ChunkIndex index(nb_chunks);
+    std::memcpy(index.data(), p + sizeof(nb_chunks), nb_chunks * sizeof(RecordDataIndexSection::Entry));
+    validate_chunk_index(index, size - chunk_index_size(nb_chunks));
+    return index;
+}
+
+ChunkIndex read_chunk_index(Stream& in, size_t size) {
+    std::uint64_t nb_chunks;
+    if (size < sizeof(nb_chunks) || in.read(&nb_chunks, sizeof(nb_chunks)) != sizeof(nb_chunks)) {
+        throw InvalidRecord("Chunk index is not valid");
+    }
+    check_chunk_count(nb_chunks, size);
+    ChunkIndex index(nb_chunks);
+    const size_t bytes = nb_chunks * sizeof(RecordDataIndexSection::Entry);
+    if (in.read(index.data(), bytes) != bytes) {
+        throw InvalidRecord("Chunk index is not valid");
+    }
+    validate_chunk_index(index, size - chunk_index_size(nb_chunks));
+    return index;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void decompress_chunks(const std::string& compression, size_t chunk_size, size_t uncompressed_size,
+                       const ChunkIndex& index, const void* chunks, size_t chunks_offset, size_t chunks_size,
+                       size_t offset, size_t length, void* out, size_t threads, bool verify) {
+    ATLAS_IO_TRACE("decompress_chunks(" + compression + ")");
+    if (length == 0) {
+        return;
+    }
+    ATLAS_IO_ASSERT(chunk_size > 0);
+    ATLAS_IO_ASSERT(offset + length <= uncompressed_size);
+    if (index.size() != chunk_count(uncompressed_size, chunk_size)) {
+        throw InvalidRecord("Chunk index does not match data size");
+    }
+
+    const size_t first = offset / chunk_size;
+    const size_t last  = (offset + length - 1) / chunk_size;
+    for (size_t i = first; i <= last; ++i) {
+        const auto& entry = index[i];
+        if (entry.offset < chunks_offset || entry.offset - chunks_offset > chunks_size ||
+            entry.length > chunks_size - (entry.offset - chunks_offset)) {
+            throw InvalidRecord("Chunk " + std::to_string(i) + " is not within the compressed data");
+        }
+    }
+
+    parallel_for(last - first + 1, threads, [&](size_t c) {
+        const size_t i     = first + c;
+        const auto& entry  = index[i];
+        const char* in     = static_cast<const char*>(chunks) + (entry.offset - chunks_offset);
+        const size_t begin = i * chunk_size;
+        const size_t bytes = std::min(chunk_size, uncompressed_size - begin);
+
+        if (verify) {
+            Checksum encoded_checksum{std::string(entry.checksum)};
+            if (encoded_checksum.available()) {
+                Checksum computed_checksum{atlas::io::checksum(in, entry.length, encoded_checksum.algorithm(), 1)};
+                if (computed_checksum.available() && computed_checksum.str() != encoded_checksum.str()) {
+                    std::stringstream err;
+                    err << "Mismatch in checksums for chunk " << i << ".\n";
+                    err << "        Encoded:  [" << encoded_checksum.str() << "].\n";
+                    err << "        Computed: [" << computed_checksum.str() << "].";
+                    throw DataCorruption(err.str());
+                }
+            }
+        }
+
+        auto compressor = std::unique_ptr<eckit::Compressor>(eckit::CompressorFactory::instance().build(compression));
+        eckit::Buffer uncompressed(bytes);
+        compressor->uncompress(in, entry.length, uncompressed, bytes);
+
+        // Copy the part of this chunk that overlaps the requested range
+        const size_t copy_begin = std::max(offset, begin);
+        const size_t copy_end   = std::min(offset + length, begin + bytes);
+        std::memcpy(static_cast<char*>(out) + (copy_begin - offset),
+                    static_cast<const char*>(uncompressed.data()) + (copy_begin - begin), copy_end - copy_begin);
+    });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,74 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "atlas_io/detail/RecordSections.h"
+
+namespace eckit {
+class Buffer;
+}
+
+namespace atlas {
+namespace io {
+
+class Stream;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Chunked compression of a data section.
+//
+// The uncompressed data is split into chunks of `chunk_size` bytes (the last one possibly smaller), which are
+// compressed independently. Chunks can therefore be compressed and decompressed concurrently, and a sub-range of the
+// data can be decompressed without touching the other chunks. The encoded data is laid out as
+//
+//     std::uint64_t                            number of chunks N
+//     RecordDataIndexSection::Entry[N]         offset (relative to the first chunk), compressed length, checksum
+//     chunk[0] chunk[1] ... chunk[N-1]         compressed chunks
+
+using ChunkIndex = std::vector<RecordDataIndexSection::Entry>;
+
+/// Number of chunks needed for `size` bytes
+size_t chunk_count(size_t size, size_t chunk_size);
+
+/// Size in bytes of the encoded chunk index preceding the compressed chunks
+size_t chunk_index_size(size_t nb_chunks);
+
+/// Compress `size` bytes from `in` into `out` using up to `threads` threads.
+/// @return size of the encoded data in `out`
+size_t compress_chunks(const std::string& compression, size_t chunk_size, const void* in, size_t size,
+                       eckit::Buffer& out, size_t threads, bool checksum);
+
+/// Check that the chunks of the index are ordered, do not overlap, and lie within `chunks_size` bytes of compressed
+/// chunks. Throws InvalidRecord otherwise.
+void validate_chunk_index(const ChunkIndex& index, size_t chunks_size);
+
+/// Read and validate chunk index from `size` bytes of encoded data in memory
+ChunkIndex read_chunk_index(const void* in, size_t size);
+
+/// Read and validate chunk index from a stream positioned at the beginning of `size` bytes of encoded data
+ChunkIndex read_chunk_index(Stream& in, size_t size);
+
+/// Decompress the uncompressed bytes [offset, offset+length) into `out` using up to `threads` threads.
+/// `chunks` holds `chunks_size` bytes of the compressed chunks overlapping the range, where its first byte is at
+/// chunk offset `chunks_offset`. With `verify`, the checksum of each compressed chunk is verified before it is
+/// decompressed. Throws InvalidRecord when a chunk in the range is not within `chunks`.
+void decompress_chunks(const std::string& compression, size_t chunk_size, size_t uncompressed_size,
+                       const ChunkIndex& index, const void* chunks, size_t chunks_offset, size_t chunks_size,
+                       size_t offset, size_t length, void* out, size_t threads, bool verify);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
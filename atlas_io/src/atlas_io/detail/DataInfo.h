@@ -33,6 +33,8 @@ public:
     size_t size() const { return uncompressed_size_; }
     void compressed_size(size_t s) { compressed_size_ = s; }
     size_t compressed_size() const { return compressed_size_; }
+    void chunk_size(size_t s) { chunk_size_ = s; }
+    size_t chunk_size() const { return chunk_size_; }  ///< Uncompressed bytes per compressed chunk, 0 if not chunked
     void compressed(bool f) {
         if (f == false) {
             compression("none");
@@ -55,6 +57,7 @@ private:
     Endian endian_{Endian::native};
     size_t uncompressed_size_{0};
     size_t compressed_size_{0};
+    size_t chunk_size_{0};
 };
 
 }  // namespace io
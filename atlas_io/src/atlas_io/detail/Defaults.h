@@ -20,10 +20,15 @@ namespace defaults {
 
 [[maybe_unused]] static std::string checksum_algorithm() {
     static std::string checksum =
-        eckit::Resource<std::string>("atlas.io.checksum.algorithm;$ATLAS_IO_CHECKSUM", "xxh64");
+        eckit::Resource<std::string>("atlas.io.checksum.algorithm;$ATLAS_IO_CHECKSUM", "xxh64-blocks");
     return checksum;
 }
 
+[[maybe_unused]] static int checksum_threads() {
+    static int threads = eckit::Resource<int>("atlas.io.checksum.threads;$ATLAS_IO_CHECKSUM_THREADS", 1);
+    return threads;
+}
+
 [[maybe_unused]] static bool checksum_read() {
     static bool checksum = eckit::Resource<bool>("atlas.io.checksum.read;$ATLAS_IO_CHECKSUM_READ", true);
     return checksum;
@@ -39,6 +44,26 @@ namespace defaults {
     return compression;
 }
 
+[[maybe_unused]] static size_t compression_chunk_size() {
+    static size_t chunk_size =
+        size_t(eckit::Resource<long>("atlas.io.compression.chunk_size;$ATLAS_IO_COMPRESSION_CHUNK_SIZE", 0));
+    return chunk_size;
+}
+
+[[maybe_unused]] static int compression_threads() {
+    static int threads = eckit::Resource<int>("atlas.io.compression.threads;$ATLAS_IO_COMPRESSION_THREADS", 1);
+    return threads;
+}
+
+[[maybe_unused]] static bool read_mmap() {
+    static bool mmap = eckit::Resource<bool>("atlas.io.mmap;$ATLAS_IO_MMAP", false);
+    return mmap;
+}
+
+[[maybe_unused]] static int read_threads() {
+    static int threads = eckit::Resource<int>("atlas.io.read.threads;$ATLAS_IO_READ_THREADS", 1);
+    return threads;
+}
 
 }  // namespace defaults
 }  // namespace io
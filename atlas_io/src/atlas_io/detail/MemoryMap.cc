@@ -0,0 +1,69 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "MemoryMap.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "atlas_io/Exceptions.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const void> map_file(const std::string& path, size_t offset, size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    static const size_t page_size = size_t(::sysconf(_SC_PAGESIZE));
+
+    size_t aligned_offset = offset - offset % page_size;
+    size_t length         = size + (offset - aligned_offset);
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // Pages beyond the end of the file cannot be accessed (SIGBUS), so a section that does not fit in the file,
+    // e.g. of a truncated record, is rejected before mapping it
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    const size_t file_size = size_t(st.st_size);
+    if (offset > file_size || size > file_size - offset) {
+        ::close(fd);
+        throw InvalidRecord("Section at offset " + std::to_string(offset) + " with length " + std::to_string(size) +
+                            " exceeds size " + std::to_string(file_size) + " of file " + path);
+    }
+    void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, off_t(aligned_offset));
+    ::close(fd);  // The mapping remains valid after closing the file descriptor
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Start paging in asynchronously, so that decoding overlaps with the remaining I/O
+    ::madvise(addr, length, MADV_WILLNEED);
+
+    std::shared_ptr<const void> mapping(addr, [length](const void* p) { ::munmap(const_cast<void*>(p), length); });
+    return std::shared_ptr<const void>(mapping, static_cast<const char*>(addr) + (offset - aligned_offset));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,32 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Map `size` bytes starting at `offset` of file `path` read-only into memory.
+/// The returned pointer addresses the byte at `offset` and shares ownership of the mapping, which is released when
+/// the last copy goes out of scope. A null pointer is returned when the file cannot be mapped.
+/// Throws InvalidRecord when the requested range extends beyond the end of the file.
+/// The file must not be truncated while it is mapped.
+std::shared_ptr<const void> map_file(const std::string& path, size_t offset, size_t size);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,80 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "atlas_io/Trace.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Call f(i) for all i in [0,n), distributed dynamically over up to `threads` threads.
+/// The calling thread takes part in the work; trace hooks are disabled on the additional threads.
+/// The first exception thrown by f is rethrown once all threads have finished, remaining iterations are skipped.
+template <typename F>
+void parallel_for(size_t n, size_t threads, F&& f) {
+    threads = std::min(threads, n);
+    if (threads <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    auto work = [&]() {
+        for (size_t i = next++; i < n; i = next++) {
+            try {
+                f(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (not error) {
+                    error = std::current_exception();
+                }
+                next = n;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back([&work]() {
+            TraceHookRegistry::enable_thread(false);
+            work();
+        });
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "atlas_io/types/array/ArrayReference.h"
+#include "atlas_io/types/array/MappedArray.h"
 #include "atlas_io/types/array/adaptors/StdArrayAdaptor.h"
 #include "atlas_io/types/array/adaptors/StdVectorAdaptor.h"
 #include "atlas_io/types/array/adaptors/StdVectorOfStdArrayAdaptor.h"
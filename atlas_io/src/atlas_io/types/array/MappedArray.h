@@ -0,0 +1,103 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "atlas_io/Data.h"
+#include "atlas_io/Exceptions.h"
+#include "atlas_io/Metadata.h"
+#include "atlas_io/detail/TypeTraits.h"
+#include "atlas_io/types/array/ArrayMetadata.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Read-only array decoded from a record item.
+///
+/// If the item was memory-mapped (see RecordReader::mmap) and is suitably aligned for T, the array views the mapped
+/// file directly and keeps the mapping alive; no data is copied or loaded up front. Otherwise the data is copied once
+/// into storage owned by the array.
+template <typename T>
+class MappedArray {
+public:
+    MappedArray() = default;
+
+    MappedArray(MappedArray&&)            = default;
+    MappedArray& operator=(MappedArray&&) = default;
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    const ArrayShape& shape() const { return shape_; }
+
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    /// True when the data is a view of a memory-mapped file rather than a copy
+    bool mapped() const { return bool(mapping_); }
+
+    friend void decode(const Metadata& m, const Data& encoded, MappedArray& out) {
+        ArrayMetadata array(m);
+        if (array.datatype().kind() != ArrayMetadata::DataType::kind<T>()) {
+            std::stringstream err;
+            err << "Could not decode " << m.json() << " into MappedArray<" << demangle<T>() << ">. "
+                << "Incompatible datatypes: " << array.datatype().str() << " and " << ArrayMetadata::DataType::str<T>()
+                << ".";
+            throw Exception(err.str(), Here());
+        }
+        if (encoded.size() < array.size() * sizeof(T)) {
+            std::stringstream err;
+            err << "Could not decode " << m.json() << " into MappedArray<" << demangle<T>() << ">: expected "
+                << array.size() * sizeof(T) << " bytes but record item only holds " << encoded.size() << " bytes.";
+            throw InvalidRecord(err.str());
+        }
+        out.shape_ = array.shape();
+        out.size_  = array.size();
+
+        const T* data = static_cast<const T*>(encoded.data());
+        if (encoded.mapped() && reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0) {
+            out.mapping_ = encoded.mapping();
+            out.storage_.clear();
+            out.data_ = data;
+        }
+        else {
+            out.mapping_.reset();
+            // data may not be aligned for T: copy bytes rather than dereferencing it
+            out.storage_.resize(out.size_);
+            if (out.size_) {
+                std::memcpy(out.storage_.data(), encoded.data(), out.size_ * sizeof(T));
+            }
+            out.data_ = out.storage_.data();
+        }
+    }
+
+private:
+    MappedArray(const MappedArray&)            = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    std::shared_ptr<const void> mapping_;
+    std::vector<T> storage_;
+    const T* data_{nullptr};
+    size_t size_{0};
+    ArrayShape shape_;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
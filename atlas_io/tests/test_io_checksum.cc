@@ -0,0 +1,67 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "atlas_io/detail/Checksum.h"
+
+#include "TestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+static std::vector<char> buffer(size_t size) {
+    std::vector<char> v(size);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = char(i * 7 + i / 13);
+    }
+    return v;
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("xxh64 reference values") {
+    std::string s = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(io::xxh64("", 0), 0xef46db3751d8e999ULL);
+    EXPECT_EQ(io::xxh64("abc", 3), 0x44bc2cf5ad770999ULL);
+    EXPECT_EQ(io::xxh64(s.data(), s.size()), 0xfbcea83c8a378bf1ULL);
+}
+
+CASE("xxh64-blocks of a single block equals xxh64") {
+    std::string s = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(io::checksum(s.data(), s.size(), "xxh64-blocks"), std::string("xxh64-blocks:fbcea83c8a378bf1"));
+}
+
+CASE("xxh64-blocks does not depend on number of threads") {
+    auto v = buffer(5 * io::checksum_block_size + 123);
+
+    std::string reference = io::checksum(v.data(), v.size(), "xxh64-blocks", 1);
+    for (size_t threads : {2, 3, 4, 8}) {
+        EXPECT_EQ(io::checksum(v.data(), v.size(), "xxh64-blocks", threads), reference);
+    }
+
+    SECTION("corruption in any block is detected") {
+        v[3 * io::checksum_block_size + 5] ^= 1;
+        EXPECT_NE(io::checksum(v.data(), v.size(), "xxh64-blocks", 4), reference);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
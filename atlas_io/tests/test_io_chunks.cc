@@ -0,0 +1,138 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "eckit/io/Buffer.h"
+
+#include "atlas_io/detail/ChunkedCompression.h"
+
+#include "TestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+static const std::vector<double>& values() {
+    static std::vector<double> v = [] {
+        std::vector<double> v(200000);
+        for (size_t i = 0; i < v.size(); ++i) {
+            v[i] = double(i / 100);
+        }
+        return v;
+    }();
+    return v;
+}
+
+static std::string path() {
+    static std::string suffix = eckit::Resource<std::string>("--suffix", "");
+    return "test_io_chunks.atlas" + suffix;
+}
+
+static constexpr size_t chunk_size = 16384;
+
+//-----------------------------------------------------------------------------
+
+CASE("Write record with chunked compression") {
+    io::RecordWriter record;
+    record.chunk_size(chunk_size);
+    record.threads(4);
+    record.set("v", io::ref(values()));
+    record.write(path());
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Read complete item") {
+    std::vector<double> v;
+    io::RecordReader record(path());
+    record.read("v", v).wait();
+    EXPECT(v == values());
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Read sub-ranges") {
+    io::RecordItemReader reader("file:" + path() + "?key=v");
+    const size_t bytes   = values().size() * sizeof(double);
+    const char* expected = reinterpret_cast<const char*>(values().data());
+
+    auto check = [&](size_t offset, size_t length) {
+        io::Metadata metadata;
+        io::Data data;
+        reader.read(metadata, data, offset, length);
+        EXPECT_EQ(data.size(), length);
+        EXPECT(::memcmp(data.data(), expected + offset, length) == 0);
+    };
+
+    SECTION("first chunk") {
+        check(0, 100);
+    }
+    SECTION("across chunk boundaries") {
+        check(chunk_size - 8, 3 * chunk_size);
+    }
+    SECTION("last chunk") {
+        check(bytes - 24, 24);
+    }
+    SECTION("everything") {
+        check(0, bytes);
+    }
+    SECTION("out of range") {
+        io::Metadata metadata;
+        io::Data data;
+        EXPECT_THROWS_AS(reader.read(metadata, data, bytes - 8, 16), io::Exception);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Corrupt chunk index") {
+    const size_t bytes = 10 * 1024 * sizeof(double);
+    eckit::Buffer encoded;
+    const size_t size = io::compress_chunks("none", 8192, values().data(), bytes, encoded, 1, false);
+    EXPECT_EQ(io::read_chunk_index(encoded.data(), size).size(), io::chunk_count(bytes, 8192));
+
+    const char* data = static_cast<const char*>(encoded.data());
+    std::vector<char> corrupt(data, data + size);
+    auto set_offset = [&](size_t chunk, std::uint64_t offset) {
+        std::memcpy(corrupt.data() + sizeof(std::uint64_t) + chunk * sizeof(io::RecordDataIndexSection::Entry),
+                    &offset, sizeof(offset));
+    };
+
+    SECTION("number of chunks") {
+        const std::uint64_t nb_chunks = std::uint64_t(1) << 62;
+        std::memcpy(corrupt.data(), &nb_chunks, sizeof(nb_chunks));
+        EXPECT_THROWS_AS(io::read_chunk_index(corrupt.data(), corrupt.size()), io::InvalidRecord);
+    }
+    SECTION("offset beyond data") {
+        set_offset(3, size);
+        EXPECT_THROWS_AS(io::read_chunk_index(corrupt.data(), corrupt.size()), io::InvalidRecord);
+    }
+    SECTION("offsets not increasing") {
+        set_offset(3, 0);
+        EXPECT_THROWS_AS(io::read_chunk_index(corrupt.data(), corrupt.size()), io::InvalidRecord);
+    }
+    SECTION("truncated data") {
+        EXPECT_THROWS_AS(io::read_chunk_index(corrupt.data(), corrupt.size() - 100), io::InvalidRecord);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
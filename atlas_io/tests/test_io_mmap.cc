@@ -0,0 +1,152 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "TestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+static const std::vector<double>& v1() {
+    static std::vector<double> v = [] {
+        std::vector<double> v(100000);
+        std::iota(v.begin(), v.end(), 0.5);
+        return v;
+    }();
+    return v;
+}
+
+static const std::vector<int>& v2() {
+    static std::vector<int> v = [] {
+        std::vector<int> v(1001);
+        std::iota(v.begin(), v.end(), -500);
+        return v;
+    }();
+    return v;
+}
+
+static const std::string path = "test_io_mmap.atlas";
+
+//-----------------------------------------------------------------------------
+
+CASE("Write uncompressed record") {
+    io::RecordWriter record;
+    record.compression(false);
+    record.set("v1", io::ref(v1()));
+    record.set("v2", io::ref(v2()));
+    record.write(path);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Read item data with RecordItemReader") {
+    SECTION("mmap") {
+        io::RecordItemReader reader("file:" + path + "?key=v1");
+        reader.mmap(true);
+        io::Metadata metadata;
+        io::Data data;
+        reader.read(metadata, data);
+        EXPECT(data.mapped());
+        EXPECT_EQ(data.size(), v1().size() * sizeof(double));
+        EXPECT(::memcmp(data, v1().data(), data.size()) == 0);
+    }
+    SECTION("no mmap") {
+        io::RecordItemReader reader("file:" + path + "?key=v1");
+        io::Metadata metadata;
+        io::Data data;
+        reader.read(metadata, data);
+        EXPECT(not data.mapped());
+        EXPECT(::memcmp(data, v1().data(), data.size()) == 0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Read with RecordReader::mmap") {
+    std::vector<double> copy;
+    io::MappedArray<int> view;
+    {
+        io::RecordReader reader(path);
+        reader.mmap(true);
+        reader.read("v1", copy);
+        reader.read("v2", view);
+        reader.wait();
+    }
+    // The view remains valid after the reader is gone
+    EXPECT(view.mapped());
+    EXPECT(copy == v1());
+    EXPECT_EQ(view.size(), v2().size());
+    EXPECT_EQ(view.shape()[0], v2().size());
+    EXPECT(std::equal(view.begin(), view.end(), v2().begin()));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Decode MappedArray from unaligned or short data") {
+    io::Metadata metadata;
+    io::Data data;
+    io::RecordItemReader("file:" + path + "?key=v2").read(metadata, data);
+    const size_t bytes = v2().size() * sizeof(int);
+
+    // Place the bytes at an address that is not aligned for int
+    auto buffer = std::make_shared<std::vector<char>>(bytes + 1);
+    std::memcpy(buffer->data() + 1, data.data(), bytes);
+
+    SECTION("unaligned") {
+        io::Data unaligned(std::shared_ptr<const void>(buffer, buffer->data() + 1), bytes);
+        io::MappedArray<int> array;
+        decode(metadata, unaligned, array);
+        EXPECT(not array.mapped());
+        EXPECT_EQ(array.size(), v2().size());
+        EXPECT(std::equal(array.begin(), array.end(), v2().begin()));
+    }
+    SECTION("short") {
+        io::Data short_data(std::shared_ptr<const void>(buffer, buffer->data() + 1), bytes - sizeof(int));
+        io::MappedArray<int> array;
+        EXPECT_THROWS_AS(decode(metadata, short_data, array), io::InvalidRecord);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Mapping a truncated record throws") {
+    const std::string truncated = "test_io_mmap_truncated.atlas";
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // Cut into the data section of "v2", the last item in the record
+        std::ofstream out(truncated, std::ios::binary);
+        out.write(bytes.data(), std::streamsize(bytes.size() - 2000));
+    }
+    io::RecordItemReader reader("file:" + truncated + "?key=v2");
+    reader.mmap(true);
+    io::Metadata metadata;
+    io::Data data;
+    EXPECT_THROWS_AS(reader.read(metadata, data), io::InvalidRecord);
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -11,4 +11,9 @@ if( NOT HAVE_FFTW )
     unset( FFTW_INCLUDES )
 endif()
 
+ecbuild_add_option( FEATURE FFTW_SINGLE
+                    DESCRIPTION "Support for single precision fftw (TransLocal with precision=single)"
+                    CONDITION HAVE_FFTW
+                    REQUIRED_PACKAGES "FFTW COMPONENTS double single QUIET" )
+
 endif()
\ No newline at end of file
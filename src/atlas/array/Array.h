@@ -107,6 +107,16 @@ public:
 
     virtual void insert(idx_t idx1, idx_t size1) = 0;
 
+    /// Allocate storage for at least size0 entries in the first dimension, so that resize() and insert() which only
+    /// change the first dimension do not reallocate until the capacity is exceeded.
+    /// When they do reallocate, the capacity grows geometrically, which amortises repeated growth as std::vector.
+    /// This is a hint: arrays with padding, non-default layout or wrapped external data keep reallocating.
+    /// Views of the array must be recreated after resize() or insert() in any case.
+    virtual void reserve(idx_t size0) = 0;
+
+    /// Number of entries in the first dimension that fit in the allocated storage
+    virtual idx_t capacity() const = 0;
+
     virtual void dump(std::ostream& os) const = 0;
 
     virtual void accMap() const = 0;
@@ -186,6 +196,12 @@ public:
 
     const ArrayDataStore& data_store() const { return *data_store_; }
 
+    /// Owner that the memory of this array is accounted to, or nullptr for wrapped data
+    runtime::trace::MemoryOwner* memoryOwner() const { return data_store_->memoryOwner(); }
+
+    /// Account the memory of this array to another owner
+    void memoryOwner(runtime::trace::MemoryOwner& owner) { data_store_->memoryOwner(owner); }
+
 protected:
     Array(ArraySpec&& spec): spec_(std::move(spec)) {}
     ArraySpec spec_;
@@ -218,6 +234,10 @@ public:
 
     virtual void insert(idx_t idx1, idx_t size1);
 
+    virtual void reserve(idx_t size0);
+
+    virtual idx_t capacity() const;
+
     virtual void resize(const ArrayShape&);
 
     virtual void resize(idx_t size0);
@@ -245,6 +265,7 @@ public:
 private:
     template <typename T>
     friend class ArrayT_impl;
+    idx_t capacity_{0};  // allocated entries in first dimension, when larger than shape(0)
 };
 
 extern template class ArrayT<float>;
@@ -20,6 +20,14 @@
 
 //------------------------------------------------------------------------------------------------------
 
+namespace atlas {
+namespace runtime {
+namespace trace {
+class MemoryOwner;
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
+
 namespace atlas {
 namespace array {
 
@@ -65,6 +73,12 @@ public:
     virtual void accMap() const                     = 0;
     virtual void accUnmap() const                   = 0;
     virtual bool accMapped() const                  = 0;
+
+    /// Owner that the allocated memory is accounted to, or nullptr when memory is not owned
+    virtual runtime::trace::MemoryOwner* memoryOwner() const { return nullptr; }
+    /// Account the allocated memory to another owner
+    virtual void memoryOwner(runtime::trace::MemoryOwner&) {}
+
     template <typename Value>
     Value* hostData() {
         return static_cast<Value*>(voidHostData());
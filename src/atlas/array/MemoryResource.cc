@@ -0,0 +1,336 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/array/MemoryResource.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace array {
+
+//------------------------------------------------------------------------------
+
+void MemoryResource::print(std::ostream& out) const {
+    out << std::setw(16) << std::left << name() << std::setw(12) << std::left << type() << " allocated "
+        << std::setw(12) << eckit::Bytes(double(memory().bytes())) << " high watermark " << std::setw(12)
+        << eckit::Bytes(double(memory().high())) << " reserved " << eckit::Bytes(double(reserved()));
+}
+
+//------------------------------------------------------------------------------
+
+void* SystemMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, bytes) != 0) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+void SystemMemoryResource::do_deallocate(void* ptr, size_t, size_t) {
+    free(ptr);
+}
+
+//------------------------------------------------------------------------------
+
+PoolMemoryResource::~PoolMemoryResource() {
+    release();
+}
+
+void* PoolMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_lists_.find({bytes, alignment});
+        if (it != free_lists_.end() && not it->second.empty()) {
+            void* ptr = it->second.back();
+            it->second.pop_back();
+            cached_ -= bytes;
+            return ptr;
+        }
+    }
+    return upstream_.allocate(bytes, alignment);
+}
+
+void PoolMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cached_ + bytes <= max_cached_) {
+            free_lists_[{bytes, alignment}].emplace_back(ptr);
+            cached_ += bytes;
+            return;
+        }
+    }
+    upstream_.deallocate(ptr, bytes, alignment);
+}
+
+size_t PoolMemoryResource::reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_;
+}
+
+void PoolMemoryResource::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& free_list : free_lists_) {
+        const size_t bytes     = free_list.first.first;
+        const size_t alignment = free_list.first.second;
+        for (void* ptr : free_list.second) {
+            upstream_.deallocate(ptr, bytes, alignment);
+        }
+    }
+    free_lists_.clear();
+    cached_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+ArenaMemoryResource::~ArenaMemoryResource() {
+    for (auto& block : blocks_) {
+        free(block.data);
+    }
+}
+
+void* ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto aligned = [alignment](size_t offset) { return ((offset + alignment - 1) / alignment) * alignment; };
+    while (block_ < blocks_.size()) {
+        const size_t address = reinterpret_cast<size_t>(blocks_[block_].data);
+        const size_t begin   = aligned(address + offset_) - address;
+        if (begin + bytes <= blocks_[block_].size) {
+            offset_ = begin + bytes;
+            ++live_;
+            used_ += bytes;
+            return blocks_[block_].data + begin;
+        }
+        ++block_;
+        offset_ = 0;
+    }
+    const size_t block_alignment = std::max<size_t>(alignment, 4096);
+    const size_t size            = std::max(block_size_, aligned(bytes));
+    void* data                   = nullptr;
+    if (posix_memalign(&data, block_alignment, size) != 0) {
+        return nullptr;
+    }
+    blocks_.push_back(Block{static_cast<char*>(data), size});
+    block_  = blocks_.size() - 1;
+    offset_ = bytes;
+    ++live_;
+    used_ += bytes;
+    return data;
+}
+
+void ArenaMemoryResource::do_deallocate(void*, size_t, size_t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ATLAS_ASSERT(live_ > 0);
+    if (--live_ == 0) {
+        block_  = 0;
+        offset_ = 0;
+        used_   = 0;
+    }
+}
+
+size_t ArenaMemoryResource::reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t size = 0;
+    for (auto& block : blocks_) {
+        size += block.size;
+    }
+    return size - used_;
+}
+
+void ArenaMemoryResource::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (live_ == 0) {
+        for (auto& block : blocks_) {
+            free(block.data);
+        }
+        blocks_.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void* HugePageMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes < huge_page_size()) {
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, alignment, bytes) == 0 ? ptr : nullptr;
+    }
+    const size_t size = ((bytes + huge_page_size() - 1) / huge_page_size()) * huge_page_size();
+    void* ptr         = nullptr;
+    if (posix_memalign(&ptr, std::max(alignment, huge_page_size()), size) != 0) {
+        return nullptr;
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Only a hint: without transparent huge page support the memory is backed by regular pages
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void HugePageMemoryResource::do_deallocate(void* ptr, size_t, size_t) {
+    free(ptr);
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+struct MemoryResources {
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<MemoryResource>> registered_;
+    std::vector<std::weak_ptr<MemoryResource>> arenas_;
+    std::shared_ptr<MemoryResource> default_;
+    size_t nb_arenas_{0};
+
+    static MemoryResources& instance() {
+        static MemoryResources x;
+        return x;
+    }
+
+    std::shared_ptr<MemoryResource> create_arena() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto arena = std::make_shared<ArenaMemoryResource>("arena-" + std::to_string(++nb_arenas_));
+        arenas_.erase(std::remove_if(arenas_.begin(), arenas_.end(), [](auto& a) { return a.expired(); }),
+                      arenas_.end());
+        arenas_.emplace_back(arena);
+        return arena;
+    }
+
+    std::shared_ptr<MemoryResource> get(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = registered_.find(name);
+        if (it == registered_.end()) {
+            throw_Exception("MemoryResource '" + name + "' is not registered", Here());
+        }
+        return it->second;
+    }
+
+    void add(std::shared_ptr<MemoryResource> resource) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        registered_[resource->name()] = resource;
+    }
+
+    std::shared_ptr<MemoryResource> current() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return default_;
+    }
+
+    void current(std::shared_ptr<MemoryResource> resource) {
+        ATLAS_ASSERT(resource);
+        ATLAS_ASSERT(resource->type() != ArenaMemoryResource::static_type(),
+                     "An arena can only be used within a ScopedMemoryResource, not as default resource");
+        std::lock_guard<std::mutex> lock(mutex_);
+        default_ = resource;
+    }
+
+    void print(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& resource : registered_) {
+            resource.second->print(out);
+            out << '\n';
+        }
+        for (auto& arena : arenas_) {
+            if (auto resource = arena.lock()) {
+                resource->print(out);
+                out << '\n';
+            }
+        }
+        out << "total            allocated " << MemoryHighWatermark::instance() << " high watermark "
+            << eckit::Bytes(double(MemoryHighWatermark::instance().high())) << std::endl;
+    }
+
+private:
+    MemoryResources() {
+        for (std::shared_ptr<MemoryResource> resource :
+             {std::shared_ptr<MemoryResource>(std::make_shared<SystemMemoryResource>()),
+              std::shared_ptr<MemoryResource>(std::make_shared<PoolMemoryResource>()),
+              std::shared_ptr<MemoryResource>(std::make_shared<HugePageMemoryResource>())}) {
+            registered_[resource->name()] = resource;
+        }
+        std::string configured = Library::instance().memoryResource();
+        if (configured == ArenaMemoryResource::static_type()) {
+            // An arena only rewinds once all of its allocations are freed, which long-lived arrays prevent
+            throw_Exception("ATLAS_MEMORY_RESOURCE='arena' is not supported: an arena can only be used within a "
+                            "ScopedMemoryResource(\"arena\")",
+                            Here());
+        }
+        if (registered_.find(configured) == registered_.end()) {
+            throw_Exception("ATLAS_MEMORY_RESOURCE='" + configured + "' is not one of system, pool, huge_pages",
+                            Here());
+        }
+        default_ = registered_[configured];
+    }
+};
+
+thread_local std::vector<std::shared_ptr<MemoryResource>> scoped_memory_resources;
+
+}  // namespace
+
+std::shared_ptr<MemoryResource> memory_resource(const std::string& name) {
+    if (name == ArenaMemoryResource::static_type()) {
+        for (auto it = scoped_memory_resources.rbegin(); it != scoped_memory_resources.rend(); ++it) {
+            if ((*it)->type() == ArenaMemoryResource::static_type()) {
+                return *it;
+            }
+        }
+        throw_Exception("MemoryResource 'arena' can only be selected within a ScopedMemoryResource(\"arena\")",
+                        Here());
+    }
+    return MemoryResources::instance().get(name);
+}
+
+void register_memory_resource(std::shared_ptr<MemoryResource> resource) {
+    ATLAS_ASSERT(resource);
+    MemoryResources::instance().add(resource);
+}
+
+std::shared_ptr<MemoryResource> current_memory_resource() {
+    if (not scoped_memory_resources.empty()) {
+        return scoped_memory_resources.back();
+    }
+    return MemoryResources::instance().current();
+}
+
+void current_memory_resource(const std::string& name) {
+    current_memory_resource(memory_resource(name));
+}
+
+void current_memory_resource(std::shared_ptr<MemoryResource> resource) {
+    MemoryResources::instance().current(resource);
+}
+
+void report_memory_resources(std::ostream& out) {
+    MemoryResources::instance().print(out);
+}
+
+ScopedMemoryResource::ScopedMemoryResource(const std::string& name):
+    ScopedMemoryResource(name == ArenaMemoryResource::static_type() ? MemoryResources::instance().create_arena()
+                                                                    : memory_resource(name)) {}
+
+ScopedMemoryResource::ScopedMemoryResource(std::shared_ptr<MemoryResource> resource): resource_(resource) {
+    ATLAS_ASSERT(resource_);
+    scoped_memory_resources.emplace_back(resource_);
+}
+
+ScopedMemoryResource::~ScopedMemoryResource() {
+    scoped_memory_resources.pop_back();
+}
+
+//------------------------------------------------------------------------------
+
+}  // namespace array
+}  // namespace atlas
@@ -0,0 +1,262 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eckit/log/Bytes.h"
+
+#include "atlas/library/Library.h"
+#include "atlas/runtime/Log.h"
+
+namespace atlas {
+namespace array {
+
+//------------------------------------------------------------------------------
+
+/// Running count of allocated bytes and its high watermark.
+/// The global instance() accounts for all array allocations and logs them when Library::traceMemory() is on;
+/// every MemoryResource keeps its own silent instance.
+struct MemoryHighWatermark {
+    std::atomic<size_t> bytes_{0};
+    std::atomic<size_t> high_{0};
+    void print(std::ostream& out) const { out << eckit::Bytes(double(bytes_)); }
+    friend std::ostream& operator<<(std::ostream& out, const MemoryHighWatermark& v) {
+        v.print(out);
+        return out;
+    }
+    MemoryHighWatermark& operator+=(const size_t& bytes) {
+        bytes_ += bytes;
+        update_maximum();
+        if (trace_ && atlas::Library::instance().traceMemory()) {
+            Log::trace() << "Memory: " << eckit::Bytes(double(bytes_)) << "\t( +" << eckit::Bytes(double(bytes))
+                         << " \t| high watermark " << eckit::Bytes(double(high_)) << "\t)" << std::endl;
+        }
+        return *this;
+    }
+    MemoryHighWatermark& operator-=(const size_t& bytes) {
+        bytes_ -= bytes;
+        if (trace_ && atlas::Library::instance().traceMemory()) {
+            Log::trace() << "Memory: " << eckit::Bytes(double(bytes_)) << "\t( -" << eckit::Bytes(double(bytes))
+                         << " \t| high watermark " << eckit::Bytes(double(high_)) << "\t)" << std::endl;
+        }
+        return *this;
+    }
+
+    size_t bytes() const { return bytes_; }
+    size_t high() const { return high_; }
+
+    MemoryHighWatermark(bool trace = false): trace_(trace) {}
+
+private:
+    void update_maximum() noexcept {
+        size_t prev_value = high_;
+        while (prev_value < bytes_ && !high_.compare_exchange_weak(prev_value, bytes_)) {
+        }
+    }
+    bool trace_;
+
+public:
+    static MemoryHighWatermark& instance() {
+        static MemoryHighWatermark _instance(true);
+        return _instance;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/// Source of host memory for array::DataStore, modelled after std::pmr::memory_resource.
+///
+/// Implementations must be thread-safe, and return nullptr when an allocation fails.
+/// A DataStore keeps a shared pointer to the resource it allocated from, so that a resource lives
+/// until all of its allocations are freed.
+class MemoryResource {
+public:
+    MemoryResource(const std::string& name): name_(name) {}
+    virtual ~MemoryResource() = default;
+
+    void* allocate(size_t bytes, size_t alignment) {
+        void* ptr = do_allocate(bytes, alignment);
+        if (ptr) {
+            memory_ += bytes;
+        }
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) {
+        do_deallocate(ptr, bytes, alignment);
+        memory_ -= bytes;
+    }
+
+    virtual std::string type() const = 0;
+
+    const std::string& name() const { return name_; }
+
+    /// Bytes of live allocations, and their high watermark
+    const MemoryHighWatermark& memory() const { return memory_; }
+
+    /// Bytes held from the system in addition to the live allocations (cached blocks, unused arena space)
+    virtual size_t reserved() const { return 0; }
+
+    /// Return memory that is not in use to the system
+    virtual void release() {}
+
+    void print(std::ostream&) const;
+
+protected:
+    virtual void* do_allocate(size_t bytes, size_t alignment)            = 0;
+    virtual void do_deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+
+private:
+    std::string name_;
+    MemoryHighWatermark memory_;
+};
+
+//------------------------------------------------------------------------------
+
+/// Allocates every request with posix_memalign, and frees it on deallocation
+class SystemMemoryResource : public MemoryResource {
+public:
+    SystemMemoryResource(const std::string& name = static_type()): MemoryResource(name) {}
+    static std::string static_type() { return "system"; }
+    std::string type() const override { return static_type(); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+};
+
+//------------------------------------------------------------------------------
+
+/// Keeps deallocated blocks in free lists per (size,alignment), to hand them out again to the next
+/// allocation of the same size. This avoids allocator churn for temporary fields that are created and
+/// destroyed repeatedly with the same shape. At most max_cached bytes are kept.
+class PoolMemoryResource : public MemoryResource {
+public:
+    PoolMemoryResource(const std::string& name = static_type(), size_t max_cached = size_t(1) << 30):
+        MemoryResource(name), max_cached_(max_cached) {}
+    ~PoolMemoryResource() override;
+    static std::string static_type() { return "pool"; }
+    std::string type() const override { return static_type(); }
+    size_t reserved() const override;
+    void release() override;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::pair<size_t, size_t>, std::vector<void*>> free_lists_;
+    size_t cached_{0};
+    size_t max_cached_;
+    SystemMemoryResource upstream_{"pool-upstream"};
+};
+
+//------------------------------------------------------------------------------
+
+/// Bump allocator that carves allocations out of large blocks. Deallocation only counts; once all
+/// allocations are freed the arena rewinds and reuses its blocks. Blocks are returned to the system when
+/// the arena is destroyed, or on release() when it is empty.
+/// Intended for the many short-lived fields within a scope, see ScopedMemoryResource.
+class ArenaMemoryResource : public MemoryResource {
+public:
+    ArenaMemoryResource(const std::string& name = static_type(), size_t block_size = size_t(64) << 20):
+        MemoryResource(name), block_size_(block_size) {}
+    ~ArenaMemoryResource() override;
+    static std::string static_type() { return "arena"; }
+    std::string type() const override { return static_type(); }
+    size_t reserved() const override;
+    void release() override;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+    mutable std::mutex mutex_;
+    std::vector<Block> blocks_;
+    size_t block_{0};   // block currently allocated from
+    size_t offset_{0};  // offset of first free byte in current block
+    size_t live_{0};    // number of live allocations
+    size_t used_{0};    // bytes handed out since last rewind
+    size_t block_size_;
+};
+
+//------------------------------------------------------------------------------
+
+/// Allocations of at least 2 MiB are aligned to 2 MiB and advised to be backed by transparent huge pages,
+/// reducing TLB misses for large fields. Smaller allocations are served as by SystemMemoryResource.
+class HugePageMemoryResource : public MemoryResource {
+public:
+    HugePageMemoryResource(const std::string& name = static_type()): MemoryResource(name) {}
+    static std::string static_type() { return "huge_pages"; }
+    std::string type() const override { return static_type(); }
+    static constexpr size_t huge_page_size() { return size_t(2) << 20; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+};
+
+//------------------------------------------------------------------------------
+
+/// Resource registered with given name. The resources "system", "pool" and "huge_pages" are predefined and shared.
+/// The name "arena" returns the arena of the innermost ScopedMemoryResource("arena") of the calling thread, and
+/// throws outside of such a scope.
+std::shared_ptr<MemoryResource> memory_resource(const std::string& name);
+
+/// Register a resource under its name, so that it can be selected by name
+void register_memory_resource(std::shared_ptr<MemoryResource>);
+
+/// Resource used for new arrays: the innermost ScopedMemoryResource of the calling thread, or else the
+/// default resource, configured with the environment variable ATLAS_MEMORY_RESOURCE (default "system").
+/// An arena cannot be the default resource.
+std::shared_ptr<MemoryResource> current_memory_resource();
+
+/// Set default resource for all threads, which cannot be an arena
+void current_memory_resource(const std::string& name);
+void current_memory_resource(std::shared_ptr<MemoryResource>);
+
+/// Print usage and high watermark of every resource in use
+void report_memory_resources(std::ostream&);
+
+/// Select the resource for arrays created by the calling thread within the lifetime of this object
+class ScopedMemoryResource {
+public:
+    /// Select resource with given name, see memory_resource(). The name "arena" creates a new arena for this scope.
+    ScopedMemoryResource(const std::string& name);
+    ScopedMemoryResource(std::shared_ptr<MemoryResource>);
+    ~ScopedMemoryResource();
+    ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+    ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+    MemoryResource& resource() const { return *resource_; }
+
+private:
+    std::shared_ptr<MemoryResource> resource_;
+};
+
+//------------------------------------------------------------------------------
+
+}  // namespace array
+}  // namespace atlas
@@ -470,6 +470,18 @@ void ArrayT<Value>::insert(idx_t idx1, idx_t size1) {
 
 //------------------------------------------------------------------------------
 
+template <typename Value>
+void ArrayT<Value>::reserve(idx_t) {
+    // gridtools storage is always allocated to the exact shape
+}
+
+template <typename Value>
+idx_t ArrayT<Value>::capacity() const {
+    return shape(0);
+}
+
+//------------------------------------------------------------------------------
+
 template <typename Value>
 void ArrayT<Value>::resize(idx_t dim0) {
     ArrayT_impl<Value>(*this).resize_variadic(dim0);
@@ -8,6 +8,7 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "atlas/array.h"
@@ -17,6 +18,7 @@
 #include "atlas/array/helpers/ArrayWriter.h"
 #include "atlas/array/native/NativeDataStore.h"
 #include "atlas/runtime/Exception.h"
+#include "atlas/runtime/trace/Memory.h"
 
 using namespace atlas::array::helpers;
 
@@ -112,6 +114,108 @@ Array* Array::create(ArraySpec&& spec) {
 }
 
 
+//------------------------------------------------------------------------------
+
+namespace {
+/// Create array to replace given array, with memory accounted to the same owner
+template <typename Value>
+Array* create_with_same_owner(const Array& array, const ArrayShape& shape) {
+    if (auto* owner = array.memoryOwner()) {
+        runtime::trace::Memory::Scope scope(*owner);
+        return Array::create<Value>(shape);
+    }
+    return Array::create<Value>(shape);
+}
+}  // namespace
+
+template <typename Value>
+class ArrayT_impl {
+public:
+    ArrayT_impl(ArrayT<Value>& array): array_(array) {}
+
+    /// Only an owned, contiguous array with default layout can change its first dimension within its capacity,
+    /// as its entries are then stored back to back
+    bool resizable_in_place(const ArrayShape& shape) const {
+        if (dynamic_cast<native::DataStore<Value>*>(array_.data_store_.get()) == nullptr) {
+            return false;  // wrapped data
+        }
+        if (not array_.contiguous() || not array_.hasDefaultLayout() || shape.size() != array_.shape().size()) {
+            return false;
+        }
+        ArraySpec resized(shape);
+        for (size_t j = 0; j < shape.size(); ++j) {
+            if ((j > 0 && shape[j] != array_.shape(j)) || resized.strides()[j] != array_.stride(j)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Grow capacity by a factor 1.5 at least, so that repeated growth costs amortised O(1) per entry
+    idx_t grown_capacity(idx_t size0) const { return std::max(size0, array_.capacity() + array_.capacity() / 2); }
+
+    /// Move to new storage for capacity entries in the first dimension.
+    /// Entries [0,idx) keep their position, entries from idx onwards are shifted by gap.
+    void reallocate(idx_t capacity, idx_t idx = 0, idx_t gap = 0) {
+        runtime::trace::Memory::Scope owner(*array_.memoryOwner());
+        const size_t stride  = array_.stride(0);
+        const size_t size0   = array_.shape(0);
+        auto data_store      = std::make_unique<native::DataStore<Value>>(size_t(capacity) * stride);
+        const Value* source  = array_.data_store_->template hostData<Value>();
+        Value* destination   = data_store->template hostData<Value>();
+        std::copy(source, source + idx * stride, destination);
+        std::copy(source + idx * stride, source + size0 * stride, destination + (idx + gap) * stride);
+        array_.data_store_ = std::move(data_store);
+        array_.capacity_   = capacity;
+    }
+
+    /// Change the shape within the allocated storage
+    void reshape(const ArrayShape& shape) {
+        array_.capacity_ = array_.capacity();
+        array_.spec_     = ArraySpec(array_.datatype(), shape, array_.spec_.alignment());
+        if (array_.deviceAllocated()) {
+            array_.setDeviceNeedsUpdate(true);
+        }
+    }
+
+    /// Initialise entries [idx,idx+size) of the first dimension as newly allocated storage would be
+    void initialise(idx_t idx, idx_t size) {
+        const size_t stride = array_.stride(0);
+        native::initialise(array_.data_store_->template hostData<Value>() + idx * stride, size * stride);
+    }
+
+    void resize(const ArrayShape& shape) {
+        const idx_t size0 = array_.shape(0);
+        if (shape[0] > array_.capacity()) {
+            reallocate(grown_capacity(shape[0]));
+        }
+        reshape(shape);
+        if (shape[0] > size0) {
+            initialise(size0, shape[0] - size0);
+        }
+    }
+
+    void insert(idx_t idx, idx_t size) {
+        ArrayShape shape = array_.shape();
+        shape[0] += size;
+        if (shape[0] > array_.capacity()) {
+            reallocate(grown_capacity(shape[0]), idx, size);
+        }
+        else {
+            const size_t stride = array_.stride(0);
+            Value* data         = array_.data_store_->template hostData<Value>();
+            std::copy_backward(data + idx * stride, data + array_.shape(0) * stride, data + shape[0] * stride);
+        }
+        reshape(shape);
+        initialise(idx, size);
+    }
+
+private:
+    ArrayT<Value>& array_;
+};
+
+//------------------------------------------------------------------------------
+
 template <typename Value>
 ArrayT<Value>::ArrayT(ArrayDataStore* ds, const ArraySpec& spec) {
     data_store_ = std::unique_ptr<ArrayDataStore>(ds);
@@ -183,12 +287,18 @@ void ArrayT<Value>::resize(const ArrayShape& _shape) {
         throw_Exception(msg.str(), Here());
     }
 
-    Array* resized = Array::create<Value>(_shape);
+    if (ArrayT_impl<Value>(*this).resizable_in_place(_shape)) {
+        ArrayT_impl<Value>(*this).resize(_shape);
+        return;
+    }
+
+    Array* resized = create_with_same_owner<Value>(*this, _shape);
 
     array_initializer::apply(*this,*resized);
     
     replace(*resized);
     delete resized;
+    capacity_ = 0;
 }
 
 
@@ -205,11 +315,30 @@ void ArrayT<Value>::insert(idx_t idx1, idx_t size1) {
     }
     nshape[0] += size1;
 
-    Array* resized = Array::create<Value>(nshape);
+    if (ArrayT_impl<Value>(*this).resizable_in_place(nshape)) {
+        ArrayT_impl<Value>(*this).insert(idx1, size1);
+        return;
+    }
+
+    Array* resized = create_with_same_owner<Value>(*this, nshape);
 
     array_initializer_partitioned<0>::apply(*this, *resized, idx1, size1);
     replace(*resized);
     delete resized;
+    capacity_ = 0;
+}
+
+template <typename Value>
+void ArrayT<Value>::reserve(idx_t size0) {
+    ArrayT_impl<Value> impl(*this);
+    if (size0 > capacity() && impl.resizable_in_place(shape())) {
+        impl.reallocate(size0);
+    }
+}
+
+template <typename Value>
+idx_t ArrayT<Value>::capacity() const {
+    return std::max(capacity_, shape(0));
 }
 
 template <typename Value>
@@ -278,6 +407,7 @@ template <typename Value>
 size_t ArrayT<Value>::footprint() const {
     size_t size = sizeof(*this);
     size += bytes();
+    size += sizeof(Value) * size_t(capacity() - shape(0)) * size_t(stride(0));
     if (not contiguous()) {
         ATLAS_NOTIMPLEMENTED;
     }
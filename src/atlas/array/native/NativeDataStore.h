@@ -11,9 +11,8 @@
 #pragma once
 
 #include <algorithm>  // std::fill
-#include <atomic>
-#include <cstdlib>  // posix_memalign
-#include <limits>   // std::numeric_limits<T>::signaling_NaN
+#include <limits>     // std::numeric_limits<T>::signaling_NaN
+#include <memory>
 #include <sstream>
 
 #if ATLAS_HAVE_CUDA
@@ -21,10 +20,13 @@
 #endif
 
 #include "atlas/array/ArrayDataStore.h"
+#include "atlas/array/MemoryResource.h"
 #include "atlas/library/Library.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/trace/Memory.h"
 #include "eckit/log/Bytes.h"
 
 #if ATLAS_HAVE_ACC
@@ -37,46 +39,7 @@ namespace atlas {
 namespace array {
 namespace native {
 
-struct MemoryHighWatermark {
-    std::atomic<size_t> bytes_{0};
-    std::atomic<size_t> high_{0};
-    void print(std::ostream& out) const { out << eckit::Bytes(double(bytes_)); }
-    friend std::ostream& operator<<(std::ostream& out, const MemoryHighWatermark& v) {
-        v.print(out);
-        return out;
-    }
-    MemoryHighWatermark& operator+=(const size_t& bytes) {
-        bytes_ += bytes;
-        update_maximum();
-        if (atlas::Library::instance().traceMemory()) {
-            Log::trace() << "Memory: " << eckit::Bytes(double(bytes_)) << "\t( +" << eckit::Bytes(double(bytes))
-                         << " \t| high watermark " << eckit::Bytes(double(high_)) << "\t)" << std::endl;
-        }
-        return *this;
-    }
-    MemoryHighWatermark& operator-=(const size_t& bytes) {
-        bytes_ -= bytes;
-        if (atlas::Library::instance().traceMemory()) {
-            Log::trace() << "Memory: " << eckit::Bytes(double(bytes_)) << "\t( -" << eckit::Bytes(double(bytes))
-                         << " \t| high watermark " << eckit::Bytes(double(high_)) << "\t)" << std::endl;
-        }
-        return *this;
-    }
-
-private:
-    MemoryHighWatermark() = default;
-    void update_maximum() noexcept {
-        size_t prev_value = high_;
-        while (prev_value < bytes_ && !high_.compare_exchange_weak(prev_value, bytes_)) {
-        }
-    }
-
-public:
-    static MemoryHighWatermark& instance() {
-        static MemoryHighWatermark _instance;
-        return _instance;
-    }
-};
+using array::MemoryHighWatermark;
 
 template <typename Value>
 static constexpr Value invalid_value() {
@@ -86,20 +49,49 @@ static constexpr Value invalid_value() {
                                                          : std::numeric_limits<Value>::max();
 }
 
+/// Memory pages are placed on the NUMA node of the thread that first writes to them.
+/// With Library::initFirstTouch() new arrays are initialised in parallel with a static schedule, so that
+/// kernels looping over the first dimension with atlas_omp_parallel_for_static access mostly local memory.
+template <typename Value>
+bool first_touch(size_t size) {
+    constexpr size_t page_size = 4096;
+    return Library::instance().initFirstTouch() && atlas_omp_get_max_threads() > 1 &&
+           size * sizeof(Value) >= 4 * page_size * size_t(atlas_omp_get_max_threads());
+}
+
+template <typename Value>
+void initialise_first_touch(Value array[], size_t size, Value value) {
+    atlas_omp_parallel_for_static(size_t i = 0; i < size; ++i) {
+        array[i] = value;
+    }
+}
+
 #if ATLAS_INIT_SNAN
 template <typename Value>
 void initialise(Value array[], size_t size) {
-    std::fill_n(array, size, invalid_value<Value>());
+    if (first_touch<Value>(size)) {
+        initialise_first_touch(array, size, invalid_value<Value>());
+    }
+    else {
+        std::fill_n(array, size, invalid_value<Value>());
+    }
 }
 #else
 template <typename Value>
-void initialise(Value[], size_t) {}
+void initialise(Value array[], size_t size) {
+    if (first_touch<Value>(size)) {
+        initialise_first_touch(array, size, Value());
+    }
+}
 #endif
 
 template <typename Value>
 class DataStore : public ArrayDataStore {
 public:
-    DataStore(size_t size): size_(size) {
+    DataStore(size_t size): DataStore(size, current_memory_resource()) {}
+
+    DataStore(size_t size, std::shared_ptr<MemoryResource> memory_resource):
+        size_(size), memory_resource_(std::move(memory_resource)), memory_owner_(&runtime::trace::Memory::current()) {
         allocateHost();
         initialise(host_data_, size_);
 #if ATLAS_HAVE_CUDA
@@ -232,6 +224,16 @@ public:
 #endif
     }
 
+    runtime::trace::MemoryOwner* memoryOwner() const override { return memory_owner_; }
+
+    void memoryOwner(runtime::trace::MemoryOwner& owner) override {
+        if (host_data_ && &owner != memory_owner_) {
+            owner.allocate(footprint());
+            memory_owner_->deallocate(footprint());
+        }
+        memory_owner_ = &owner;
+    }
+
 
 private:
     [[noreturn]] void throw_AllocationFailed(size_t bytes, const eckit::CodeLocation& loc) {
@@ -240,16 +242,18 @@ private:
         throw_Exception(ss.str(), loc);
     }
 
+    static constexpr size_t alignment() { return 64 * sizeof(Value); }
+
     void alloc_aligned(Value*& ptr, size_t n) {
         if (n > 0) {
-            const size_t alignment = 64 * sizeof(Value);
-            size_t bytes           = sizeof(Value) * n;
+            size_t bytes = sizeof(Value) * n;
             MemoryHighWatermark::instance() += bytes;
 
-            int err = posix_memalign((void**)&ptr, alignment, bytes);
-            if (err) {
+            ptr = static_cast<Value*>(memory_resource_->allocate(bytes, alignment()));
+            if (ptr == nullptr) {
                 throw_AllocationFailed(bytes, Here());
             }
+            memory_owner_->allocate(bytes);
         }
         else {
             ptr = nullptr;
@@ -258,9 +262,10 @@ private:
 
     void free_aligned(Value*& ptr) {
         if (ptr) {
-            free(ptr);
+            memory_resource_->deallocate(ptr, footprint(), alignment());
             ptr = nullptr;
             MemoryHighWatermark::instance() -= footprint();
+            memory_owner_->deallocate(footprint());
         }
     }
 
@@ -275,6 +280,8 @@ private:
     size_t footprint() const { return sizeof(Value) * size_; }
 
     size_t size_;
+    std::shared_ptr<MemoryResource> memory_resource_;
+    runtime::trace::MemoryOwner* memory_owner_;
     Value* host_data_;
     mutable Value* device_data_{nullptr};
 
@@ -11,11 +11,13 @@
 #include "atlas/field/FieldCreatorArraySpec.h"
 
 #include <algorithm>
+#include <memory>
 #include <sstream>
 
 #include "eckit/config/Parametrisation.h"
 
 #include "atlas/array/DataType.h"
+#include "atlas/array/MemoryResource.h"
 #include "atlas/field/detail/FieldImpl.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
@@ -66,6 +68,12 @@ FieldImpl* FieldCreatorArraySpec::createField(const eckit::Parametrisation& para
         Log::trace() << s[i] << (i < s.size() - 1 ? "," : "");
     }
     Log::trace() << "]" << std::endl;
+    std::unique_ptr<array::ScopedMemoryResource> memory_resource;
+    std::string memory_resource_name;
+    if (params.get("memory_resource", memory_resource_name)) {
+        memory_resource = std::make_unique<array::ScopedMemoryResource>(array::memory_resource(memory_resource_name));
+    }
+
     auto field = FieldImpl::create(name, datatype, array::ArraySpec(std::move(s), array::ArrayAlignment(alignment)));
     field->callbackOnDestruction([field]() { Log::trace() << "Destroy field " << field->name() << std::endl; });
     return field;
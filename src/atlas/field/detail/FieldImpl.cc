@@ -18,6 +18,7 @@
 #include "atlas/field/detail/FieldImpl.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/trace/Memory.h"
 
 #if ATLAS_HAVE_FUNCTIONSPACE
 #include "atlas/functionspace/FunctionSpace.h"
@@ -61,6 +62,7 @@ FieldImpl::FieldImpl(const std::string& name, array::DataType datatype, const ar
     :functionspace_(new FunctionSpace())
 #endif
 {
+    runtime::trace::Memory::Scope owner(runtime::trace::Memory::current("Field", name));
     array_ = array::Array::create(datatype, shape);
     array_->attach();
     rename(name);
@@ -73,6 +75,7 @@ FieldImpl::FieldImpl(const std::string& name, array::DataType datatype, array::A
     :functionspace_(new FunctionSpace())
 #endif
 {
+    runtime::trace::Memory::Scope owner(runtime::trace::Memory::current("Field", name));
     array_ = array::Array::create(datatype, std::move(spec));
     array_->attach();
     rename(name);
@@ -149,6 +152,10 @@ std::string vector_to_str(const std::vector<T>& t) {
 
 void FieldImpl::rename(const std::string& name) {
     metadata().set("name", name);
+    auto* owner = array_->memoryOwner();
+    if (owner && owner->type() == "Field" && owner->name() != name) {
+        array_->memoryOwner(runtime::trace::Memory::owner("Field", name));
+    }
     for (FieldObserver* observer : field_observers_) {
         observer->onFieldRename(*this);
     }
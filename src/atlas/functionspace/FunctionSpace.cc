@@ -10,6 +10,7 @@
 
 
 #include "atlas/functionspace/FunctionSpace.h"
+#include "atlas/array/MemoryResource.h"
 #include "atlas/field/Field.h"
 #include "atlas/functionspace/detail/FunctionSpaceImpl.h"
 
@@ -31,6 +32,11 @@ size_t FunctionSpace::footprint() const {
 }
 
 Field FunctionSpace::createField(const eckit::Configuration& config) const {
+    std::string memory_resource;
+    if (config.get("memory_resource", memory_resource)) {
+        array::ScopedMemoryResource scope(array::memory_resource(memory_resource));
+        return get()->createField(config);
+    }
     return get()->createField(config);
 }
 
@@ -39,6 +45,11 @@ Field FunctionSpace::createField(const Field& other) const {
 }
 
 Field FunctionSpace::createField(const Field& other, const eckit::Configuration& config) const {
+    std::string memory_resource;
+    if (config.get("memory_resource", memory_resource)) {
+        array::ScopedMemoryResource scope(array::memory_resource(memory_resource));
+        return get()->createField(other, config);
+    }
     return get()->createField(other, config);
 }
 
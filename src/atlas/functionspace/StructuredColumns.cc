@@ -48,6 +48,10 @@ StructuredColumns::StructuredColumns(const Grid& grid, const grid::Distribution&
     FunctionSpace(new detail::StructuredColumns(grid, distribution, vertical, config)),
     functionspace_(dynamic_cast<const detail::StructuredColumns*>(get())) {}
 
+StructuredColumns::StructuredColumns(const StructuredColumns& other, const eckit::Configuration& config):
+    FunctionSpace(new detail::StructuredColumns(*other.functionspace_, config)),
+    functionspace_(dynamic_cast<const detail::StructuredColumns*>(get())) {}
+
 std::string StructuredColumns::checksum(const FieldSet& fieldset) const {
     return functionspace_->checksum(fieldset);
 }
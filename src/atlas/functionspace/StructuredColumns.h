@@ -33,6 +33,10 @@ public:
     StructuredColumns(const Grid&, const grid::Distribution&, const Vertical&,
                       const eckit::Configuration& = util::NoConfig());
 
+    /// @brief Extend an existing StructuredColumns to the larger halo given in the configuration,
+    /// without recomputing its owned and halo points.
+    StructuredColumns(const StructuredColumns&, const eckit::Configuration&);
+
     static std::string type() { return detail::StructuredColumns::static_type(); }
 
     operator bool() const { return valid(); }
@@ -46,6 +50,8 @@ public:
 
     idx_t halo() const { return functionspace_->halo(); }
 
+    const std::string& ordering() const { return functionspace_->ordering(); }
+
     const Vertical& vertical() const { return functionspace_->vertical(); }
 
     const StructuredGrid& grid() const { return functionspace_->grid(); }
@@ -49,6 +49,28 @@ namespace detail {
 
 namespace {
 
+// Distribution of the grid over the tasks, gathered from the points owned by each task
+grid::Distribution gather_distribution(const StructuredColumns& fs) {
+    ATLAS_TRACE("Gather grid distribution");
+    const auto& comm  = mpi::comm(fs.mpi_comm());
+    auto global_index = array::make_view<gidx_t, 1>(fs.global_index());
+
+    std::vector<gidx_t> owned(fs.sizeOwned());
+    for (idx_t n = 0; n < fs.sizeOwned(); ++n) {
+        owned[n] = global_index(n) - 1;
+    }
+    eckit::mpi::Buffer<gidx_t> recv(comm.size());
+    comm.allGatherv(owned.begin(), owned.end(), recv);
+
+    grid::Distribution::partition_t partition(fs.grid().size());
+    for (idx_t p = 0; p < idx_t(comm.size()); ++p) {
+        for (int k = 0; k < recv.counts[p]; ++k) {
+            partition[recv.buffer[recv.displs[p] + k]] = p;
+        }
+    }
+    return grid::Distribution(comm.size(), std::move(partition));
+}
+
 template <typename T, typename Field>
 array::LocalView<T, 3> make_leveled_view(Field& field) {
     using namespace array;
@@ -504,6 +526,21 @@ StructuredColumns::StructuredColumns(const Grid& grid, const Vertical& vertical,
     setup(distribution, config);
 }
 
+StructuredColumns::StructuredColumns(const StructuredColumns& other, const eckit::Configuration& config):
+    vertical_(other.vertical_),
+    nb_levels_(other.nb_levels_),
+    grid_(new StructuredGrid(*other.grid_)),
+    mpi_comm_(other.mpi_comm_) {
+    ATLAS_TRACE("StructuredColumns constructor");
+    if (other.grid_distribution_) {
+        setup(other.grid_distribution_, config, &other);
+    }
+    else {
+        setup(gather_distribution(other), config, &other);
+    }
+    distribution_ = other.distribution_;
+}
+
 // ----------------------------------------------------------------------------
 
 void StructuredColumns::compute_xy(idx_t i, idx_t j, PointXY& xy) const {
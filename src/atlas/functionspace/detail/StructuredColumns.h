@@ -16,6 +16,7 @@
 #include "atlas/array/DataType.h"
 #include "atlas/field/Field.h"
 #include "atlas/functionspace/detail/FunctionSpaceImpl.h"
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/grid/Vertical.h"
 #include "atlas/library/config.h"
@@ -46,7 +47,6 @@ class StructuredGrid;
 
 namespace atlas {
 namespace grid {
-class Distribution;
 class Partitioner;
 }  // namespace grid
 }  // namespace atlas
@@ -78,6 +78,11 @@ public:
     StructuredColumns(const Grid&, const Vertical&, const grid::Partitioner&,
                       const eckit::Configuration& = util::NoConfig());
 
+    /// @brief Extend an existing StructuredColumns to a larger halo given in the configuration.
+    /// Owned points and existing halo points are not recomputed and keep their index,
+    /// so that fields of the existing StructuredColumns map onto the first points of the extended one.
+    StructuredColumns(const StructuredColumns&, const eckit::Configuration&);
+
     ~StructuredColumns() override;
 
     static std::string static_type() { return "StructuredColumns"; }
@@ -109,6 +114,10 @@ public:
 
     idx_t halo() const { return halo_; }
 
+    /// @brief Ordering of the points: "ij" (row by row), "hilbert" or "morton"
+    /// Owned points are only in the row-major order of the grid (as e.g. required by TransIFS) for "ij".
+    const std::string& ordering() const { return ordering_; }
+
     std::string checksum(const FieldSet&) const;
     std::string checksum(const Field&) const;
 
@@ -209,11 +218,14 @@ private:  // data
     idx_t size_owned_;
     idx_t size_halo_;
     idx_t halo_;
+    std::string ordering_{"ij"};
 
     friend class StructuredColumnsHaloExchangeCache;
     friend class StructuredColumnsGatherScatterCache;
     friend class StructuredColumnsChecksumCache;
     bool periodic_points_{false};
+    bool periodic_x_{false};
+    bool periodic_y_{false};
 
     const StructuredGrid* grid_;
     mutable util::ObjectHandle<parallel::GatherScatter> gather_scatter_;
@@ -321,8 +333,13 @@ private:  // data
     friend struct BlockStructuredColumnsFortranAccess;
     Map2to1 ij2gp_;
 
+    // Distribution used to extend the halo; only set when compact (see setup), as it is kept alive for the
+    // lifetime of the function space
+    grid::Distribution grid_distribution_;
+
     friend class BlockStructuredColumns;
-    void setup(const grid::Distribution& distribution, const eckit::Configuration& config);
+    void setup(const grid::Distribution& distribution, const eckit::Configuration& config,
+               const StructuredColumns* existing = nullptr);
 
     friend class BlockStructuredColumns;
 };
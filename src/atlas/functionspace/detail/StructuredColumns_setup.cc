@@ -10,23 +10,29 @@
 
 #include "atlas/functionspace/StructuredColumns.h"
 
-#include <functional>
+#include <algorithm>
+#include <cstdint>
 #include <iomanip>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "atlas/array/MakeView.h"
 #include "atlas/field/FieldSet.h"
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Partitioner.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionArray.h"
 #include "atlas/library/Library.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/SpaceFillingCurve.h"
 
 namespace atlas {
 namespace functionspace {
@@ -82,20 +88,129 @@ public:
     //const_iterator end() const { return gp_.end(); }
 };
 
+/// Maps indices (i,j) outside of the grid onto a grid point, across the periodic boundary in x,
+/// and across the poles (or the periodic boundary) in y.
+class StructuredIndex {
+public:
+    StructuredIndex(const StructuredGrid& grid, bool periodic_y):
+        grid_(grid),
+        nx_(grid.nx()),
+        ny_(grid.ny()),
+        periodic_y_(periodic_y),
+        north_pole_(grid.y(0) == 90.),
+        south_pole_(grid.y(ny_ - 1) == -90.) {
+        offsets_.resize(ny_);
+        gidx_t offset = 0;
+        for (idx_t j = 0; j < ny_; ++j) {
+            offsets_[j] = offset;
+            offset += nx_[j];
+        }
+    }
+
+    /// Index in [0,n)
+    static idx_t wrap(idx_t i, idx_t n) {
+        const idx_t r = i % n;
+        return r + n * (r < 0);
+    }
+
+    idx_t j(idx_t j) const {
+        if (periodic_y_) {
+            return wrap(j, ny_);
+        }
+        // Reflect across the poles, without repeating a row that lies on a pole
+        while (j < 0 || j >= ny_) {
+            j = (j < 0) ? -j - 1 + north_pole_ : 2 * ny_ - 1 - south_pole_ - j;
+        }
+        return j;
+    }
+
+    /// Grid point (ii,jj) corresponding to (i,j)
+    void ij(idx_t i, idx_t j, idx_t& ii, idx_t& jj) const {
+        jj             = this->j(j);
+        const idx_t nx = nx_[jj];
+        ii             = wrap(i, nx);
+        if (!periodic_y_ && jj != j) {
+            // Across the pole, the point is shifted by 180 degrees
+            ATLAS_ASSERT(nx % 2 == 0);  // assert even number of points
+            ii += nx / 2 - nx * (ii >= nx / 2);
+        }
+    }
+
+    /// Global index (1-based) corresponding to (i,j)
+    gidx_t g(idx_t i, idx_t j) const {
+        idx_t ii, jj;
+        ij(i, j, ii, jj);
+        return offsets_[jj] + ii + 1;
+    }
+
+    gidx_t offset(idx_t j) const { return offsets_[j]; }
+
+    /// x-coordinate of (i,j), for any j
+    double x(idx_t i, idx_t j) const {
+        const idx_t jj = this->j(j);
+        const idx_t nx = nx_[jj];
+        const idx_t ii = wrap(i, nx);
+        const double a = (ii - i) / nx;
+        return grid_.x(ii, jj) - a * grid_.x(nx, jj);
+    }
+
+    /// x-coordinate of (i,jj), with jj in [0,ny)
+    double x_periodic(idx_t i, idx_t jj) const {
+        const idx_t nx = nx_[jj];
+        const idx_t ii = wrap(i, nx);
+        const double a = (ii - i) / nx;
+        return grid_.x(ii, jj) - a * (grid_.x(nx, jj) - grid_.x(0, jj));
+    }
+
+    /// y-coordinate of row j, for any j
+    double y(idx_t j) const {
+        const idx_t jj = this->j(j);
+        if (periodic_y_ || (j >= 0 && j < ny_)) {
+            return grid_.y(jj);
+        }
+        return (j < 0) ? 180. - grid_.y(jj) : -180. - grid_.y(jj);
+    }
+
+private:
+    const StructuredGrid& grid_;
+    const std::vector<idx_t>& nx_;
+    const idx_t ny_;
+    const bool periodic_y_;
+    const idx_t north_pole_;
+    const idx_t south_pole_;
+    std::vector<gidx_t> offsets_;
+};
+
+
 }  // namespace
 
 
-void StructuredColumns::setup(const grid::Distribution& distribution, const eckit::Configuration& config) {
-    config.get("periodic_points", periodic_points_);
+void StructuredColumns::setup(const grid::Distribution& distribution, const eckit::Configuration& config,
+                              const StructuredColumns* existing) {
     if (not(*grid_)) {
         throw_Exception("Grid is not a grid::Structured type", Here());
     }
 
-    bool periodic_x = false, periodic_y = false;
-    config.get("periodic_x", periodic_x);
-    config.get("periodic_y", periodic_y);
+    if (existing) {
+        // Points of the existing function space are reused, so its configuration cannot change
+        periodic_points_ = existing->periodic_points_;
+        periodic_x_      = existing->periodic_x_;
+        periodic_y_      = existing->periodic_y_;
+        ordering_        = existing->ordering_;
+        if (config.has("ordering") && config.getString("ordering") != ordering_) {
+            throw_Exception("StructuredColumns: cannot extend a StructuredColumns with ordering \"" + ordering_ +
+                                "\" using ordering \"" + config.getString("ordering") + "\"",
+                            Here());
+        }
+    }
+    else {
+        config.get("periodic_points", periodic_points_);
+        config.get("periodic_x", periodic_x_);
+        config.get("periodic_y", periodic_y_);
+        config.get("ordering", ordering_);
+    }
 
-    bool regional = (!periodic_x && !periodic_y && !grid_->domain().global());
+    bool regional = (!periodic_x_ && !periodic_y_ && !grid_->domain().global());
 
     const double eps = 1.e-12;
 
@@ -105,6 +220,11 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
 
     distribution_ = distribution.type();
 
+    // Only a compact distribution is kept for extending the halo later. A DistributionArray stores the partition of
+    // every grid point on every task; it is gathered again from the owned points when extending instead.
+    const bool compact = not dynamic_cast<const grid::detail::distribution::DistributionArray*>(distribution.get());
+    grid_distribution_ = compact ? distribution : grid::Distribution();
+
     part_ = mpi::comm(mpi_comm()).rank();
     nb_partitions_ = distribution.nb_partitions();
 
@@ -115,7 +235,14 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
     idx_t owned(0);
 
     ATLAS_TRACE_SCOPE("Compute bounds owned") {
-        if (nb_partitions_ == 1) {
+        if (existing) {
+            j_begin_ = existing->j_begin_;
+            j_end_   = existing->j_end_;
+            i_begin_ = existing->i_begin_;
+            i_end_   = existing->i_end_;
+            owned    = existing->size_owned_;
+        }
+        else if (nb_partitions_ == 1) {
             j_begin_ = 0;
             j_end_   = grid_->ny();
             for (idx_t j = j_begin_; j < j_end_; ++j) {
@@ -221,6 +348,9 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
 
     int halo = config.getInt("halo", 0);
     halo_    = halo;
+    if (existing) {
+        ATLAS_ASSERT(halo >= existing->halo_, "StructuredColumns can only be extended to a larger halo");
+    }
 
     j_begin_halo_ = j_begin_ - halo;
     j_end_halo_   = j_end_ + halo;
@@ -231,68 +361,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
         j_end_halo_   = std::min(j_end_halo_, grid_->ny());
     }
 
-    auto compute_i = [this](idx_t i, idx_t j) -> idx_t {
-        const idx_t nx = grid_->nx(j);
-        while (i >= nx) {
-            i -= nx;
-        }
-        while (i < 0) {
-            i += nx;
-        }
-        return i;
-    };
-
-    auto compute_i_fast = [](idx_t i, const idx_t nx) -> idx_t {
-        while (i >= nx) {
-            i -= nx;
-        }
-        while (i < 0) {
-            i += nx;
-        }
-        return i;
-    };
-
-    std::function<idx_t(idx_t)> compute_j;
-    compute_j = [this, &compute_j, &periodic_y](idx_t j) -> idx_t {
-        if (periodic_y) {
-            const idx_t ny = grid_->ny();
-            while (j < 0) {
-                j += ny;
-            }
-            while (j >= ny) {
-                j -= ny;
-            }
-        }
-        else {
-            if (j < 0) {
-                j = (grid_->y(0) == 90.) ? -j : -j - 1;
-            }
-            else if (j >= grid_->ny()) {
-                idx_t jlast = grid_->ny() - 1;
-                j           = (grid_->y(jlast) == -90.) ? jlast - 1 - (j - grid_->ny()) : jlast - (j - grid_->ny());
-            }
-            if (j < 0 or j >= grid_->ny()) {
-                j = compute_j(j);
-            }
-        }
-        return j;
-    };
-
-    auto compute_x = [this, &compute_i, &compute_j](idx_t i, idx_t j) -> double {
-        const idx_t jj = compute_j(j);
-        const idx_t ii = compute_i(i, jj);  // guaranteed between 0 and nx(jj)
-        const idx_t nx = grid_->nx(jj);
-        const double a = (ii - i) / nx;
-        const double x = grid_->x(ii, jj) - a * grid_->x(nx, jj);
-        return x;
-    };
-
-    auto compute_x_fast = [this, &compute_i_fast](idx_t i, idx_t jj, idx_t nx) -> double {
-        const idx_t ii = compute_i_fast(i, nx);  // guaranteed between 0 and nx(jj)
-        const double a = (ii - i) / nx;
-        const double x = grid_->x(ii, jj) - a * (grid_->x(nx, jj) - grid_->x(0, jj));
-        return x;
-    };
+    const StructuredIndex index(*grid_, periodic_y_);
 
     auto compute_i_less_equal_x = [this, &eps](const double& x, idx_t j) -> idx_t {
         const double dx = grid_->dx(j);
@@ -300,49 +369,23 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
         return i;
     };
 
-    auto compute_y = [this, &compute_j, &periodic_y](idx_t j) -> double {
-        double y;
-        idx_t jj;
-        jj = compute_j(j);
-        if (periodic_y) {
-            y = grid_->y(jj);
-        }
-        else {
-            y = (j < 0) ? 90. + (90. - grid_->y(jj)) : (j >= grid_->ny()) ? -90. + (-90. - grid_->y(jj)) : grid_->y(jj);
-        }
-        return y;
-    };
-
-    std::vector<gidx_t> global_offsets(grid_->ny());
-    idx_t grid_idx = 0;
-    for (idx_t j = 0; j < grid_->ny(); ++j) {
-        global_offsets[j] = grid_idx;
-        grid_idx += grid_->nx(j);
-    }
-
-    auto compute_g = [this, &global_offsets, &compute_i, &compute_j, &periodic_y](idx_t i, idx_t j) -> gidx_t {
+    // Partition of a point outside the grid: points mapping onto an owned point are recognised
+    // without a query to the distribution
+    auto compute_p = [this, &index, &distribution](idx_t i, idx_t j, gidx_t& g) -> int {
         idx_t ii, jj;
-        gidx_t g;
-        jj = compute_j(j);
-        ii = compute_i(i, jj);
-        if (!periodic_y) {
-            if (jj != j) {
-                ATLAS_ASSERT(grid_->nx(jj) % 2 == 0);  // assert even number of points
-                ii = (ii < grid_->nx(jj) / 2)    ? ii + grid_->nx(jj) / 2
-                     : (ii >= grid_->nx(jj) / 2) ? ii - grid_->nx(jj) / 2
-                                                 : ii;
-            }
+        index.ij(i, j, ii, jj);
+        g = index.offset(jj) + ii + 1;
+        if (jj >= j_begin_ && jj < j_end_ && ii >= i_begin_[jj] && ii < i_end_[jj]) {
+            return part_;
         }
-        g = global_offsets[jj] + ii + 1;
-        return g;
-    };
-
-    auto compute_p = [&compute_g, &distribution](idx_t i, idx_t j) -> int {
-        return distribution.partition(compute_g(i, j) - 1);
+        return distribution.partition(g - 1);
     };
 
     GridPointSet gridpoints;
 
+    // Number of points reused from the existing function space
+    const idx_t reused = existing ? existing->size_halo_ : 0;
+
     ATLAS_TRACE_SCOPE("Compute mapping") {
         idx_t imin = std::numeric_limits<idx_t>::max();
         idx_t imax = -std::numeric_limits<idx_t>::max();
@@ -374,8 +417,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
                         jj_max = std::min(jj_max, grid_->ny() - idx_t{1});
                     }
                     for (idx_t jj = jj_min; jj <= jj_max; ++jj) {
-                        idx_t jjj    = compute_j(jj);
-                        idx_t nx_jjj = grid_->nx(jjj);
+                        idx_t jjj    = index.j(jj);
                         idx_t last   = grid_->nx(jjj) - idx_t{1};
                         if (i == grid_->nx(j)) {
                             ++last;
@@ -394,7 +436,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
                         // ii-halo       ii
 
                         // idx_t ii = -halo;
-                        // while ( compute_x_fast( ii, jjj, nx_jjj ) < x - eps ) {
+                        // while ( index.x_periodic( ii, jjj ) < x - eps ) {
                         //     ii++;
                         // }
                         // Question: is following implementation reproducible with above original while loop?
@@ -404,7 +446,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
                         // This while should not have to be there, but is here because of
                         // the MatchingMeshDomainDecomposition algorithm. that may lead to points
                         // left of the point ii.
-                        while (compute_x_fast(ii - 1, jjj, nx_jjj) > x_prev + eps) {
+                        while (index.x_periodic(ii - 1, jjj) > x_prev + eps) {
                             --ii;
                         }
 
@@ -417,7 +459,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
                         // ii-halo            iii       iii+halo
                         //
                         idx_t iii = ii;
-                        while (compute_x_fast(iii + 1, jjj, nx_jjj) < x_next - eps) {
+                        while (index.x_periodic(iii + 1, jjj) < x_next - eps) {
                             ++iii;
                         }
                         iii               = std::min(iii, last);
@@ -451,9 +493,17 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
 
         ATLAS_TRACE_SCOPE("Assemble gridpoints") {
             gridpoints.reserve(owned + extra_halo);
-            gridpoints.resize(owned);
-
-            if (atlas_omp_get_max_threads() == 1) {
+            gridpoints.resize(existing ? reused : owned);
+
+            if (existing) {
+                // Owned and halo points of the existing function space keep their index
+                auto existing_i = array::make_indexview<idx_t, 1>(existing->field_index_i_);
+                auto existing_j = array::make_indexview<idx_t, 1>(existing->field_index_j_);
+                atlas_omp_parallel_for(idx_t r = 0; r < reused; ++r) {
+                    gridpoints.set(existing_i(r), existing_j(r), r);
+                }
+            }
+            else if (atlas_omp_get_max_threads() == 1) {
                 idx_t r = 0;
                 for (idx_t j = j_begin_; j < j_end_; ++j) {
                     for (idx_t i = i_begin_[j]; i < i_end_[j]; ++i, ++r) {
@@ -527,32 +577,102 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
                 }
             }
 
-            ATLAS_ASSERT(gridpoints.size() == owned);
+            ATLAS_ASSERT(gridpoints.size() == (existing ? reused : owned));
 
             gridpoints.resize(owned + extra_halo);
-            idx_t r = owned;
-            for (idx_t j = j_begin_halo_; j < j_begin_; ++j) {
-                for (idx_t i = i_begin_halo_(j); i < i_end_halo_(j); ++i, ++r) {
-                    gridpoints.set(i, j, r);
+            if (existing) {
+                auto in_existing = [existing](idx_t i, idx_t j) {
+                    return j >= existing->j_begin_halo_ && j < existing->j_end_halo_ &&
+                           i >= existing->i_begin_halo_(j) && i < existing->i_end_halo_(j);
+                };
+                idx_t r = reused;
+                for (idx_t j = j_begin_halo_; j < j_end_halo_; ++j) {
+                    for (idx_t i = i_begin_halo_(j); i < i_end_halo_(j); ++i) {
+                        if (not in_existing(i, j)) {
+                            gridpoints.set(i, j, r++);
+                        }
+                    }
                 }
+                ATLAS_ASSERT(r == owned + extra_halo);
             }
-            for (idx_t j = j_begin_; j < j_end_; ++j) {
-                for (idx_t i = i_begin_halo_(j); i < i_begin_[j]; ++i, ++r) {
-                    gridpoints.set(i, j, r);
+            else {
+                idx_t r = owned;
+                for (idx_t j = j_begin_halo_; j < j_begin_; ++j) {
+                    for (idx_t i = i_begin_halo_(j); i < i_end_halo_(j); ++i, ++r) {
+                        gridpoints.set(i, j, r);
+                    }
                 }
-                for (idx_t i = i_end_[j]; i < i_end_halo_(j); ++i, ++r) {
-                    gridpoints.set(i, j, r);
+                for (idx_t j = j_begin_; j < j_end_; ++j) {
+                    for (idx_t i = i_begin_halo_(j); i < i_begin_[j]; ++i, ++r) {
+                        gridpoints.set(i, j, r);
+                    }
+                    for (idx_t i = i_end_[j]; i < i_end_halo_(j); ++i, ++r) {
+                        gridpoints.set(i, j, r);
+                    }
                 }
-            }
-            for (idx_t j = j_end_; j < j_end_halo_; ++j) {
-                for (idx_t i = i_begin_halo_(j); i < i_end_halo_(j); ++i, ++r) {
-                    gridpoints.set(i, j, r);
+                for (idx_t j = j_end_; j < j_end_halo_; ++j) {
+                    for (idx_t i = i_begin_halo_(j); i < i_end_halo_(j); ++i, ++r) {
+                        gridpoints.set(i, j, r);
+                    }
                 }
             }
 
             ATLAS_ASSERT(gridpoints.size() == owned + extra_halo);
         }
 
+        if (ordering_ != "ij") {
+            if (ordering_ != "hilbert" && ordering_ != "morton") {
+                throw_Exception("StructuredColumns: ordering \"" + ordering_ +
+                                    "\" not supported. Valid orderings are \"ij\", \"hilbert\", \"morton\"",
+                                Here());
+            }
+            const bool hilbert = (ordering_ == "hilbert");
+            ATLAS_TRACE_SCOPE("Order along space-filling curve") {
+                // Owned points and halo points are ordered separately, so that owned points remain first.
+                // Only the added halo points are ordered when extending an existing function space.
+                auto reorder = [&](idx_t begin, idx_t end) {
+                    if (end - begin < 2) {
+                        return;
+                    }
+                    idx_t i0 = std::numeric_limits<idx_t>::max();
+                    idx_t j0 = std::numeric_limits<idx_t>::max();
+                    idx_t extent{1};
+                    for (idx_t n = begin; n < end; ++n) {
+                        i0 = std::min(i0, gridpoints[n].i);
+                        j0 = std::min(j0, gridpoints[n].j);
+                    }
+                    for (idx_t n = begin; n < end; ++n) {
+                        extent = std::max(extent, std::max(gridpoints[n].i - i0, gridpoints[n].j - j0) + 1);
+                    }
+                    int order = 1;
+                    while ((idx_t{1} << order) < extent) {
+                        ++order;
+                    }
+                    std::vector<std::pair<uint64_t, idx_t>> keys(end - begin);
+                    atlas_omp_parallel_for(idx_t n = begin; n < end; ++n) {
+                        const uint32_t x = static_cast<uint32_t>(gridpoints[n].i - i0);
+                        const uint32_t y = static_cast<uint32_t>(gridpoints[n].j - j0);
+                        keys[n - begin]  = {hilbert ? util::hilbert_index(x, y, order) : util::morton_index(x, y), n};
+                    }
+                    std::sort(keys.begin(), keys.end());
+                    std::vector<GridPoint> sorted(end - begin);
+                    for (idx_t k = 0; k < end - begin; ++k) {
+                        sorted[k] = gridpoints[keys[k].second];
+                    }
+                    for (idx_t k = 0; k < end - begin; ++k) {
+                        gridpoints.set(sorted[k].i, sorted[k].j, begin + k);
+                    }
+                };
+                if (existing) {
+                    reorder(reused, gridpoints.size());
+                }
+                else {
+                    reorder(0, owned);
+                    reorder(owned, gridpoints.size());
+                }
+            }
+        }
+
         ATLAS_TRACE_SCOPE("Fill in ij2gp ") {
             ij2gp_.resize({imin, imax}, {jmin, jmax});
 
@@ -586,29 +706,48 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
         auto index_i    = array::make_indexview<idx_t, 1>(field_index_i_);
         auto index_j    = array::make_indexview<idx_t, 1>(field_index_j_);
 
-        atlas_omp_parallel_for(idx_t n = 0; n < gridpoints.size(); ++n) {
+        if (existing) {
+            auto existing_xy         = array::make_view<double, 2>(existing->field_xy_);
+            auto existing_part       = array::make_view<int, 1>(existing->field_partition_);
+            auto existing_global_idx = array::make_view<gidx_t, 1>(existing->field_global_index_);
+            auto existing_index_i    = array::make_indexview<idx_t, 1>(existing->field_index_i_);
+            auto existing_index_j    = array::make_indexview<idx_t, 1>(existing->field_index_j_);
+            auto existing_ghost      = array::make_view<int, 1>(existing->field_ghost_);
+            atlas_omp_parallel_for(idx_t n = 0; n < reused; ++n) {
+                xy(n, XX)     = existing_xy(n, XX);
+                xy(n, YY)     = existing_xy(n, YY);
+                part(n)       = existing_part(n);
+                global_idx(n) = existing_global_idx(n);
+                index_i(n)    = existing_index_i(n);
+                index_j(n)    = existing_index_j(n);
+                ghost(n)      = existing_ghost(n);
+            }
+        }
+
+        atlas_omp_parallel_for(idx_t n = reused; n < gridpoints.size(); ++n) {
             const GridPoint& gp = gridpoints[n];
             if (gp.j >= 0 && gp.j < grid_->ny()) {
                 xy(gp.r, XX) = grid_->x(gp.i, gp.j);
                 xy(gp.r, YY) = grid_->y(gp.j);
             }
             else {
-                xy(gp.r, XX) = compute_x(gp.i, gp.j);
-                xy(gp.r, YY) = compute_y(gp.j);
+                xy(gp.r, XX) = index.x(gp.i, gp.j);
+                xy(gp.r, YY) = index.y(gp.j);
             }
 
             bool in_domain(false);
             if (gp.j >= 0 && gp.j < grid_->ny()) {
                 if (gp.i >= 0 && gp.i < grid_->nx(gp.j)) {
                     in_domain        = true;
-                    gidx_t k         = global_offsets[gp.j] + gp.i;
+                    gidx_t k         = index.offset(gp.j) + gp.i;
                     part(gp.r)       = distribution.partition(k);
                     global_idx(gp.r) = k + 1;
                 }
             }
             if (not in_domain) {
-                global_idx(gp.r) = compute_g(gp.i, gp.j);
-                part(gp.r)       = compute_p(gp.i, gp.j);
+                gidx_t g;
+                part(gp.r)       = compute_p(gp.i, gp.j, g);
+                global_idx(gp.r) = g;
             }
             index_i(gp.r) = gp.i;
             index_j(gp.r) = gp.j;
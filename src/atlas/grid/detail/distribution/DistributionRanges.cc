@@ -0,0 +1,134 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "DistributionRanges.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "eckit/types/Types.h"
+#include "eckit/utils/Hash.h"
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+DistributionRanges::DistributionRanges(int nb_partitions, gidx_t size, const int part[], const std::string& type):
+    nb_partitions_(nb_partitions), size_(size) {
+    // Each thread compresses a contiguous chunk, chunks are then concatenated in order
+    int num_threads = atlas_omp_get_max_threads();
+    std::vector<std::vector<gidx_t>> begin_per_thread(num_threads);
+    std::vector<std::vector<int>> part_per_thread(num_threads);
+    atlas_omp_parallel {
+        int thread         = atlas_omp_get_thread_num();
+        int threads        = atlas_omp_get_num_threads();
+        gidx_t chunk_begin = (size * thread) / threads;
+        gidx_t chunk_end   = (size * (thread + 1)) / threads;
+        auto& begin        = begin_per_thread[thread];
+        auto& partition    = part_per_thread[thread];
+        for (gidx_t n = chunk_begin; n < chunk_end; ++n) {
+            if (partition.empty() || part[n] != partition.back()) {
+                begin.emplace_back(n);
+                partition.emplace_back(part[n]);
+            }
+        }
+    }
+
+    size_t nb_ranges = 0;
+    for (int thread = 0; thread < num_threads; ++thread) {
+        nb_ranges += part_per_thread[thread].size();
+    }
+    begin_.reserve(nb_ranges);
+    part_.reserve(nb_ranges);
+    for (int thread = 0; thread < num_threads; ++thread) {
+        const auto& begin     = begin_per_thread[thread];
+        const auto& partition = part_per_thread[thread];
+        for (size_t r = 0; r < partition.size(); ++r) {
+            if (part_.empty() || partition[r] != part_.back()) {
+                begin_.emplace_back(begin[r]);
+                part_.emplace_back(partition[r]);
+            }
+        }
+    }
+    begin_.shrink_to_fit();
+    part_.shrink_to_fit();
+    setup(type);
+}
+
+DistributionRanges::DistributionRanges(int nb_partitions, gidx_t size, std::vector<gidx_t>&& begin,
+                                       std::vector<int>&& part, const std::string& type):
+    nb_partitions_(nb_partitions), size_(size), begin_(std::move(begin)), part_(std::move(part)) {
+    ATLAS_ASSERT(begin_.size() == part_.size());
+    ATLAS_ASSERT(size_ == 0 || (not begin_.empty() && begin_.front() == 0));
+    for (size_t r = 1; r < begin_.size(); ++r) {
+        ATLAS_ASSERT(begin_[r] > begin_[r - 1]);
+    }
+    ATLAS_ASSERT(begin_.empty() || begin_.back() < size_);
+    setup(type);
+}
+
+DistributionRanges::~DistributionRanges() = default;
+
+void DistributionRanges::setup(const std::string& type) {
+    nb_pts_.assign(nb_partitions_, 0);
+    for (size_t r = 0; r < part_.size(); ++r) {
+        ATLAS_ASSERT(part_[r] >= 0 && part_[r] < nb_partitions_);
+        nb_pts_[part_[r]] += static_cast<idx_t>(range_end(r) - begin_[r]);
+    }
+    max_pts_ = *std::max_element(nb_pts_.begin(), nb_pts_.end());
+    min_pts_ = *std::min_element(nb_pts_.begin(), nb_pts_.end());
+    type_    = nb_partitions_ == 1 ? "serial" : type;
+}
+
+void DistributionRanges::partition(gidx_t begin, gidx_t end, int partitions[]) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t i = 0;
+    for (size_t r = range(begin); begin < end; ++r) {
+        const gidx_t r_end = std::min(range_end(r), end);
+        const int p        = part_[r];
+        for (; begin < r_end; ++begin, ++i) {
+            partitions[i] = p;
+        }
+    }
+}
+
+void DistributionRanges::print(std::ostream& s) const {
+    auto print_partition = [&](std::ostream& s) {
+        eckit::output_list<int> list_printer(s);
+        for (size_t r = 0; r < part_.size(); ++r) {
+            for (gidx_t n = begin_[r]; n < range_end(r); ++n) {
+                list_printer.push_back(part_[r]);
+            }
+        }
+    };
+    s << "Distribution( "
+      << "type: " << type_ << ", nb_points: " << size_ << ", nb_partitions: " << nb_pts_.size()
+      << ", nb_ranges: " << part_.size() << ", parts : ";
+    print_partition(s);
+}
+
+void DistributionRanges::hash(eckit::Hash& hash) const {
+    for (size_t r = 0; r < part_.size(); ++r) {
+        for (gidx_t n = begin_[r]; n < range_end(r); ++n) {
+            hash.add(part_[r]);
+        }
+    }
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -0,0 +1,94 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "atlas/grid/detail/distribution/DistributionImpl.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// Compact distribution, storing the partition as run-length encoded ranges of consecutive global indices
+/// that belong to the same partition.
+/// For partitioners that assign contiguous blocks of points (e.g. per latitude row) the memory footprint
+/// scales with the number of ranges instead of with the number of grid points.
+class DistributionRanges : public DistributionImpl {
+public:
+    /// Compress given partition array of given size
+    DistributionRanges(int nb_partitions, gidx_t size, const int partition[], const std::string& type);
+
+    /// Construct from ranges: range r contains global indices [begin[r], begin[r+1]) with begin[nb_ranges] == size,
+    /// and belongs to partition[r]. Begin must start with 0 and be strictly increasing.
+    DistributionRanges(int nb_partitions, gidx_t size, std::vector<gidx_t>&& begin, std::vector<int>&& partition,
+                       const std::string& type);
+
+    virtual ~DistributionRanges();
+
+    int partition(const gidx_t gidx) const override { return part_[range(gidx)]; }
+
+    void partition(gidx_t begin, gidx_t end, int partitions[]) const override;
+
+    idx_t nb_partitions() const override { return nb_partitions_; }
+
+    const std::vector<idx_t>& nb_pts() const override { return nb_pts_; }
+
+    idx_t max_pts() const override { return max_pts_; }
+    idx_t min_pts() const override { return min_pts_; }
+
+    const std::string& type() const override { return type_; }
+
+    void print(std::ostream&) const override;
+
+    size_t footprint() const override {
+        return nb_pts_.size() * sizeof(nb_pts_[0]) + begin_.size() * sizeof(begin_[0]) +
+               part_.size() * sizeof(part_[0]);
+    }
+
+    bool functional() const override { return false; }
+
+    gidx_t size() const override { return size_; }
+
+    /// Hash is identical to the one of a DistributionArray with the same partitioning
+    void hash(eckit::Hash&) const override;
+
+    size_t nb_ranges() const { return part_.size(); }
+
+private:
+    /// Index of the range containing given global index
+    size_t range(gidx_t gidx) const {
+        return static_cast<size_t>(std::upper_bound(begin_.begin(), begin_.end(), gidx) - begin_.begin()) - 1;
+    }
+
+    gidx_t range_end(size_t r) const { return r + 1 < begin_.size() ? begin_[r + 1] : size_; }
+
+    void setup(const std::string& type);
+
+private:
+    idx_t nb_partitions_ = 0;
+    gidx_t size_         = 0;
+
+    std::vector<gidx_t> begin_;
+    std::vector<int> part_;
+    std::vector<idx_t> nb_pts_;
+    idx_t max_pts_;
+    idx_t min_pts_;
+    std::string type_;
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
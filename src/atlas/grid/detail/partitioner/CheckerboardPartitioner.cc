@@ -19,7 +19,10 @@
 #include <vector>
 
 
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionRanges.h"
+#include "atlas/grid/detail/distribution/SerialDistribution.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/MicroDeg.h"
@@ -118,20 +121,14 @@ bool compare_X_Y(const CheckerboardPartitioner::NodeInt& node1, const Checkerboa
     return false;
 }
 
-void CheckerboardPartitioner::partition(const Checkerboard& cb, int nb_nodes, NodeInt nodes[], int part[]) const {
+std::vector<CheckerboardPartitioner::Band> CheckerboardPartitioner::bands(const Checkerboard& cb,
+                                                                           size_t nb_nodes) const {
     size_t nparts = nb_partitions();
     size_t nbands = cb.nbands;
     size_t nx     = cb.nx;
     size_t ny     = cb.ny;
     long remainder;
 
-    /*
-Sort nodes from south to north (increasing y), and west to east (increasing x).
-Now we can easily split
-the points in bands. Note this may not be necessary, as it could be
-already by construction in this order, but then sorting is really fast
-*/
-
     /*
 Number of procs per band
 */
@@ -176,40 +173,36 @@ Number of gridpoints per band
         }
     }
 
-    // sort nodes according to Y first, to determine bands
-    std::sort(nodes, nodes + nb_nodes, compare_Y_X);
-
-    // for each band, select gridpoints belonging to that band, and sort them
-    // according to X first
+    std::vector<Band> bands(nbands);
     size_t offset = 0;
-    int jpart     = 0;
     for (size_t iband = 0; iband < nbands; iband++) {
-        // sort according to X first
-        std::sort(nodes + offset, nodes + offset + ngpb[iband], compare_X_Y);
+        Band& band = bands[iband];
+        band.begin = offset;
+        band.size  = ngpb[iband];
+        offset += ngpb[iband];
 
         // number of gridpoints per task
-        std::vector<int> ngpp(npartsb[iband], 0);
+        auto& ngpp = band.parts;
+        ngpp.assign(npartsb[iband], 0);
         remainder = ngpb[iband];
 
-        int part_ny = ngpb[iband] / cb.nx;
-        int part_nx = ngpb[iband] / npartsb[iband] / part_ny;
-
-        for (size_t ipart = 0; ipart < npartsb[iband]; ipart++) {
-            if (split_lons) {
+        if (split_lons) {
+            for (size_t ipart = 0; ipart < npartsb[iband]; ipart++) {
                 ngpp[ipart] = ngpb[iband] / npartsb[iband];
+                remainder -= ngpp[ipart];
             }
-            else {
-                ngpp[ipart] = part_nx * part_ny;
-            }
-            remainder -= ngpp[ipart];
-        }
-        if (split_lons) {
             // distribute remaining gridpoints over first parts
             for (size_t ipart = 0; ipart < remainder; ipart++) {
                 ++ngpp[ipart];
             }
         }
         else {
+            long part_ny = ngpb[iband] / cb.nx;
+            long part_nx = ngpb[iband] / npartsb[iband] / part_ny;
+            for (size_t ipart = 0; ipart < npartsb[iband]; ipart++) {
+                ngpp[ipart] = part_nx * part_ny;
+                remainder -= ngpp[ipart];
+            }
             size_t ipart = 0;
             while (remainder > part_ny) {
                 ngpp[ipart++] += part_ny;
@@ -217,13 +210,36 @@ Number of gridpoints per band
             }
             ngpp[npartsb[iband] - 1] += remainder;
         }
+    }
+    return bands;
+}
+
+void CheckerboardPartitioner::partition(const Checkerboard& cb, int nb_nodes, NodeInt nodes[], int part[]) const {
+    /*
+Sort nodes from south to north (increasing y), and west to east (increasing x).
+Now we can easily split
+the points in bands. Note this may not be necessary, as it could be
+already by construction in this order, but then sorting is really fast
+*/
+    auto bands = this->bands(cb, nb_nodes);
+
+    // sort nodes according to Y first, to determine bands
+    std::sort(nodes, nodes + nb_nodes, compare_Y_X);
+
+    // for each band, select gridpoints belonging to that band, and sort them
+    // according to X first
+    int jpart = 0;
+    for (const auto& band : bands) {
+        // sort according to X first
+        std::sort(nodes + band.begin, nodes + band.begin + band.size, compare_X_Y);
 
         // set partition number for each part
-        for (size_t ipart = 0; ipart < npartsb[iband]; ipart++) {
-            for (size_t jj = offset; jj < offset + ngpp[ipart]; jj++) {
+        size_t offset = band.begin;
+        for (size_t ngpp : band.parts) {
+            for (size_t jj = offset; jj < offset + ngpp; jj++) {
                 part[nodes[jj].n] = jpart;
             }
-            offset += ngpp[ipart];
+            offset += ngpp;
             ++jpart;
         }
     }
@@ -255,6 +271,79 @@ void CheckerboardPartitioner::partition(const Grid& grid, int part[]) const {
     }
 }
 
+Distribution CheckerboardPartitioner::partition(const Grid& grid) const {
+    if (nb_partitions() == 1) {
+        return Distribution{new distribution::SerialDistribution{grid, 0}};
+    }
+
+    // Nodes are numbered row by row from south to north, so every band is a contiguous range of global indices.
+    // Within a band the partitions follow from the position of each node in west-east, south-north order.
+    auto cb          = checkerboard(grid);
+    const size_t nx  = cb.nx;
+    std::vector<gidx_t> range_begin;
+    std::vector<int> range_part;
+    auto append = [&](gidx_t begin, int p) {
+        if (range_part.empty() || range_part.back() != p) {
+            range_begin.emplace_back(begin);
+            range_part.emplace_back(p);
+        }
+    };
+
+    std::vector<size_t> column_offset(nx + 1);
+    std::vector<size_t> part_end;
+    int jpart = 0;
+    for (const auto& band : bands(cb, grid.size())) {
+        if (band.size > 0) {
+            // Rows y0 (from x0) to y1 (until x1) belong to the band
+            const size_t y0 = band.begin / nx;
+            const size_t x0 = band.begin % nx;
+            const size_t y1 = (band.begin + band.size - 1) / nx;
+            const size_t x1 = (band.begin + band.size - 1) % nx + 1;
+
+            // First row of the band in column x, and position of node (x,y) in west-east, south-north order
+            auto column_begin = [&](size_t x) { return x >= x0 ? y0 : y0 + 1; };
+            auto column_end   = [&](size_t x) { return x < x1 ? y1 + 1 : y1; };
+            for (size_t x = 0; x < nx; ++x) {
+                const size_t height  = std::max(column_end(x), column_begin(x)) - column_begin(x);
+                column_offset[x + 1] = column_offset[x] + height;
+            }
+            auto position = [&](size_t x, size_t y) { return column_offset[x] + (y - column_begin(x)); };
+
+            part_end.resize(band.parts.size());
+            size_t end = 0;
+            for (size_t ipart = 0; ipart < band.parts.size(); ++ipart) {
+                end += band.parts[ipart];
+                part_end[ipart] = end;
+            }
+
+            // Along a row the position increases with x, so every partition is a range of the row
+            for (size_t y = y0; y <= y1; ++y) {
+                const size_t xend = (y == y1) ? x1 : nx;
+                for (size_t x = (y == y0) ? x0 : 0; x < xend;) {
+                    const size_t ipart =
+                        std::upper_bound(part_end.begin(), part_end.end(), position(x, y)) - part_end.begin();
+                    size_t lo = x + 1;
+                    size_t hi = xend;
+                    while (lo < hi) {
+                        const size_t mid = lo + (hi - lo) / 2;
+                        if (position(mid, y) < part_end[ipart]) {
+                            lo = mid + 1;
+                        }
+                        else {
+                            hi = mid;
+                        }
+                    }
+                    append(static_cast<gidx_t>(y * nx + x), jpart + static_cast<int>(ipart));
+                    x = lo;
+                }
+            }
+        }
+        jpart += static_cast<int>(band.parts.size());
+    }
+    return Distribution{new distribution::DistributionRanges{nb_partitions(), grid.size(), std::move(range_begin),
+                                                             std::move(range_part), type()}};
+}
+
 }  // namespace partitioner
 }  // namespace detail
 }  // namespace grid
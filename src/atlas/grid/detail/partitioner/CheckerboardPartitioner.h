@@ -50,6 +50,16 @@ private:
 
     Checkerboard checkerboard(const Grid&) const;
 
+    /// Nodes [begin,begin+size) in south-north, west-east order form a band, which is split in consecutive
+    /// chunks of parts[p] nodes in west-east, south-north order
+    struct Band {
+        size_t begin;
+        size_t size;
+        std::vector<size_t> parts;
+    };
+
+    std::vector<Band> bands(const Checkerboard& cb, size_t nb_nodes) const;
+
     // Doesn't matter if nodes[] is in degrees or radians, as a sorting
     // algorithm is used internally
     void partition(const Checkerboard& cb, int nb_nodes, NodeInt nodes[], int part[]) const;
@@ -57,6 +67,9 @@ private:
     using Partitioner::partition;
     virtual void partition(const Grid&, int part[]) const;
 
+    /// Distribution stored as compact ranges of global indices, see distribution::DistributionRanges
+    Distribution partition(const Grid&) const override;
+
     void check() const;
 
 private:
@@ -15,12 +15,17 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <vector>
 
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/Iterator.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionRanges.h"
+#include "atlas/grid/detail/distribution/SerialDistribution.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
@@ -978,6 +983,196 @@ void EqualRegionsPartitioner::partition(const Grid& grid, int part[]) const {
     }      // else
 }
 
+namespace {
+
+/// Part [ibegin,iend) of row j of a StructuredGrid that belongs to a band
+struct BandRow {
+    idx_t j;
+    idx_t ibegin;
+    idx_t iend;
+    gidx_t offset;  // global index of point (ibegin,j)
+    int y;          // microdeg
+};
+
+/// Number of points in the row with microdeg(x) < X.
+/// The index is estimated from the uniform spacing of the row, and then corrected to give the exact result.
+idx_t count_less(const StructuredGrid& grid, const BandRow& row, int X) {
+    const idx_t j = row.j;
+    idx_t i       = row.ibegin;
+    if (grid.dx(j) > 0.) {
+        double guess = std::ceil(((X - 0.5) * 1.e-6 - grid.xmin(j)) / grid.dx(j));
+        guess        = std::max(guess, static_cast<double>(row.ibegin));
+        guess        = std::min(guess, static_cast<double>(row.iend));
+        i            = static_cast<idx_t>(guess);
+    }
+    while (i > row.ibegin && microdeg(grid.x(i - 1, j)) >= X) {
+        --i;
+    }
+    while (i < row.iend && microdeg(grid.x(i, j)) < X) {
+        ++i;
+    }
+    return i - row.ibegin;
+}
+
+/// Compute for every row of the band the number of points that come before the given rank,
+/// when the points of the band are sorted from west to east, and north to south (see compare_WE_NS)
+void split_band(const StructuredGrid& grid, const std::vector<BandRow>& rows, gidx_t rank, idx_t split[]) {
+    auto count = [&](int X) {
+        gidx_t c = 0;
+        for (const auto& row : rows) {
+            c += count_less(grid, row, X);
+        }
+        return c;
+    };
+
+    int lo = std::numeric_limits<int>::max();
+    int hi = std::numeric_limits<int>::min();
+    for (const auto& row : rows) {
+        if (row.iend > row.ibegin) {
+            lo = std::min(lo, microdeg(grid.x(row.ibegin, row.j)));
+            hi = std::max(hi, microdeg(grid.x(row.iend - 1, row.j)));
+        }
+    }
+
+    // Smallest X such that more than "rank" points have microdeg(x) <= X
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (count(mid + 1) > rank) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    const int X = lo;
+
+    // Points with microdeg(x) == X are ordered from north to south
+    gidx_t nb_less = 0;
+    std::vector<size_t> ties;
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const auto& row = rows[r];
+        split[r]        = count_less(grid, row, X);
+        nb_less += split[r];
+        idx_t i = row.ibegin + split[r];
+        if (i < row.iend && microdeg(grid.x(i, row.j)) == X) {
+            ties.emplace_back(r);
+        }
+    }
+    std::stable_sort(ties.begin(), ties.end(), [&](size_t a, size_t b) { return rows[a].y > rows[b].y; });
+    ATLAS_ASSERT(rank - nb_less <= static_cast<gidx_t>(ties.size()));
+    for (gidx_t k = 0; k < rank - nb_less; ++k) {
+        ++split[ties[k]];
+    }
+}
+
+}  // namespace
+
+bool EqualRegionsPartitioner::partition_structured(const Grid& _grid, std::vector<gidx_t>& range_begin,
+                                                   std::vector<int>& range_part) const {
+    StructuredGrid grid(_grid);
+    if (not grid || grid.projection().units() != "degrees") {
+        return false;
+    }
+    // With Coordinates::LONLAT the points are sorted by (lon,lat), which only equals (x,y) without projection
+    if (coordinates_ != Coordinates::XY && grid.projection().type() != "lonlat") {
+        return false;
+    }
+    for (idx_t j = 0; j < grid.ny(); ++j) {
+        if (grid.nx(j) > 1 && grid.dx(j) <= 0.) {
+            return false;
+        }
+    }
+
+    ATLAS_TRACE("EqualRegionsPartitioner::partition_structured");
+
+    // Same number of points per partition, and consecutive partitions per band, as in partition(grid,part[])
+    const gidx_t nb_nodes        = grid.size();
+    const gidx_t chunk_size      = nb_nodes / N_;
+    const gidx_t chunk_remainder = nb_nodes - chunk_size * N_;
+    std::vector<gidx_t> displs(N_ + 1, 0);
+    for (int p = 0; p < N_; ++p) {
+        displs[p + 1] = displs[p] + chunk_size + (p < chunk_remainder ? 1 : 0);
+    }
+
+    std::vector<gidx_t> row_offset(grid.ny() + 1, 0);
+    for (idx_t j = 0; j < grid.ny(); ++j) {
+        row_offset[j + 1] = row_offset[j] + grid.nx(j);
+    }
+
+    auto append = [&](gidx_t begin, int p) {
+        if (range_part.empty() || range_part.back() != p) {
+            range_begin.emplace_back(begin);
+            range_part.emplace_back(p);
+        }
+    };
+
+    // Points are sorted north to south by construction, so every band is a contiguous range of global indices.
+    // Within a band the partitions follow from splitting every row at the boundaries of the sorted order.
+    int w0 = 0;
+    idx_t j = 0;
+    for (int band = 0; band < nb_bands(); ++band) {
+        const int nb_parts_band = nb_regions(band);
+        const gidx_t band_begin = displs[w0];
+        const gidx_t band_end   = displs[w0 + nb_parts_band];
+
+        std::vector<BandRow> rows;
+        while (j < grid.ny() && row_offset[j + 1] <= band_begin) {
+            ++j;
+        }
+        for (idx_t jj = j; jj < grid.ny() && row_offset[jj] < band_end; ++jj) {
+            BandRow row;
+            row.j      = jj;
+            row.ibegin = static_cast<idx_t>(std::max(band_begin, row_offset[jj]) - row_offset[jj]);
+            row.iend   = static_cast<idx_t>(std::min(band_end, row_offset[jj + 1]) - row_offset[jj]);
+            row.offset = row_offset[jj] + row.ibegin;
+            row.y      = microdeg(grid.y(jj));
+            rows.emplace_back(row);
+        }
+        const size_t nb_rows = rows.size();
+
+        // split(r,p): number of points of row r that belong to partitions before w0+p
+        std::vector<idx_t> split(nb_rows * (nb_parts_band + 1));
+        for (size_t r = 0; r < nb_rows; ++r) {
+            split[r] = 0;
+            split[nb_parts_band * nb_rows + r] = rows[r].iend - rows[r].ibegin;
+        }
+        atlas_omp_parallel_for(int p = 1; p < nb_parts_band; ++p) {
+            split_band(grid, rows, displs[w0 + p] - band_begin, split.data() + p * nb_rows);
+        }
+
+        for (size_t r = 0; r < nb_rows; ++r) {
+            for (int p = 0; p < nb_parts_band; ++p) {
+                if (split[(p + 1) * nb_rows + r] > split[p * nb_rows + r]) {
+                    append(rows[r].offset + split[p * nb_rows + r], w0 + p);
+                }
+            }
+        }
+        w0 += nb_parts_band;
+    }
+    return true;
+}
+
+Distribution EqualRegionsPartitioner::partition(const Grid& grid) const {
+    if (N_ == 1) {
+        return Distribution{new distribution::SerialDistribution{grid, 0}};
+    }
+
+    // For structured grids the partitioning is computed per row without a global array of nodes
+    std::vector<gidx_t> range_begin;
+    std::vector<int> range_part;
+    if (partition_structured(grid, range_begin, range_part)) {
+        return Distribution{new distribution::DistributionRanges{N_, grid.size(), std::move(range_begin),
+                                                                 std::move(range_part), type()}};
+    }
+
+    // Other grids are partitioned by sorting all points, so the partition of a point is only known after a global
+    // sort and cannot be computed per row. The partition array is compressed into ranges afterwards.
+    atlas::vector<int> part(grid.size());
+    partition(grid, part.data());
+    ATLAS_TRACE("EqualRegionsPartitioner::compress");
+    return Distribution{new distribution::DistributionRanges{N_, grid.size(), part.data(), type()}};
+}
+
 }  // namespace partitioner
 }  // namespace detail
 }  // namespace grid
@@ -91,6 +91,9 @@ public:
     using Partitioner::partition;
     virtual void partition(const Grid&, int part[]) const;
 
+    /// Distribution stored as compact ranges of global indices, see distribution::DistributionRanges
+    Distribution partition(const Grid&) const override;
+
     virtual std::string type() const { return "equal_regions"; }
 
 public:
@@ -122,6 +125,10 @@ private:
     // algorithm is used internally
     void partition(int nb_nodes, NodeInt nodes[], int part[]) const;
 
+    // Compute the partitioning of a StructuredGrid as ranges of global indices, analytically from nx(j), x and y,
+    // without sorting a global array of nodes. Returns false if the grid is not suited.
+    bool partition_structured(const Grid&, std::vector<gidx_t>& range_begin, std::vector<int>& range_part) const;
+
     friend class EqualAreaPartitioner;
     // y in radians
     int band(const double& y) const;
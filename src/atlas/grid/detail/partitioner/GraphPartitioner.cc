@@ -0,0 +1,469 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/grid/detail/partitioner/GraphPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "atlas/grid/Iterator.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/KDTree.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+namespace {
+
+using Graph = GraphPartitioner::Graph;
+using Edge  = std::pair<idx_t, idx_t>;
+
+/// Symmetric graph from a list of undirected edges. Duplicate edges and self-loops are removed.
+Graph make_graph(idx_t nb_vertices, std::vector<Edge>& edges) {
+    for (auto& e : edges) {
+        if (e.first > e.second) {
+            std::swap(e.first, e.second);
+        }
+    }
+    omp::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    Graph graph;
+    graph.vwgt.assign(nb_vertices, 1.);
+    graph.xadj.assign(nb_vertices + 1, 0);
+    for (const auto& e : edges) {
+        if (e.first != e.second) {
+            ++graph.xadj[e.first + 1];
+            ++graph.xadj[e.second + 1];
+        }
+    }
+    std::partial_sum(graph.xadj.begin(), graph.xadj.end(), graph.xadj.begin());
+    graph.adjncy.resize(graph.xadj.back());
+    graph.adjwgt.assign(graph.xadj.back(), 1);
+    std::vector<size_t> pos(graph.xadj.begin(), graph.xadj.end() - 1);
+    for (const auto& e : edges) {
+        if (e.first != e.second) {
+            graph.adjncy[pos[e.first]++]  = e.second;
+            graph.adjncy[pos[e.second]++] = e.first;
+        }
+    }
+    return graph;
+}
+
+/// Deterministic random permutation, identical on every MPI task
+std::vector<idx_t> permutation(idx_t n, std::mt19937& rng) {
+    std::vector<idx_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    for (idx_t i = n - 1; i > 0; --i) {
+        std::swap(perm[i], perm[rng() % (i + 1)]);
+    }
+    return perm;
+}
+
+/// Coarsen graph by heavy edge matching. The map from fine to coarse vertices is returned in cmap.
+Graph coarsen(const Graph& graph, double max_vwgt, std::mt19937& rng, std::vector<idx_t>& cmap) {
+    const idx_t n = graph.size();
+
+    std::vector<idx_t> match(n, -1);
+    for (idx_t u : permutation(n, rng)) {
+        if (match[u] >= 0) {
+            continue;
+        }
+        idx_t best   = u;
+        idx_t best_w = 0;
+        for (size_t e = graph.xadj[u]; e < graph.xadj[u + 1]; ++e) {
+            idx_t v = graph.adjncy[e];
+            if (match[v] < 0 && graph.adjwgt[e] > best_w && graph.vwgt[u] + graph.vwgt[v] <= max_vwgt) {
+                best   = v;
+                best_w = graph.adjwgt[e];
+            }
+        }
+        match[u]    = best;
+        match[best] = u;
+    }
+
+    cmap.resize(n);
+    idx_t nc = 0;
+    for (idx_t u = 0; u < n; ++u) {
+        if (u <= match[u]) {
+            cmap[u] = cmap[match[u]] = nc++;
+        }
+    }
+
+    Graph coarse;
+    coarse.vwgt.assign(nc, 0.);
+    coarse.xadj.assign(nc + 1, 0);
+    coarse.adjncy.reserve(graph.adjncy.size() / 2);
+    coarse.adjwgt.reserve(graph.adjncy.size() / 2);
+    std::vector<size_t> marker(nc, size_t(-1));
+    for (idx_t u = 0; u < n; ++u) {
+        if (u > match[u]) {
+            continue;
+        }
+        const idx_t cu     = cmap[u];
+        const size_t begin = coarse.adjncy.size();
+        for (idx_t w : {u, match[u]}) {
+            coarse.vwgt[cu] += graph.vwgt[w];
+            for (size_t e = graph.xadj[w]; e < graph.xadj[w + 1]; ++e) {
+                idx_t cv = cmap[graph.adjncy[e]];
+                if (cv == cu) {
+                    continue;
+                }
+                if (marker[cv] == size_t(-1)) {
+                    marker[cv] = coarse.adjncy.size();
+                    coarse.adjncy.emplace_back(cv);
+                    coarse.adjwgt.emplace_back(graph.adjwgt[e]);
+                }
+                else {
+                    coarse.adjwgt[marker[cv]] += graph.adjwgt[e];
+                }
+            }
+            if (w == match[u]) {
+                break;
+            }
+        }
+        for (size_t k = begin; k < coarse.adjncy.size(); ++k) {
+            marker[coarse.adjncy[k]] = size_t(-1);
+        }
+        coarse.xadj[cu + 1] = coarse.adjncy.size();
+    }
+    return coarse;
+}
+
+/// Recursive bisection of the subgraph with given vertices into nb_parts partitions, numbered from part0.
+/// Each bisection grows a region breadth-first from a pseudo-peripheral vertex until it has its share of the weight.
+void bisect(const Graph& graph, const std::vector<idx_t>& vertices, int part0, int nb_parts, std::vector<int>& part,
+            std::vector<int>& mark) {
+    if (nb_parts == 1 || vertices.size() <= 1) {
+        for (idx_t v : vertices) {
+            part[v] = part0;
+        }
+        return;
+    }
+    const int nb_parts_left = nb_parts / 2;
+
+    double weight = 0.;
+    for (idx_t v : vertices) {
+        weight += graph.vwgt[v];
+    }
+    const double target = weight * nb_parts_left / nb_parts;
+
+    // mark: 0 = not in subgraph, 1 = in subgraph, 2 = visited
+    for (idx_t v : vertices) {
+        mark[v] = 1;
+    }
+    std::vector<idx_t> queue;
+    queue.reserve(vertices.size());
+    auto bfs = [&](idx_t start, double max_weight) {
+        size_t head      = queue.size();
+        double collected = 0.;
+        mark[start]      = 2;
+        queue.emplace_back(start);
+        while (head < queue.size() && collected < max_weight) {
+            idx_t u = queue[head++];
+            collected += graph.vwgt[u];
+            for (size_t e = graph.xadj[u]; e < graph.xadj[u + 1]; ++e) {
+                idx_t v = graph.adjncy[e];
+                if (mark[v] == 1) {
+                    mark[v] = 2;
+                    queue.emplace_back(v);
+                }
+            }
+        }
+        return head;
+    };
+
+    // Pseudo-peripheral vertex: last vertex reached by a breadth-first search
+    bfs(vertices[0], weight);
+    idx_t start = queue.back();
+    for (idx_t v : queue) {
+        mark[v] = 1;
+    }
+    queue.clear();
+
+    // Grow the left region, continuing in other components if the subgraph is disconnected
+    std::vector<idx_t> left;
+    double left_weight = 0.;
+    size_t next        = 0;
+    while (left_weight < target) {
+        size_t nb_taken = bfs(start, target - left_weight);
+        for (size_t k = 0; k < nb_taken; ++k) {
+            left_weight += graph.vwgt[queue[k]];
+            left.emplace_back(queue[k]);
+        }
+        for (size_t k = nb_taken; k < queue.size(); ++k) {
+            mark[queue[k]] = 1;
+        }
+        for (size_t k = 0; k < nb_taken; ++k) {
+            mark[queue[k]] = 3;
+        }
+        queue.clear();
+        while (next < vertices.size() && mark[vertices[next]] != 1) {
+            ++next;
+        }
+        if (next == vertices.size()) {
+            break;
+        }
+        start = vertices[next];
+    }
+
+    std::vector<idx_t> right;
+    right.reserve(vertices.size() - left.size());
+    for (idx_t v : vertices) {
+        if (mark[v] != 3) {
+            right.emplace_back(v);
+        }
+        mark[v] = 0;
+    }
+
+    bisect(graph, left, part0, nb_parts_left, part, mark);
+    bisect(graph, right, part0 + nb_parts_left, nb_parts - nb_parts_left, part, mark);
+}
+
+/// Greedy k-way refinement: move boundary vertices to the neighbouring partition that reduces the edge-cut most,
+/// as long as the balance constraint is respected. Vertices of overweight partitions are moved to make
+/// the partitioning balanced.
+void refine(const Graph& graph, int nb_parts, double max_pwgt, int nb_passes, std::vector<int>& part) {
+    const idx_t n = graph.size();
+    std::vector<double> pwgt(nb_parts, 0.);
+    for (idx_t u = 0; u < n; ++u) {
+        pwgt[part[u]] += graph.vwgt[u];
+    }
+
+    std::vector<idx_t> external(nb_parts, 0);
+    std::vector<int> touched;
+    for (int pass = 0; pass < nb_passes; ++pass) {
+        idx_t nb_moves = 0;
+        for (idx_t u = 0; u < n; ++u) {
+            const int p    = part[u];
+            idx_t internal = 0;
+            for (size_t e = graph.xadj[u]; e < graph.xadj[u + 1]; ++e) {
+                int q = part[graph.adjncy[e]];
+                if (q == p) {
+                    internal += graph.adjwgt[e];
+                }
+                else {
+                    if (external[q] == 0) {
+                        touched.emplace_back(q);
+                    }
+                    external[q] += graph.adjwgt[e];
+                }
+            }
+            if (touched.empty()) {
+                continue;
+            }
+            const double w        = graph.vwgt[u];
+            const bool overweight = pwgt[p] > max_pwgt;
+            int best              = -1;
+            idx_t best_gain       = 0;
+            for (int q : touched) {
+                if (pwgt[q] + w > max_pwgt) {
+                    continue;
+                }
+                idx_t gain = external[q] - internal;
+                if (best < 0 || gain > best_gain || (gain == best_gain && pwgt[q] < pwgt[best])) {
+                    best      = q;
+                    best_gain = gain;
+                }
+            }
+            for (int q : touched) {
+                external[q] = 0;
+            }
+            touched.clear();
+
+            if (best >= 0 && (best_gain > 0 || (best_gain == 0 && pwgt[best] + w < pwgt[p]) || overweight)) {
+                part[u] = best;
+                pwgt[p] -= w;
+                pwgt[best] += w;
+                ++nb_moves;
+            }
+        }
+        if (nb_moves == 0) {
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+GraphPartitioner::GraphPartitioner(): GraphPartitioner(util::NoConfig()) {}
+
+GraphPartitioner::GraphPartitioner(int N, const eckit::Parametrisation& config): Partitioner(N, config) {
+    config.get("weights", weights_);
+    config.get("imbalance", imbalance_);
+    config.get("neighbours", neighbours_);
+}
+
+GraphPartitioner::GraphPartitioner(const eckit::Parametrisation& config):
+    GraphPartitioner(extract_nb_partitions(config), config) {}
+
+GraphPartitioner::Graph GraphPartitioner::graph(const Grid& grid) const {
+    ATLAS_TRACE("GraphPartitioner::graph");
+    const idx_t size = grid.size();
+    std::vector<Edge> edges;
+
+    if (StructuredGrid structured = StructuredGrid(grid)) {
+        // Structured stencil: neighbours within the row, and the two nearest points in the next row,
+        // seen from either row, so that rows with different nx are well connected
+        const idx_t ny = structured.ny();
+        std::vector<idx_t> offset(ny + 1, 0);
+        for (idx_t j = 0; j < ny; ++j) {
+            offset[j + 1] = offset[j] + structured.nx(j);
+        }
+        const bool periodic = structured.periodic();
+        auto nearest_west   = [&](idx_t j, double x) -> idx_t {
+            const idx_t nx = structured.nx(j);
+            if (nx == 1 || structured.dx(j) <= 0.) {
+                return 0;
+            }
+            idx_t i = static_cast<idx_t>(std::floor((x - structured.xmin(j)) / structured.dx(j)));
+            if (periodic) {
+                return ((i % nx) + nx) % nx;
+            }
+            return std::min(std::max(i, idx_t{0}), nx - 1);
+        };
+        auto east = [&](idx_t j, idx_t i) -> idx_t {
+            const idx_t nx = structured.nx(j);
+            return i + 1 < nx ? i + 1 : (periodic ? 0 : i);
+        };
+        auto connect_rows = [&](idx_t j, idx_t jn) {
+            for (idx_t i = 0; i < structured.nx(j); ++i) {
+                idx_t in = nearest_west(jn, structured.x(i, j));
+                edges.emplace_back(offset[j] + i, offset[jn] + in);
+                edges.emplace_back(offset[j] + i, offset[jn] + east(jn, in));
+            }
+        };
+        edges.reserve(4 * size_t(size));
+        for (idx_t j = 0; j < ny; ++j) {
+            for (idx_t i = 0; i < structured.nx(j); ++i) {
+                edges.emplace_back(offset[j] + i, offset[j] + east(j, i));
+            }
+            if (j + 1 < ny) {
+                connect_rows(j, j + 1);
+                connect_rows(j + 1, j);
+            }
+        }
+    }
+    else {
+        // Nearest neighbours
+        util::IndexKDTree search;
+        search.reserve(size);
+        idx_t n = 0;
+        for (const auto& p : grid.lonlat()) {
+            search.insert(p, n++);
+        }
+        search.build();
+        edges.reserve(size_t(size) * neighbours_);
+        n = 0;
+        for (const auto& p : grid.lonlat()) {
+            for (const auto& neighbour : search.closestPoints(p, neighbours_ + 1)) {
+                edges.emplace_back(n, neighbour.payload());
+            }
+            ++n;
+        }
+    }
+
+    Graph graph = make_graph(size, edges);
+    if (not weights_.empty()) {
+        ATLAS_ASSERT(weights_.size() == size_t(size), "Number of weights must match the grid size");
+        graph.vwgt = weights_;
+    }
+    return graph;
+}
+
+void GraphPartitioner::partition(const Graph& graph, int part[]) const {
+    ATLAS_TRACE("GraphPartitioner::partition");
+    const int nb_parts = nb_partitions();
+    const idx_t n      = graph.size();
+    if (nb_parts == 1 || n == 0) {
+        std::fill(part, part + n, 0);
+        return;
+    }
+
+    const double total_weight = std::accumulate(graph.vwgt.begin(), graph.vwgt.end(), 0.);
+    const double max_pwgt     = (1. + imbalance_) * total_weight / nb_parts;
+    const idx_t coarsen_to    = std::max<idx_t>(20 * nb_parts, 200);
+    const double max_vwgt     = 1.5 * total_weight / coarsen_to;
+
+    std::mt19937 rng(0);
+
+    // Coarsening phase
+    std::vector<Graph> graphs;
+    std::vector<std::vector<idx_t>> cmaps;
+    ATLAS_TRACE_SCOPE("coarsen") {
+        const Graph* fine = &graph;
+        while (fine->size() > coarsen_to) {
+            std::vector<idx_t> cmap;
+            Graph coarse = coarsen(*fine, max_vwgt, rng, cmap);
+            if (coarse.size() > 0.95 * fine->size()) {
+                break;
+            }
+            graphs.emplace_back(std::move(coarse));
+            cmaps.emplace_back(std::move(cmap));
+            fine = &graphs.back();
+        }
+    }
+    Log::debug() << "GraphPartitioner: " << graphs.size() << " coarsening levels, coarsest graph has "
+                 << (graphs.empty() ? n : graphs.back().size()) << " vertices" << std::endl;
+
+    // Initial partitioning of coarsest graph
+    const Graph& coarsest = graphs.empty() ? graph : graphs.back();
+    std::vector<int> coarse_part(coarsest.size());
+    ATLAS_TRACE_SCOPE("initial partitioning") {
+        std::vector<idx_t> vertices(coarsest.size());
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::vector<int> mark(coarsest.size(), 0);
+        bisect(coarsest, vertices, 0, nb_parts, coarse_part, mark);
+        refine(coarsest, nb_parts, max_pwgt, 8, coarse_part);
+    }
+
+    // Uncoarsening phase: project partitioning to the finer graph and refine
+    ATLAS_TRACE_SCOPE("uncoarsen") {
+        for (size_t level = graphs.size(); level > 0; --level) {
+            const Graph& fine             = level > 1 ? graphs[level - 2] : graph;
+            const std::vector<idx_t>& cmap = cmaps[level - 1];
+            std::vector<int> fine_part(fine.size());
+            for (idx_t u = 0; u < fine.size(); ++u) {
+                fine_part[u] = coarse_part[cmap[u]];
+            }
+            refine(fine, nb_parts, max_pwgt, 4, fine_part);
+            coarse_part.swap(fine_part);
+        }
+    }
+    std::copy(coarse_part.begin(), coarse_part.end(), part);
+}
+
+void GraphPartitioner::partition(const Grid& grid, int part[]) const {
+    if (nb_partitions() == 1) {
+        std::fill(part, part + grid.size(), 0);
+        return;
+    }
+    partition(graph(grid), part);
+}
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
+
+namespace {
+atlas::grid::detail::partitioner::PartitionerBuilder<atlas::grid::detail::partitioner::GraphPartitioner> __Graph(
+    atlas::grid::detail::partitioner::GraphPartitioner::static_type());
+}
@@ -0,0 +1,73 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/grid/detail/partitioner/Partitioner.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+/// Multilevel graph partitioner.
+///
+/// The adjacency graph of the grid points is coarsened by heavy edge matching, the coarsest graph is
+/// partitioned by recursive bisection, and the partitioning is projected back and refined on every level.
+/// The objective is to minimise the number of cut edges, a measure of the halo communication volume,
+/// while balancing the (weighted) number of points per partition.
+///
+/// The graph is built from the structured stencil for a StructuredGrid (neighbours within the row,
+/// and nearest neighbours in the rows to the north and south), and from nearest neighbours otherwise.
+///
+/// Configuration:
+///   - "weights"    : cost per grid point (e.g. physics cost), default 1 for every point
+///   - "imbalance"  : allowed relative load imbalance, default 0.03
+///   - "neighbours" : number of nearest neighbours connected to each point of an unstructured grid, default 6
+class GraphPartitioner : public Partitioner {
+public:
+    /// Undirected graph in compressed sparse row format
+    struct Graph {
+        std::vector<size_t> xadj;    // adjacency of vertex v is in [xadj[v], xadj[v+1])
+        std::vector<idx_t> adjncy;   // adjacent vertices
+        std::vector<idx_t> adjwgt;   // edge weights
+        std::vector<double> vwgt;    // vertex weights
+        idx_t size() const { return static_cast<idx_t>(vwgt.size()); }
+    };
+
+public:
+    GraphPartitioner();
+    GraphPartitioner(int N, const eckit::Parametrisation& config = util::NoConfig());
+    GraphPartitioner(const eckit::Parametrisation& config);
+
+    std::string type() const override { return static_type(); }
+    static std::string static_type() { return "graph"; }
+
+    using Partitioner::partition;
+    void partition(const Grid&, int part[]) const override;
+
+    /// Partition given graph into nb_partitions()
+    void partition(const Graph&, int part[]) const;
+
+    /// Adjacency graph of the grid points, with vertex weights from the configuration
+    Graph graph(const Grid&) const;
+
+private:
+    std::vector<double> weights_;
+    double imbalance_{0.03};
+    idx_t neighbours_{6};
+};
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -0,0 +1,134 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/grid/detail/partitioner/HilbertPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "atlas/domain/Domain.h"
+#include "atlas/grid/Iterator.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/SpaceFillingCurve.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+HilbertPartitioner::HilbertPartitioner(): HilbertPartitioner(util::NoConfig()) {}
+
+HilbertPartitioner::HilbertPartitioner(int N, const eckit::Parametrisation& config): Partitioner(N, config) {
+    config.get("order", order_);
+    ATLAS_ASSERT(order_ > 0 && order_ <= 30);
+}
+
+HilbertPartitioner::HilbertPartitioner(const eckit::Parametrisation& config):
+    HilbertPartitioner(extract_nb_partitions(config), config) {}
+
+void HilbertPartitioner::partition(const Grid& grid, int part[]) const {
+    const idx_t size   = grid.size();
+    const int nb_parts = nb_partitions();
+    if (nb_parts == 1) {
+        std::fill(part, part + size, 0);
+        return;
+    }
+
+    ATLAS_TRACE("HilbertPartitioner::partition");
+
+    // Coordinates along the curve: lonlat for global grids, xy otherwise
+    std::vector<double> x(size);
+    std::vector<double> y(size);
+    double xmin, xmax, ymin, ymax;
+    if (grid.domain() && grid.domain().global()) {
+        idx_t n = 0;
+        for (const auto& p : grid.lonlat()) {
+            double lon = std::fmod(p.lon(), 360.);
+            x[n]       = lon < 0. ? lon + 360. : lon;
+            y[n]       = p.lat();
+            ++n;
+        }
+        xmin = 0.;
+        xmax = 360.;
+        ymin = -90.;
+        ymax = 90.;
+    }
+    else {
+        idx_t n = 0;
+        for (const auto& p : grid.xy()) {
+            x[n] = p.x();
+            y[n] = p.y();
+            ++n;
+        }
+        xmin = *std::min_element(x.begin(), x.end());
+        xmax = *std::max_element(x.begin(), x.end());
+        ymin = *std::min_element(y.begin(), y.end());
+        ymax = *std::max_element(y.begin(), y.end());
+    }
+
+    // Squares side by side along the longest dimension; transpose when the domain is taller than wide
+    const bool transpose = (ymax - ymin) > (xmax - xmin);
+    if (transpose) {
+        std::swap(x, y);
+        std::swap(xmin, ymin);
+        std::swap(xmax, ymax);
+    }
+    const uint64_t n_cells = uint64_t(1) << order_;
+    const uint64_t n_keys  = n_cells * n_cells;
+    // Number of squares is limited so that the keys of all squares fit in 64 bits
+    const double height       = std::max(ymax - ymin, std::numeric_limits<double>::min());
+    const double width        = std::max(xmax - xmin, std::numeric_limits<double>::min());
+    const double max_squares  = std::min(double(std::numeric_limits<uint64_t>::max() / n_keys), 1.e6);
+    const uint64_t nb_squares = static_cast<uint64_t>(std::min(std::max(1., std::round(width / height)), max_squares));
+
+    auto cell = [](double v, double vmin, double extent, uint64_t n) {
+        double c = std::floor((v - vmin) / extent * double(n));
+        return static_cast<uint64_t>(std::min(std::max(c, 0.), double(n - 1)));
+    };
+
+    std::vector<std::pair<uint64_t, idx_t>> keys(size);
+    atlas_omp_parallel_for(idx_t n = 0; n < size; ++n) {
+        const uint64_t ix = cell(x[n], xmin, width, n_cells * nb_squares);
+        const uint64_t iy = cell(y[n], ymin, height, n_cells);
+        const uint64_t sq = ix / n_cells;
+        keys[n] = {sq * n_keys + util::hilbert_index(static_cast<uint32_t>(ix - sq * n_cells),
+                                                     static_cast<uint32_t>(iy), order_),
+                   n};
+    }
+    omp::sort(keys.begin(), keys.end());
+
+    // Cut the curve in pieces with equal number of points
+    const idx_t chunk_size      = size / nb_parts;
+    const idx_t chunk_remainder = size - chunk_size * nb_parts;
+    atlas_omp_parallel_for(int p = 0; p < nb_parts; ++p) {
+        const idx_t begin = p * chunk_size + std::min<idx_t>(p, chunk_remainder);
+        const idx_t end   = begin + chunk_size + (p < chunk_remainder ? 1 : 0);
+        for (idx_t k = begin; k < end; ++k) {
+            part[keys[k].second] = p;
+        }
+    }
+}
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
+
+namespace {
+atlas::grid::detail::partitioner::PartitionerBuilder<atlas::grid::detail::partitioner::HilbertPartitioner> __Hilbert(
+    atlas::grid::detail::partitioner::HilbertPartitioner::static_type());
+}
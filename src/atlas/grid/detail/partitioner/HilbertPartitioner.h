@@ -0,0 +1,48 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/grid/detail/partitioner/Partitioner.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+/// Partitioner that orders all grid points along a Hilbert space-filling curve, and cuts the curve
+/// in pieces with an equal number of points. Partitions are compact and contiguous, for any grid type.
+///
+/// For a global grid the curve fills the (lon,lat) domain [0,360)x[-90,90] as two adjacent squares.
+/// Otherwise the curve fills the bounding box of the (x,y) coordinates, with as many adjacent squares as
+/// the aspect ratio of the bounding box.
+///
+/// Configuration:
+///   - "order" : <int> (default=16) Number of recursions of the curve; each square has 2^order x 2^order cells
+class HilbertPartitioner : public Partitioner {
+public:
+    HilbertPartitioner();
+    HilbertPartitioner(int N, const eckit::Parametrisation& config = util::NoConfig());
+    HilbertPartitioner(const eckit::Parametrisation& config);
+
+    std::string type() const override { return static_type(); }
+    static std::string static_type() { return "hilbert"; }
+
+    using Partitioner::partition;
+    void partition(const Grid&, int part[]) const override;
+
+private:
+    int order_{16};
+};
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -10,15 +10,21 @@
 
 #include "atlas/grid/detail/partitioner/MatchingMeshPartitionerLonLatPolygon.h"
 
+#include <algorithm>
+#include <array>
 #include <iomanip>
+#include <set>
 #include <sstream>
 #include <vector>
 
 #include "eckit/config/Resource.h"
 #include "eckit/log/ProgressTimer.h"
 
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Iterator.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionRanges.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/fill.h"
@@ -38,15 +44,454 @@ namespace partitioner {
 
 namespace {
 PartitionerBuilder<MatchingMeshPartitionerLonLatPolygon> __builder("lonlat-polygon");
+
+[[noreturn]] void throw_failures(const std::vector<size_t>& failed_index, const std::vector<PointLonLat>& failed_lonlat,
+                                 const std::string& tries) {
+    const size_t nb_failures = failed_index.size();
+    std::stringstream err;
+    err.precision(20);
+    err << "Could not find partition of " << nb_failures
+        << " target grid points (source mesh does not contain all target grid points)\n"
+        << tries;
+
+    err << "Failed target grid points with global index:\n";
+    for (size_t n = 0; n < nb_failures; ++n) {
+        err << "  - " << std::setw(10) << std::left << failed_index[n] + 1 << " {lon,lat} : " << failed_lonlat[n]
+            << "\n";
+    }
+    // prePartitionedMesh_.polygon(0).outputPythonScript("partitions.py");
+    throw_Exception(err.str(), Here());
+}
+
+void handle_failures(const Grid& grid, int partitioning[], bool fallback_nearest, const std::string& tries) {
+    size_t i            = 0;
+    size_t max_failures = grid.size();
+    std::vector<size_t> failed_index;
+    std::vector<PointLonLat> failed_lonlat;
+    failed_index.reserve(max_failures);
+    failed_lonlat.reserve(max_failures);
+    for (PointLonLat P : grid.lonlat()) {
+        if (partitioning[i] < 0) {
+            failed_index.emplace_back(i);
+            failed_lonlat.emplace_back(P);
+        }
+        ++i;
+    }
+    size_t nb_failures = failed_index.size();
+
+    if (fallback_nearest) {
+        util::IndexKDTree3D kdtree;
+        kdtree.reserve(grid.size());
+        size_t j=0;
+        for (auto& p: grid.lonlat()) {
+            if (partitioning[j] >= 0) {
+                kdtree.insert(p,partitioning[j]);
+            }
+            ++j;
+        }
+        kdtree.build();
+        for (size_t n = 0; n < nb_failures; ++n) {
+            auto closest = kdtree.closestPoint(failed_lonlat[n]);
+            partitioning[failed_index[n]] = closest.payload();
+        }
+    }
+    else {
+        throw_failures(failed_index, failed_lonlat, tries);
+    }
+}
+
+// Index ranges are stored as consecutive pairs [begin,end)
+void append_index(std::vector<gidx_t>& ranges, gidx_t n) {
+    if (not ranges.empty() && ranges.back() == n) {
+        ++ranges.back();
+    }
+    else {
+        ranges.push_back(n);
+        ranges.push_back(n + 1);
+    }
+}
+
+// Sort and merge overlapping or adjacent index ranges
+std::vector<gidx_t> merge_ranges(std::vector<gidx_t> ranges) {
+    std::vector<std::pair<gidx_t, gidx_t>> pairs(ranges.size() / 2);
+    for (size_t r = 0; r < pairs.size(); ++r) {
+        pairs[r] = {ranges[2 * r], ranges[2 * r + 1]};
+    }
+    std::sort(pairs.begin(), pairs.end());
+    std::vector<gidx_t> merged;
+    merged.reserve(ranges.size());
+    for (const auto& range : pairs) {
+        if (not merged.empty() && range.first <= merged.back()) {
+            merged.back() = std::max(merged.back(), range.second);
+        }
+        else {
+            merged.push_back(range.first);
+            merged.push_back(range.second);
+        }
+    }
+    return merged;
+}
+
+// Complement of sorted, merged index ranges within [0,size)
+std::vector<gidx_t> complement_ranges(const std::vector<gidx_t>& merged, gidx_t size) {
+    std::vector<gidx_t> complement;
+    gidx_t begin = 0;
+    for (size_t r = 0; r < merged.size(); r += 2) {
+        if (merged[r] > begin) {
+            complement.push_back(begin);
+            complement.push_back(merged[r]);
+        }
+        begin = merged[r + 1];
+    }
+    if (begin < size) {
+        complement.push_back(begin);
+        complement.push_back(size);
+    }
+    return complement;
+}
+
+// Index ranges of target grid points contained in the polygon, with longitudes normalised from west.
+// For StructuredGrid targets with lonlat projections, only the points within the bounding box of the polygon
+// are tested: rows are selected by latitude, and columns by bisection on the (increasing) longitudes.
+std::vector<gidx_t> contained_ranges(const Grid& grid, const Projection& projection, const util::PolygonXY& poly,
+                                     double west) {
+    auto contains = [&](PointLonLat P) {
+        projection.lonlat2xy(P);
+        P.normalise(west);
+        return poly.contains(P);
+    };
+
+    StructuredGrid structured(grid);
+    bool prune = structured && projection.type() == "lonlat" && grid.projection().type() == "lonlat";
+
+    if (prune) {
+        constexpr double eps = 1.e-10;  // tolerance used in PolygonXY::contains
+        const double xmin    = poly.coordinatesMin().x() - eps;
+        const double xmax    = poly.coordinatesMax().x() + eps;
+        const double ymin    = poly.coordinatesMin().y() - eps;
+        const double ymax    = poly.coordinatesMax().y() + eps;
+
+        const idx_t ny = structured.ny();
+        std::vector<std::vector<gidx_t>> row_ranges(ny);
+        atlas_omp_parallel_for (idx_t j = 0; j < ny; ++j) {
+            const double y = structured.y(j);
+            const idx_t nx = structured.nx(j);
+            if (y < ymin || y > ymax || nx == 0) {
+                continue;
+            }
+
+            // Index ranges [ibegin,iend) of candidate columns, one for each shift of longitudes by 360 degrees
+            std::vector<std::pair<idx_t, idx_t>> columns;
+            if (structured.x(0, j) <= structured.x(nx - 1, j)) {
+                auto first_not_less = [&](double x) {
+                    idx_t lo = 0, hi = nx;
+                    while (lo < hi) {
+                        idx_t mid = lo + (hi - lo) / 2;
+                        if (structured.x(mid, j) < x) {
+                            lo = mid + 1;
+                        }
+                        else {
+                            hi = mid;
+                        }
+                    }
+                    return lo;
+                };
+                auto first_greater = [&](double x) {
+                    idx_t lo = 0, hi = nx;
+                    while (lo < hi) {
+                        idx_t mid = lo + (hi - lo) / 2;
+                        if (structured.x(mid, j) <= x) {
+                            lo = mid + 1;
+                        }
+                        else {
+                            hi = mid;
+                        }
+                    }
+                    return lo;
+                };
+                for (int k = -2; k <= 2; ++k) {
+                    const double shift = 360. * k;
+                    const double lo    = std::max(xmin, west - eps) - shift;
+                    const double hi    = std::min(xmax, west + 360. + eps) - shift;
+                    if (lo <= hi) {
+                        idx_t ibegin = first_not_less(lo);
+                        idx_t iend   = first_greater(hi);
+                        if (ibegin < iend) {
+                            columns.emplace_back(ibegin, iend);
+                        }
+                    }
+                }
+                std::sort(columns.begin(), columns.end());
+            }
+            else {
+                columns.emplace_back(0, nx);
+            }
+
+            auto& ranges = row_ranges[j];
+            idx_t inext  = 0;
+            for (const auto& column : columns) {
+                for (idx_t i = std::max(column.first, inext); i < column.second; ++i) {
+                    if (contains(structured.lonlat(i, j))) {
+                        append_index(ranges, structured.index(i, j));
+                    }
+                }
+                inext = std::max(inext, column.second);
+            }
+        }
+
+        std::vector<gidx_t> ranges;
+        for (idx_t j = 0; j < ny; ++j) {
+            for (gidx_t n : row_ranges[j]) {
+                ranges.push_back(n);
+            }
+        }
+        return merge_ranges(ranges);
+    }
+
+    const idx_t nb_chunks = atlas_omp_get_max_threads();
+    std::vector<std::vector<gidx_t>> chunk_ranges(nb_chunks);
+    atlas_omp_parallel_for (idx_t chunk = 0; chunk < nb_chunks; ++chunk) {
+        const gidx_t begin = static_cast<gidx_t>(chunk * size_t(grid.size()) / nb_chunks);
+        const gidx_t end   = static_cast<gidx_t>((chunk + 1) * size_t(grid.size()) / nb_chunks);
+        auto it            = grid.lonlat().begin() + begin;
+        for (gidx_t n = begin; n < end; ++n, ++it) {
+            if (contains(*it)) {
+                append_index(chunk_ranges[chunk], n);
+            }
+        }
+    }
+    std::vector<gidx_t> ranges;
+    for (const auto& chunk : chunk_ranges) {
+        ranges.insert(ranges.end(), chunk.begin(), chunk.end());
+    }
+    return merge_ranges(ranges);
+}
+
+// Index ranges of target grid points within given index ranges which are contained in the polygon
+std::vector<gidx_t> contained_ranges(const Grid& grid, const Projection& projection, const util::PolygonXY& poly,
+                                     double west, const std::vector<gidx_t>& subset) {
+    std::vector<gidx_t> ranges;
+    for (size_t r = 0; r < subset.size(); r += 2) {
+        auto it = grid.lonlat().begin() + subset[r];
+        for (gidx_t n = subset[r]; n < subset[r + 1]; ++n, ++it) {
+            PointLonLat P = *it;
+            projection.lonlat2xy(P);
+            P.normalise(west);
+            if (poly.contains(P)) {
+                append_index(ranges, n);
+            }
+        }
+    }
+    return ranges;
 }
 
+std::vector<std::vector<gidx_t>> gather_ranges(const mpi::Comm& comm, const std::vector<gidx_t>& ranges) {
+    eckit::mpi::Buffer<gidx_t> buffer(comm.size());
+    ATLAS_TRACE_MPI(ALLGATHER) { comm.allGatherv(ranges.begin(), ranges.end(), buffer); }
+    std::vector<std::vector<gidx_t>> gathered(comm.size());
+    for (size_t p = 0; p < comm.size(); ++p) {
+        gathered[p].assign(buffer.buffer.begin() + buffer.displs[p],
+                           buffer.buffer.begin() + buffer.displs[p] + buffer.counts[p]);
+    }
+    return gathered;
+}
+
+// Ranges [begin[r],begin[r+1]) assigned to partition[r], covering [0,size) when no points are unassigned.
+// Points contained in several partitions are assigned to the highest partition, as with partition(grid, part[]).
+void resolve_ranges(const std::vector<std::vector<gidx_t>>& partitions, std::vector<gidx_t>& begin,
+                    std::vector<int>& partition) {
+    // Sweep over range boundaries, keeping track of the partitions containing the current point
+    std::vector<std::pair<gidx_t, int>> events;  // {index, +(p+1)} opens, {index, -(p+1)} closes a range of p
+    for (size_t p = 0; p < partitions.size(); ++p) {
+        for (size_t r = 0; r < partitions[p].size(); r += 2) {
+            events.emplace_back(partitions[p][r], int(p) + 1);
+            events.emplace_back(partitions[p][r + 1], -int(p) - 1);
+        }
+    }
+    std::sort(events.begin(), events.end());
+
+    std::multiset<int> active;
+    for (size_t e = 0; e < events.size();) {
+        const gidx_t n = events[e].first;
+        for (; e < events.size() && events[e].first == n; ++e) {
+            if (events[e].second > 0) {
+                active.insert(events[e].second - 1);
+            }
+            else {
+                active.erase(active.find(-events[e].second - 1));
+            }
+        }
+        if (active.empty() || e == events.size()) {
+            continue;
+        }
+        const int p = *active.rbegin();
+        if (partition.empty() || partition.back() != p) {
+            begin.emplace_back(n);
+            partition.emplace_back(p);
+        }
+    }
+}
+
+}  // namespace
+
 MatchingMeshPartitionerLonLatPolygon::MatchingMeshPartitionerLonLatPolygon(const Mesh& mesh, const eckit::Parametrisation& config):
     MatchingMeshPartitioner(mesh, config) {
         config.get("fallback_nearest", fallback_nearest_);
+        config.get("scalable", scalable_);
+    }
+
+
+MatchingMeshPartitionerLonLatPolygon::Ranges MatchingMeshPartitionerLonLatPolygon::partition_ranges(
+    const Grid& grid) const {
+    const auto& comm = mpi::comm(prePartitionedMesh_.mpi_comm());
+
+    ATLAS_TRACE("MatchingMeshPartitionerLonLatPolygon::partition_ranges");
+
+    ATLAS_ASSERT(grid.domain().global());
+
+    const util::PolygonXY poly{prePartitionedMesh_.polygon(0)};
+
+    double west = poly.coordinatesMin().x();
+    double east = poly.coordinatesMax().x();
+    ATLAS_TRACE_MPI(ALLREDUCE) {
+      comm.allReduceInPlace(west, eckit::mpi::Operation::MIN);
+      comm.allReduceInPlace(east, eckit::mpi::Operation::MAX);
+    }
+
+    Projection projection = prePartitionedMesh_.projection();
+
+    Ranges ranges;
+    ranges.partitions = gather_ranges(comm, contained_ranges(grid, projection, poly, east - 360.));
+
+    auto compute_unassigned = [&]() {
+        std::vector<gidx_t> all;
+        for (const auto& partition : ranges.partitions) {
+            all.insert(all.end(), partition.begin(), partition.end());
+        }
+        ranges.unassigned = complement_ranges(merge_ranges(all), grid.size());
+    };
+    compute_unassigned();
+
+    constexpr double eps = 1.e-10;
+    if (not ranges.unassigned.empty() && east - west > 360. + eps) {
+        auto second_try = gather_ranges(comm, contained_ranges(grid, projection, poly, west - eps, ranges.unassigned));
+        for (size_t p = 0; p < second_try.size(); ++p) {
+            auto& partition = ranges.partitions[p];
+            partition.insert(partition.end(), second_try[p].begin(), second_try[p].end());
+            partition = merge_ranges(partition);
+        }
+        compute_unassigned();
+    }
+    return ranges;
+}
+
+
+void MatchingMeshPartitionerLonLatPolygon::partition_scalable(const Grid& grid, int partitioning[]) const {
+    ATLAS_TRACE("MatchingMeshPartitionerLonLatPolygon::partition_scalable");
+
+    Ranges ranges = partition_ranges(grid);
+
+    omp::fill(partitioning, partitioning + grid.size(), -1);
+    // Points contained in several partitions are assigned to the highest partition
+    for (size_t p = 0; p < ranges.partitions.size(); ++p) {
+        const auto& partition = ranges.partitions[p];
+        for (size_t r = 0; r < partition.size(); r += 2) {
+            std::fill(partitioning + partition[r], partitioning + partition[r + 1], int(p));
+        }
+    }
+
+    if (not ranges.unassigned.empty()) {
+        handle_failures(grid, partitioning, fallback_nearest_,
+                        "Tried testing only target grid points within bounding boxes of partition polygons\n");
+    }
+}
+
+
+std::vector<gidx_t> MatchingMeshPartitionerLonLatPolygon::partition_local(const Grid& grid) const {
+    ATLAS_TRACE("MatchingMeshPartitionerLonLatPolygon::partition_local");
+
+    const int mpi_rank = int(mpi::comm(prePartitionedMesh_.mpi_comm()).rank());
+
+    Ranges ranges = partition_ranges(grid);
+
+    std::vector<gidx_t> local;
+    if (not ranges.unassigned.empty()) {
+        // Requires a global partitioning to find nearest partitions, or to report failures
+        std::vector<int> partitioning(grid.size());
+        partition_scalable(grid, partitioning.data());
+        for (gidx_t n = 0; n < grid.size(); ++n) {
+            if (partitioning[n] == mpi_rank) {
+                local.push_back(n);
+            }
+        }
+        return local;
+    }
+
+    // Remove points which are also contained in higher partitions
+    std::vector<gidx_t> higher;
+    for (size_t p = mpi_rank + 1; p < ranges.partitions.size(); ++p) {
+        higher.insert(higher.end(), ranges.partitions[p].begin(), ranges.partitions[p].end());
+    }
+    higher = merge_ranges(higher);
+
+    const auto& mine = ranges.partitions[mpi_rank];
+    size_t h         = 0;
+    for (size_t r = 0; r < mine.size(); r += 2) {
+        for (gidx_t n = mine[r]; n < mine[r + 1]; ++n) {
+            while (h < higher.size() && higher[h + 1] <= n) {
+                h += 2;
+            }
+            if (h < higher.size() && higher[h] <= n) {
+                continue;
+            }
+            local.push_back(n);
+        }
+    }
+    return local;
+}
+
+
+Distribution MatchingMeshPartitionerLonLatPolygon::partition(const Grid& grid) const {
+    if (not scalable_) {
+        return Partitioner::partition(grid);
     }
 
+    ATLAS_TRACE("MatchingMeshPartitionerLonLatPolygon::partition");
+
+    Ranges ranges = partition_ranges(grid);
+
+    if (not ranges.unassigned.empty()) {
+        if (fallback_nearest_) {
+            // Searching nearest partitions requires the global partitioning
+            return Partitioner::partition(grid);
+        }
+        std::vector<size_t> failed_index;
+        std::vector<PointLonLat> failed_lonlat;
+        for (size_t r = 0; r < ranges.unassigned.size(); r += 2) {
+            auto it = grid.lonlat().begin() + ranges.unassigned[r];
+            for (gidx_t n = ranges.unassigned[r]; n < ranges.unassigned[r + 1]; ++n, ++it) {
+                failed_index.emplace_back(n);
+                failed_lonlat.emplace_back(*it);
+            }
+        }
+        throw_failures(failed_index, failed_lonlat,
+                       "Tried testing only target grid points within bounding boxes of partition polygons\n");
+    }
+
+    std::vector<gidx_t> range_begin;
+    std::vector<int> range_part;
+    resolve_ranges(ranges.partitions, range_begin, range_part);
+    return Distribution{new distribution::DistributionRanges{int(ranges.partitions.size()), grid.size(),
+                                                             std::move(range_begin), std::move(range_part), type()}};
+}
+
 
 void MatchingMeshPartitionerLonLatPolygon::partition(const Grid& grid, int partitioning[]) const {
+    if (scalable_) {
+        partition_scalable(grid, partitioning);
+        return;
+    }
+
     const auto& comm   = mpi::comm(prePartitionedMesh_.mpi_comm());
     const int mpi_rank = int(comm.rank());
     const int mpi_size = int(comm.size());
@@ -133,55 +578,13 @@ void MatchingMeshPartitionerLonLatPolygon::partition(const Grid& grid, int parti
     }();
 
     if (min < 0) {
-        size_t i            = 0;
-        size_t max_failures = grid.size();
-        std::vector<size_t> failed_index;
-        std::vector<PointLonLat> failed_lonlat;
-        failed_index.reserve(max_failures);
-        failed_lonlat.reserve(max_failures);
-        for (PointLonLat P : grid.lonlat()) {
-            if (partitioning[i] < 0) {
-                failed_index.emplace_back(i);
-                failed_lonlat.emplace_back(P);
-            }
-            ++i;
-        }
-        size_t nb_failures = failed_index.size();
-
-        if (fallback_nearest_) {
-            util::IndexKDTree3D kdtree;
-            kdtree.reserve(grid.size());
-            size_t j=0;
-            for (auto& p: grid.lonlat()) {
-                if (partitioning[j] >= 0) {
-                    kdtree.insert(p,partitioning[j]);
-                }
-                ++j;
-            }
-            kdtree.build();
-            for (size_t n = 0; n < nb_failures; ++n) {
-                auto closest = kdtree.closestPoint(failed_lonlat[n]);
-                partitioning[failed_index[n]] = closest.payload();
-            }
-        }
-        else {
-            std::stringstream err;
-            err.precision(20);
-            err << "Could not find partition of " << nb_failures
-                << " target grid points (source mesh does not contain all target grid points)\n"
-                << "Tried first normalizing coordinates with west=" << east - 360. << "\n";
-            if (second_try) {
-                err << "Tried second time normalizing coordinates with west=" << west - eps << "\n";
-            }
-
-            err << "Failed target grid points with global index:\n";
-            for (size_t n = 0; n < nb_failures; ++n) {
-                err << "  - " << std::setw(10) << std::left << failed_index[n] + 1 << " {lon,lat} : " << failed_lonlat[n]
-                    << "\n";
-            }
-            // prePartitionedMesh_.polygon(0).outputPythonScript("partitions.py");
-            throw_Exception(err.str(), Here());
+        std::stringstream tries;
+        tries.precision(20);
+        tries << "Tried first normalizing coordinates with west=" << east - 360. << "\n";
+        if (second_try) {
+            tries << "Tried second time normalizing coordinates with west=" << west - eps << "\n";
         }
+        handle_failures(grid, partitioning, fallback_nearest_, tries.str());
     }
 }
 
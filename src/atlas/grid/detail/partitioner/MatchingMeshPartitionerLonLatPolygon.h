@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "atlas/grid/detail/partitioner/MatchingMeshPartitioner.h"
 
 namespace atlas {
@@ -43,10 +45,39 @@ public:
    */
     void partition(const Grid& grid, int partitioning[]) const;
 
+    /**
+   * @brief Partition a grid, using the same partitions from a pre-partitioned mesh.
+   * With the "scalable" option the distribution is stored as ranges of global indices, computed from the
+   * gathered ranges of each partition without a global partitioning array.
+   * @param[in] grid grid to be partitioned
+   * @return distribution of the grid
+   */
+    Distribution partition(const Grid& grid) const override;
+
+    /**
+   * @brief Partition a grid without constructing a global partitioning array.
+   * Only target grid points within the bounding box of this task's partition polygon are tested.
+   * Points contained in several partitions are assigned to the highest partition, as in partition().
+   * @param[in] grid grid to be partitioned
+   * @return sorted global indices (0-based) of the target grid points assigned to this task
+   */
+    std::vector<gidx_t> partition_local(const Grid& grid) const;
+
     virtual std::string type() const { return static_type(); }
 
+private:
+    void partition_scalable(const Grid& grid, int partitioning[]) const;
+
+    /// Index ranges [begin,end) of target grid points assigned to each partition, and of unassigned points
+    struct Ranges {
+        std::vector<std::vector<gidx_t>> partitions;
+        std::vector<gidx_t> unassigned;
+    };
+    Ranges partition_ranges(const Grid& grid) const;
+
 private:
     bool fallback_nearest_{false};
+    bool scalable_{false};
 };
 
 }  // namespace partitioner
@@ -26,6 +26,8 @@
 #include "atlas/grid/detail/partitioner/CubedSpherePartitioner.h"
 #include "atlas/grid/detail/partitioner/EqualBandsPartitioner.h"
 #include "atlas/grid/detail/partitioner/EqualRegionsPartitioner.h"
+#include "atlas/grid/detail/partitioner/GraphPartitioner.h"
+#include "atlas/grid/detail/partitioner/HilbertPartitioner.h"
 #include "atlas/grid/detail/partitioner/MatchingFunctionSpacePartitionerLonLatPolygon.h"
 #include "atlas/grid/detail/partitioner/MatchingMeshPartitioner.h"
 #include "atlas/grid/detail/partitioner/MatchingMeshPartitionerBruteForce.h"
@@ -126,6 +128,8 @@ struct force_link {
         load_builder<CubedSpherePartitioner>();
         load_builder<BandsPartitioner>();
         load_builder<EqualBandsPartitioner>();
+        load_builder<GraphPartitioner>();
+        load_builder<HilbertPartitioner>();
         load_builder<RegularBandsPartitioner>();
         load_builder<SerialPartitioner>();
 #if ATLAS_HAVE_TRANS
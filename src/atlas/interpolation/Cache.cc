@@ -10,6 +10,7 @@
 
 #include "atlas/interpolation/Cache.h"
 #include "atlas/interpolation/Interpolation.h"
+#include "atlas/runtime/trace/Memory.h"
 namespace atlas {
 namespace interpolation {
 
@@ -55,10 +56,16 @@ class MatrixCacheEntryOwned : public MatrixCacheEntry {
 public:
     MatrixCacheEntryOwned(Matrix&& matrix): MatrixCacheEntry(&matrix_) {
         const_cast<Matrix&>(matrix_).swap(reinterpret_cast<Matrix&>(matrix));
+        footprint_ = matrix_.footprint();
+        runtime::trace::Memory::owner("Interpolation cache", static_type()).allocate(footprint_);
+    }
+    ~MatrixCacheEntryOwned() override {
+        runtime::trace::Memory::owner("Interpolation cache", static_type()).deallocate(footprint_);
     }
 
 private:
     const Matrix matrix_;
+    size_t footprint_;
 };
 
 class MatrixCacheEntryShared : public MatrixCacheEntry {
@@ -109,7 +116,15 @@ MatrixCache::MatrixCache(std::shared_ptr<InterpolationCacheEntry> entry):
     Cache(entry), matrix_{dynamic_cast<const MatrixCacheEntry*>(entry.get())} {}
 
 
-IndexKDTreeCacheEntry::~IndexKDTreeCacheEntry() = default;
+IndexKDTreeCacheEntry::IndexKDTreeCacheEntry(const IndexKDTree& tree):
+    tree_{tree}, footprint_{tree ? tree.footprint() : 0} {
+    ATLAS_ASSERT(tree_);
+    runtime::trace::Memory::owner("Interpolation cache", static_type()).allocate(footprint_);
+}
+
+IndexKDTreeCacheEntry::~IndexKDTreeCacheEntry() {
+    runtime::trace::Memory::owner("Interpolation cache", static_type()).deallocate(footprint_);
+}
 
 const IndexKDTreeCacheEntry::IndexKDTree& IndexKDTreeCacheEntry::tree() const {
     ATLAS_ASSERT(tree_);
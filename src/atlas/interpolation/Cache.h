@@ -127,16 +127,17 @@ private:
 class IndexKDTreeCacheEntry : public InterpolationCacheEntry {
 public:
     using IndexKDTree = util::IndexKDTree;
-    IndexKDTreeCacheEntry(const IndexKDTree& tree): tree_{tree} { ATLAS_ASSERT(tree_); }
+    IndexKDTreeCacheEntry(const IndexKDTree& tree);
     virtual ~IndexKDTreeCacheEntry() override;
     const IndexKDTree& tree() const;
-    size_t footprint() const override { return tree().footprint(); }
+    size_t footprint() const override { return footprint_; }
     operator bool() const { return bool(tree_); }
     static std::string static_type() { return "IndexKDTree"; }
     std::string type() const override { return static_type(); }
 
 private:
     const IndexKDTree tree_;
+    const size_t footprint_;
 };
 
 class IndexKDTreeCache final : public Cache {
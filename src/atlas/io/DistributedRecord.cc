@@ -0,0 +1,268 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "DistributedRecord.h"
+
+#include <cstring>  // memcpy
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/array/Array.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/functionspace/FunctionSpace.h"
+#include "atlas/io/atlas-io.h"
+#include "atlas/parallel/mpi/Statistics.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace io {
+
+namespace {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+std::string segment_path(const std::string& path, size_t part) {
+    return path + ".part" + std::to_string(part);
+}
+
+std::string global_index_key(int space) {
+    return "global_index_" + std::to_string(space);
+}
+
+std::string space_key(const std::string& name) {
+    return "space_" + name;
+}
+
+// Errors raised on some tasks only must be agreed upon before the next collective operation, otherwise the other
+// tasks would wait forever in it. Throws on all tasks when any task reported an error.
+void agree_on_error(const mpi::Comm& comm, const std::string& error, const std::string& context) {
+    int failed = error.empty() ? 0 : 1;
+    ATLAS_TRACE_MPI(ALLREDUCE) { comm.allReduceInPlace(failed, eckit::mpi::max()); }
+    if (failed) {
+        throw_Exception(error.empty() ? context + " failed on another task" : error, Here());
+    }
+}
+
+size_t bytes_per_point(const Field& field) {
+    size_t bytes = size_t(field.datatype().size());
+    for (idx_t j = 1; j < field.rank(); ++j) {
+        bytes *= size_t(field.shape(j));
+    }
+    return bytes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void DistributedRecordWriter::set(const Field& field) {
+    if (field.name().empty() || field.name().find('.') != std::string::npos) {
+        throw_Exception("Field name \"" + field.name() + "\" is not valid as record key", Here());
+    }
+    ATLAS_ASSERT(field.array().contiguous());
+    fields_.emplace_back(field);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void DistributedRecordWriter::write(const eckit::PathName& path) const {
+    ATLAS_TRACE("DistributedRecordWriter::write");
+    ATLAS_ASSERT(not fields_.empty());
+
+    const auto& comm = mpi::comm(fields_.front().functionspace().mpi_comm());
+
+    // Global indices are written once per function space
+    std::vector<FunctionSpace> spaces;
+    std::vector<int> field_space;
+    for (const auto& field : fields_) {
+        ATLAS_ASSERT(field.functionspace().mpi_comm() == fields_.front().functionspace().mpi_comm());
+        int space = 0;
+        while (space < int(spaces.size()) && spaces[space].get() != field.functionspace().get()) {
+            ++space;
+        }
+        if (space == int(spaces.size())) {
+            spaces.emplace_back(field.functionspace());
+        }
+        field_space.emplace_back(space);
+    }
+
+    std::vector<std::vector<idx_t>> owned(spaces.size());
+    std::vector<std::vector<gidx_t>> owned_global_index(spaces.size());
+    std::vector<std::unique_ptr<array::Array>> owned_values;
+
+    io::RecordWriter segment;
+    for (size_t s = 0; s < spaces.size(); ++s) {
+        const auto ghost        = array::make_view<int, 1>(spaces[s].ghost());
+        const auto global_index = array::make_view<gidx_t, 1>(spaces[s].global_index());
+        for (idx_t j = 0; j < spaces[s].size(); ++j) {
+            if (not ghost(j)) {
+                owned[s].emplace_back(j);
+                owned_global_index[s].emplace_back(global_index(j));
+            }
+        }
+        segment.set(global_index_key(int(s)), io::ref(owned_global_index[s]));
+    }
+    for (size_t f = 0; f < fields_.size(); ++f) {
+        const auto& field  = fields_[f];
+        const auto& points = owned[field_space[f]];
+        const size_t bytes = bytes_per_point(field);
+
+        array::ArrayShape shape = field.shape();
+        shape[0]                = idx_t(points.size());
+        owned_values.emplace_back(array::Array::create(field.datatype(), shape));
+
+        const char* src = static_cast<const char*>(field.array().data());
+        char* dst       = static_cast<char*>(owned_values.back()->data());
+        for (size_t i = 0; i < points.size(); ++i) {
+            std::memcpy(dst + i * bytes, src + size_t(points[i]) * bytes, bytes);
+        }
+        segment.set(field.name(), io::ref(*owned_values.back()));
+    }
+    segment.write(segment_path(path.asString(), comm.rank()));
+
+    if (comm.rank() == 0) {
+        io::RecordWriter record;
+        record.set("nb_parts", size_t(comm.size()));
+        for (size_t f = 0; f < fields_.size(); ++f) {
+            record.set(space_key(fields_[f].name()), field_space[f]);
+        }
+        record.write(path);
+    }
+
+    // Record is complete on return
+    ATLAS_TRACE_MPI(BARRIER) { comm.barrier(); }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+DistributedRecordReader::DistributedRecordReader(const eckit::PathName& path): path_(path.asString()) {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void DistributedRecordReader::read(const std::string& name, Field& field) const {
+    ATLAS_TRACE("DistributedRecordReader::read(" + name + ")");
+    ATLAS_ASSERT(field.array().contiguous());
+
+    const auto& fs        = field.functionspace();
+    const auto& comm      = mpi::comm(fs.mpi_comm());
+    const size_t nb_tasks = comm.size();
+    const size_t bytes    = bytes_per_point(field);
+
+    // Points are assigned to "directory" tasks by global index, where values read and values requested meet
+    auto directory = [nb_tasks](gidx_t g) { return size_t(g) % nb_tasks; };
+
+    // 1. Read segments round-robin, and send the values to the directory tasks
+    std::vector<std::vector<gidx_t>> send_global_index(nb_tasks);
+    std::vector<std::vector<char>> send_values(nb_tasks);
+    std::string error;
+    try {
+        size_t nb_parts;
+        int space;
+        {
+            io::RecordReader record(path_);
+            record.read("nb_parts", nb_parts);
+            record.read(space_key(name), space);
+            record.wait();
+        }
+        for (size_t part = comm.rank(); part < nb_parts; part += nb_tasks) {
+            std::vector<gidx_t> global_index;
+            array::ArrayShape shape = field.shape();
+            shape[0]                = 0;
+            std::unique_ptr<array::Array> values(array::Array::create(field.datatype(), shape));
+
+            io::RecordReader segment(segment_path(path_, part));
+            segment.read(global_index_key(space), global_index);
+            segment.read(name, *values);
+            segment.wait();
+
+            if (size_t(values->size()) * size_t(field.datatype().size()) != global_index.size() * bytes) {
+                error = "Shape of " + name + " in " + segment_path(path_, part) + " does not match Field";
+                break;
+            }
+            const char* v = static_cast<const char*>(values->data());
+            for (size_t i = 0; i < global_index.size(); ++i) {
+                auto& values_to = send_values[directory(global_index[i])];
+                send_global_index[directory(global_index[i])].emplace_back(global_index[i]);
+                values_to.insert(values_to.end(), v + i * bytes, v + (i + 1) * bytes);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        error = e.what();
+    }
+    agree_on_error(comm, error, "Reading " + name + " from " + path_);
+    std::vector<std::vector<gidx_t>> recv_global_index(nb_tasks);
+    std::vector<std::vector<char>> recv_values(nb_tasks);
+    ATLAS_TRACE_MPI(ALLTOALL) {
+        comm.allToAll(send_global_index, recv_global_index);
+        comm.allToAll(send_values, recv_values);
+    }
+    std::unordered_map<gidx_t, const char*> lookup;
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        for (size_t i = 0; i < recv_global_index[t].size(); ++i) {
+            lookup[recv_global_index[t][i]] = recv_values[t].data() + i * bytes;
+        }
+    }
+
+    // 2. Request the values of owned points from the directory tasks
+    std::vector<std::vector<gidx_t>> send_requests(nb_tasks);
+    std::vector<std::vector<idx_t>> requested(nb_tasks);
+    {
+        const auto ghost        = array::make_view<int, 1>(fs.ghost());
+        const auto global_index = array::make_view<gidx_t, 1>(fs.global_index());
+        for (idx_t j = 0; j < fs.size(); ++j) {
+            if (not ghost(j)) {
+                send_requests[directory(global_index(j))].emplace_back(global_index(j));
+                requested[directory(global_index(j))].emplace_back(j);
+            }
+        }
+    }
+    std::vector<std::vector<gidx_t>> recv_requests(nb_tasks);
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send_requests, recv_requests); }
+
+    std::vector<std::vector<char>> send_reply(nb_tasks);
+    for (size_t t = 0; t < nb_tasks && error.empty(); ++t) {
+        send_reply[t].reserve(recv_requests[t].size() * bytes);
+        for (gidx_t g : recv_requests[t]) {
+            auto found = lookup.find(g);
+            if (found == lookup.end()) {
+                error = "Global index " + std::to_string(g) + " of " + name + " not found in " + path_;
+                break;
+            }
+            send_reply[t].insert(send_reply[t].end(), found->second, found->second + bytes);
+        }
+    }
+    agree_on_error(comm, error, "Reading " + name + " from " + path_);
+    std::vector<std::vector<char>> recv_reply(nb_tasks);
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send_reply, recv_reply); }
+
+    char* dst = static_cast<char*>(field.array().data());
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        for (size_t i = 0; i < requested[t].size(); ++i) {
+            std::memcpy(dst + size_t(requested[t][i]) * bytes, recv_reply[t].data() + i * bytes, bytes);
+        }
+    }
+
+    field.set_dirty();
+    field.haloExchange();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
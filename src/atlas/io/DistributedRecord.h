@@ -0,0 +1,71 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "atlas/field/Field.h"
+
+namespace eckit {
+class PathName;
+}
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @class DistributedRecordWriter
+/// @brief Write distributed Fields collectively, without gathering them on a single MPI task
+///
+/// Each task writes the values of the points it owns (ghost points are skipped), together with their global indices,
+/// to its own segment record "<path>.part<rank>". The task with rank 0 also writes the record "<path>" describing the
+/// segments. Memory use and time on any task therefore scale with the size of its partition only.
+class DistributedRecordWriter {
+public:
+    /// @brief Add field, keyed by its name
+    void set(const Field&);
+
+    /// @brief Write record and segments, collective over the MPI communicator of the fields
+    void write(const eckit::PathName&) const;
+
+private:
+    std::vector<Field> fields_;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @class DistributedRecordReader
+/// @brief Read Fields written by DistributedRecordWriter collectively
+///
+/// The target Field may be distributed differently, and over a different number of tasks, than at the time of writing.
+/// Segments are read round-robin by the tasks, values are sent to the tasks owning them by global index, and the
+/// halo is exchanged.
+class DistributedRecordReader {
+public:
+    DistributedRecordReader(const eckit::PathName&);
+
+    /// @brief Read field with given name, collective over the MPI communicator of the Field
+    /// If reading fails on any task (missing or inconsistent segments), an exception is thrown on all tasks.
+    void read(const std::string& name, Field&) const;
+
+    /// @brief Read field with the name of the given Field
+    void read(Field& field) const { read(field.name(), field); }
+
+private:
+    std::string path_;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -159,6 +159,7 @@ Library::Library():
     trace_memory_(getEnv("ATLAS_TRACE_MEMORY", false)),
     trace_barriers_(getEnv("ATLAS_TRACE_BARRIERS", false)),
     trace_report_(getEnv("ATLAS_TRACE_REPORT", false)),
+    init_first_touch_(getEnv("ATLAS_INIT_FIRST_TOUCH", false)),
     atlas_io_trace_hook_(::atlas::io::TraceHookRegistry::invalidId()) {
     std::string ATLAS_PLUGIN_PATH = getEnv("ATLAS_PLUGIN_PATH");
 #if ATLAS_ECKIT_VERSION_AT_LEAST(1, 24, 4)
@@ -234,6 +235,14 @@ std::string atlas::Library::linalgDenseBackend() const {
     return ATLAS_LINALG_DENSE_BACKEND;
 }
 
+std::string atlas::Library::memoryResource() const {
+    auto resource = []() -> std::string {
+        return eckit::LibResource<std::string, Library>("atlas-memory-resource;$ATLAS_MEMORY_RESOURCE", "system");
+    };
+    static std::string ATLAS_MEMORY_RESOURCE = resource();
+    return ATLAS_MEMORY_RESOURCE;
+}
+
 
 Library& Library::instance() {
     return libatlas;
@@ -290,6 +299,9 @@ void Library::initialise(const eckit::Parametrisation& config) {
         config.get("trace.report", trace_report_);
         config.get("trace.memory", trace_memory_);
     }
+    if (config.has("init")) {
+        config.get("init.first_touch", init_first_touch_);
+    }
 
     if (not debug_) {
         debug_channel_.reset();
@@ -348,6 +360,8 @@ void Library::initialise(const eckit::Parametrisation& config) {
         out << "  trace.barriers  [" << str(traceBarriers()) << "] \n";
         out << "  trace.report    [" << str(trace_report_) << "] \n";
         out << "  trace.memory    [" << str(trace_memory_) << "] \n";
+        out << "  memory.resource [" << memoryResource() << "] \n";
+        out << "  init.first_touch[" << str(init_first_touch_) << "] \n";
         out << " \n";
         out << atlas::Library::instance().information();
         out << std::flush;
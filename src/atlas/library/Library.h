@@ -71,6 +71,7 @@ public:
 
     bool traceBarriers() const { return trace_barriers_; }
     bool traceMemory() const { return trace_memory_; }
+    bool initFirstTouch() const { return init_first_touch_; }
 
     Library();
 
@@ -84,6 +85,8 @@ public:
     std::string linalgDenseBackend() const;
     std::string linalgSparseBackend() const;
 
+    std::string memoryResource() const;
+
     void registerDataPath(const std::string&);
 
 protected:
@@ -97,6 +100,7 @@ protected:
     bool trace_memory_{false};
     bool trace_barriers_{false};
     bool trace_report_{false};
+    bool init_first_touch_{false};
     mutable std::unique_ptr<eckit::Channel> info_channel_;
     mutable std::unique_ptr<eckit::Channel> warning_channel_;
     mutable std::unique_ptr<eckit::Channel> trace_channel_;
@@ -25,6 +25,28 @@ namespace linalg {
 using Matrix        = eckit::linalg::Matrix;
 using Configuration = eckit::Configuration;
 
+/// @brief Non-owning single precision matrix wrapper
+///
+/// Follows the column-major storage convention of eckit::linalg::Matrix, which only supports double precision.
+class MatrixFloat {
+public:
+    using Scalar = float;
+    using Size   = size_t;
+
+    MatrixFloat(Scalar* data, Size rows, Size cols): data_(data), rows_(rows), cols_(cols) {}
+
+    Size rows() const { return rows_; }
+    Size cols() const { return cols_; }
+    Size size() const { return rows_ * cols_; }
+    Scalar* data() { return data_; }
+    const Scalar* data() const { return data_; }
+
+private:
+    Scalar* data_;
+    Size rows_;
+    Size cols_;
+};
+
 // C = A . B
 template <typename Matrix>
 void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C);
@@ -32,6 +54,13 @@ void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C);
 template <typename Matrix>
 void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C, const eckit::Configuration&);
 
+// C = A . B in single precision.
+// eckit::linalg has no single precision backends. For the "mkl" and "lapack" backends sgemm of the same BLAS library
+// is used, and for "eigen" Eigen's GEMM when atlas is built with Eigen. Otherwise an OpenMP implementation within
+// atlas is used.
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C);
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C, const eckit::Configuration&);
+
 class MatrixMultiply {
 public:
     MatrixMultiply() = default;
@@ -0,0 +1,118 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/linalg/dense/MatrixMultiply.h"
+
+#include <algorithm>
+#include <string>
+
+#include "eckit/eckit.h"
+
+#include "atlas/library/config.h"
+#if ATLAS_ECKIT_HAVE_ECKIT_585
+#include "eckit/linalg/LinearAlgebraDense.h"
+#else
+#include "eckit/linalg/LinearAlgebra.h"
+#endif
+
+#if ATLAS_HAVE_EIGEN
+#include <Eigen/Core>
+#endif
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+#if eckit_HAVE_MKL || eckit_HAVE_LAPACK
+// Provided by the BLAS library that the eckit "mkl" and "lapack" backends use for dgemm
+extern "C" {
+void sgemm_(const char* transa, const char* transb, const int* m, const int* n, const int* k, const float* alpha,
+            const float* a, const int* lda, const float* b, const int* ldb, const float* beta, float* c,
+            const int* ldc);
+}
+#endif
+
+namespace atlas {
+namespace linalg {
+
+namespace {
+
+// Name of the eckit linalg backend that the given configuration selects, as in matrix_multiply for double precision
+std::string eckit_linalg_backend(const eckit::Configuration& config) {
+    std::string backend = config.getString("type", dense::current_backend());
+    if (backend == dense::backend::eckit_linalg::type()) {
+        backend = config.getString("backend", "default");
+    }
+    if (backend == "default") {
+#if ATLAS_ECKIT_HAVE_ECKIT_585
+        backend = eckit::linalg::LinearAlgebraDense::backend().name();
+#else
+        backend = eckit::linalg::LinearAlgebra::backend().name();
+#endif
+    }
+    return backend;
+}
+
+}  // namespace
+
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C, const eckit::Configuration& config) {
+    ATLAS_ASSERT(A.cols() == B.rows());
+    ATLAS_ASSERT(A.rows() == C.rows());
+    ATLAS_ASSERT(B.cols() == C.cols());
+
+    const idx_t M = static_cast<idx_t>(A.rows());
+    const idx_t K = static_cast<idx_t>(A.cols());
+    const idx_t N = static_cast<idx_t>(B.cols());
+
+    const float* a = A.data();
+    const float* b = B.data();
+    float* c       = C.data();
+
+    // eckit::linalg only implements double precision, so dispatch to the single precision GEMM of the library
+    // behind the selected eckit backend.
+    const std::string backend = eckit_linalg_backend(config);
+#if eckit_HAVE_MKL || eckit_HAVE_LAPACK
+    if (backend == "mkl" || backend == "lapack") {
+        const int m = M, n = N, k = K;
+        const int lda = std::max(1, m), ldb = std::max(1, k), ldc = std::max(1, m);
+        const float alpha = 1.f, beta = 0.f;
+        sgemm_("N", "N", &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+        return;
+    }
+#endif
+#if ATLAS_HAVE_EIGEN
+    if (backend == "eigen") {
+        using MatrixXf = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+        Eigen::Map<MatrixXf> c_map(c, M, N);
+        c_map.noalias() = Eigen::Map<const MatrixXf>(a, M, K) * Eigen::Map<const MatrixXf>(b, K, N);
+        return;
+    }
+#endif
+
+    // Fallback when the selected backend has no single precision GEMM available to atlas.
+    // Column-major storage: X(i,j) = x[i + rows*j]
+    atlas_omp_parallel_for(idx_t j = 0; j < N; ++j) {
+        float* cj = c + size_t(M) * j;
+        std::fill(cj, cj + M, 0.f);
+        for (idx_t k = 0; k < K; ++k) {
+            const float bkj = b[k + size_t(K) * j];
+            const float* ak = a + size_t(M) * k;
+            for (idx_t i = 0; i < M; ++i) {
+                cj[i] += ak[i] * bkj;
+            }
+        }
+    }
+}
+
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) {
+    matrix_multiply(A, B, C, dense::Backend());
+}
+
+}  // namespace linalg
+}  // namespace atlas
@@ -0,0 +1,188 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/mesh/CompactConnectivity.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "atlas/mesh/Connectivity.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace mesh {
+
+namespace {
+
+template <typename ColsFunctor, typename ValueFunctor>
+struct ConnectivityAccess {
+    ColsFunctor cols;
+    ValueFunctor value;
+};
+
+template <typename ColsFunctor, typename ValueFunctor>
+ConnectivityAccess<ColsFunctor, ValueFunctor> make_access(ColsFunctor cols, ValueFunctor value) {
+    return {cols, value};
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------------------------------
+
+CompactConnectivity::CompactConnectivity(const IrregularConnectivityImpl& connectivity) {
+    rows_          = connectivity.rows();
+    maxcols_       = connectivity.maxcols();
+    missing_value_ = connectivity.missing_value();
+    const idx_t fixed_cols = (rows_ == 0 || connectivity.mincols() == connectivity.maxcols()) ? maxcols_ : -1;
+    compress(make_access([&](idx_t r) { return connectivity.cols(r); },
+                         [&](idx_t r, idx_t c) { return connectivity(r, c); }),
+             fixed_cols);
+}
+
+CompactConnectivity::CompactConnectivity(const BlockConnectivityImpl& connectivity) {
+    rows_          = connectivity.rows();
+    maxcols_       = connectivity.cols();
+    missing_value_ = connectivity.missing_value();
+    compress(make_access([&](idx_t) { return connectivity.cols(); },
+                         [&](idx_t r, idx_t c) { return connectivity(r, c); }),
+             maxcols_);
+}
+
+template <typename Connectivity>
+void CompactConnectivity::compress(const Connectivity& connectivity, idx_t fixed_cols) {
+    fixed_cols_ = fixed_cols;
+    if (fixed_cols_ < 0) {
+        ATLAS_ASSERT(maxcols_ <= std::numeric_limits<uint8_t>::max(),
+                     "CompactConnectivity supports at most 255 columns per row");
+        counts_.resize(rows_);
+        offsets_.resize(rows_);
+    }
+
+    const idx_t nb_chunks = (rows_ + CHUNK - 1) / CHUNK;
+    chunks_.resize(nb_chunks);
+    std::vector<size_t> chunk_size(nb_chunks);
+
+    // Range of values and number of values per chunk
+    std::vector<char> fits(nb_chunks);
+    atlas_omp_parallel_for(idx_t k = 0; k < nb_chunks; ++k) {
+        const idx_t row_end = std::min(rows_, (k + 1) * CHUNK);
+        idx_t lowest        = std::numeric_limits<idx_t>::max();
+        idx_t highest       = std::numeric_limits<idx_t>::min();
+        size_t size         = 0;
+        for (idx_t r = k * CHUNK; r < row_end; ++r) {
+            const idx_t cols = connectivity.cols(r);
+            if (fixed_cols_ < 0) {
+                counts_[r]  = static_cast<uint8_t>(cols);
+                offsets_[r] = static_cast<uint16_t>(size);
+            }
+            for (idx_t c = 0; c < cols; ++c) {
+                const idx_t v = connectivity.value(r, c);
+                if (v != missing_value_) {
+                    lowest  = std::min(lowest, v);
+                    highest = std::max(highest, v);
+                }
+            }
+            size += cols;
+        }
+        if (lowest > highest) {
+            lowest = highest = 0;
+        }
+        // The largest offset of each width is reserved for missing values
+        const long range = long(highest) - long(lowest);
+        chunks_[k].base  = lowest;
+        chunks_[k].wide  = range >= long(std::numeric_limits<uint16_t>::max());
+        chunk_size[k]    = size;
+        fits[k]          = range < long(std::numeric_limits<uint32_t>::max());
+    }
+    ATLAS_ASSERT(std::all_of(fits.begin(), fits.end(), [](char f) { return f; }),
+                 "CompactConnectivity requires the values within each chunk to span less than 2^32-1");
+
+    size_t size16 = 0;
+    size_t size32 = 0;
+    for (idx_t k = 0; k < nb_chunks; ++k) {
+        auto& chunk  = chunks_[k];
+        chunk.offset = chunk.wide ? size32 : size16;
+        (chunk.wide ? size32 : size16) += chunk_size[k];
+    }
+    data16_.resize(size16);
+    data32_.resize(size32);
+
+    // Encode values as offsets from the chunk base, with the largest offset reserved for missing values
+    atlas_omp_parallel_for(idx_t k = 0; k < nb_chunks; ++k) {
+        const Chunk& chunk  = chunks_[k];
+        const idx_t row_end = std::min(rows_, (k + 1) * CHUNK);
+        for (idx_t r = k * CHUNK; r < row_end; ++r) {
+            const size_t begin = chunk.offset + local_offset(r);
+            const idx_t cols   = connectivity.cols(r);
+            for (idx_t c = 0; c < cols; ++c) {
+                const idx_t v = connectivity.value(r, c);
+                if (chunk.wide) {
+                    data32_[begin + c] = (v == missing_value_) ? uint32_t(-1) : static_cast<uint32_t>(v - chunk.base);
+                }
+                else {
+                    data16_[begin + c] = (v == missing_value_) ? uint16_t(-1) : static_cast<uint16_t>(v - chunk.base);
+                }
+            }
+        }
+    }
+}
+
+idx_t CompactConnectivity::decode(idx_t row, idx_t values[]) const {
+    const Row r = this->row(row);
+    for (idx_t c = 0; c < r.size(); ++c) {
+        values[c] = r(c);
+    }
+    return r.size();
+}
+
+void CompactConnectivity::expand(IrregularConnectivityImpl& connectivity) const {
+    if (rows_ == 0) {
+        return;
+    }
+    const idx_t first = connectivity.rows();
+    std::vector<idx_t> cols(rows_);
+    for (idx_t r = 0; r < rows_; ++r) {
+        cols[r] = this->cols(r);
+    }
+    connectivity.add(rows_, cols.data());
+    std::vector<idx_t> values(maxcols_);
+    for (idx_t r = 0; r < rows_; ++r) {
+        decode(r, values.data());
+        connectivity.set(first + r, values.data());
+    }
+}
+
+void CompactConnectivity::expand(BlockConnectivityImpl& connectivity) const {
+    if (rows_ == 0) {
+        return;
+    }
+    ATLAS_ASSERT(fixed_cols_ >= 0, "BlockConnectivity requires the same number of columns for every row");
+    std::vector<idx_t> values(size_t(rows_) * size_t(fixed_cols_));
+    atlas_omp_parallel_for(idx_t r = 0; r < rows_; ++r) {
+        decode(r, values.data() + size_t(r) * size_t(fixed_cols_));
+    }
+    connectivity.add(rows_, fixed_cols_, values.data(), /* fortran_array = */ false);
+}
+
+idx_t CompactConnectivity::wide_chunks() const {
+    return static_cast<idx_t>(std::count_if(chunks_.begin(), chunks_.end(), [](const Chunk& c) { return c.wide; }));
+}
+
+size_t CompactConnectivity::footprint() const {
+    return sizeof(*this) + chunks_.capacity() * sizeof(Chunk) + data16_.capacity() * sizeof(uint16_t) +
+           data32_.capacity() * sizeof(uint32_t) + counts_.capacity() * sizeof(uint8_t) +
+           offsets_.capacity() * sizeof(uint16_t);
+}
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace mesh
+}  // namespace atlas
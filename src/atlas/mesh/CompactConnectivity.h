@@ -0,0 +1,141 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+/// @file CompactConnectivity.h
+/// @details
+/// Read-only connectivity table with compressed storage.
+///
+/// Rows are grouped in chunks of CompactConnectivity::CHUNK rows. Within a chunk, values are stored as
+/// 16-bit offsets from the smallest value in the chunk, or as 32-bit offsets if the values of the chunk
+/// span too large a range. For connectivities of meshes with good locality (see mesh::actions::Reorder)
+/// nearly all chunks use 16-bit offsets. Row sizes are stored in 8 bits, and not at all when every row
+/// has the same number of columns.
+///
+/// Values are decoded on the fly, with base 0, just as the operator(row,col) of the other connectivities.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace mesh {
+
+class IrregularConnectivityImpl;
+class BlockConnectivityImpl;
+
+class CompactConnectivity {
+public:
+    static constexpr idx_t CHUNK = 64;
+
+    /// @brief Accessor to a single row, decoding values on the fly
+    class Row {
+    public:
+        idx_t operator()(idx_t col) const { return wide_ ? decode(data32_[col]) : decode(data16_[col]); }
+        idx_t size() const { return size_; }
+
+    private:
+        friend class CompactConnectivity;
+        Row(const CompactConnectivity& c, idx_t row);
+        idx_t decode(uint16_t v) const { return v == uint16_t(-1) ? missing_value_ : base_ + idx_t(v); }
+        idx_t decode(uint32_t v) const { return v == uint32_t(-1) ? missing_value_ : base_ + idx_t(v); }
+
+        const uint16_t* data16_{nullptr};
+        const uint32_t* data32_{nullptr};
+        idx_t base_;
+        idx_t size_;
+        idx_t missing_value_;
+        bool wide_;
+    };
+
+public:
+    CompactConnectivity() = default;
+
+    /// @brief Compress given connectivity, also applicable to a MultiBlockConnectivity
+    explicit CompactConnectivity(const IrregularConnectivityImpl&);
+
+    /// @brief Compress given connectivity
+    explicit CompactConnectivity(const BlockConnectivityImpl&);
+
+    idx_t rows() const { return rows_; }
+
+    idx_t cols(idx_t row) const { return fixed_cols_ >= 0 ? fixed_cols_ : idx_t(counts_[row]); }
+
+    idx_t maxcols() const { return maxcols_; }
+
+    idx_t missing_value() const { return missing_value_; }
+
+    /// @brief Value at (row,col), with base 0
+    idx_t operator()(idx_t row, idx_t col) const { return this->row(row)(col); }
+
+    Row row(idx_t row) const { return Row(*this, row); }
+
+    /// @brief Decode all values of a row into given array, and return the number of values
+    idx_t decode(idx_t row, idx_t values[]) const;
+
+    /// @brief Append all rows to given connectivity
+    void expand(IrregularConnectivityImpl&) const;
+
+    /// @brief Append all rows to given connectivity, which requires a fixed number of columns
+    void expand(BlockConnectivityImpl&) const;
+
+    /// @brief Number of chunks that need 32-bit offsets
+    idx_t wide_chunks() const;
+
+    size_t footprint() const;
+
+private:
+    struct Chunk {
+        idx_t base;     // smallest value in the chunk
+        size_t offset;  // position of first value in data16_ or data32_
+        bool wide;      // values stored in data32_
+    };
+
+    template <typename Connectivity>
+    void compress(const Connectivity&, idx_t fixed_cols);
+
+    idx_t local_offset(idx_t row) const {
+        return fixed_cols_ >= 0 ? (row % CHUNK) * fixed_cols_ : idx_t(offsets_[row]);
+    }
+
+private:
+    idx_t rows_{0};
+    idx_t maxcols_{0};
+    idx_t fixed_cols_{-1};
+    idx_t missing_value_{-1};
+
+    std::vector<Chunk> chunks_;
+    std::vector<uint16_t> data16_;
+    std::vector<uint32_t> data32_;
+
+    // Only used when rows have different number of columns
+    std::vector<uint8_t> counts_;
+    std::vector<uint16_t> offsets_;  // position of the row within its chunk
+};
+
+inline CompactConnectivity::Row::Row(const CompactConnectivity& c, idx_t row):
+    missing_value_(c.missing_value_) {
+    const Chunk& chunk = c.chunks_[row / CHUNK];
+    const size_t begin = chunk.offset + c.local_offset(row);
+    base_              = chunk.base;
+    size_              = c.cols(row);
+    wide_              = chunk.wide;
+    if (wide_) {
+        data32_ = c.data32_.data() + begin;
+    }
+    else {
+        data16_ = c.data16_.data() + begin;
+    }
+}
+
+}  // namespace mesh
+}  // namespace atlas
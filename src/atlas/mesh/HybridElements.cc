@@ -21,6 +21,7 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/trace/Memory.h"
 
 #if ATLAS_HAVE_FORTRAN
 #define FORTRAN_BASE 1
@@ -89,6 +90,12 @@ Field HybridElements::add(const Field& field) {
         throw_Exception(msg.str(), Here());
     }
     fields_[field.name()] = field;
+
+    // Fields that were not created as part of a mesh are from now on accounted to the mesh
+    auto* owner = field.array().memoryOwner();
+    if (owner && owner->type() == "Field") {
+        fields_[field.name()].array().memoryOwner(runtime::trace::Memory::owner("Mesh"));
+    }
     return field;
 }
 
@@ -161,6 +168,7 @@ idx_t HybridElements::add(const ElementType* element_type, idx_t nb_elements, co
 
 idx_t HybridElements::add(const ElementType* element_type, idx_t nb_elements, const idx_t connectivity[],
                           bool fortran_array) {
+    ATLAS_ASSERT(not compacted(), "HybridElements::expand() needs to be called before adding elements");
     util::ObjectHandle<const ElementType> etype(element_type);
 
     idx_t old_size = size();
@@ -195,6 +203,7 @@ idx_t HybridElements::add(const ElementType* element_type, idx_t nb_elements, co
 }
 
 idx_t HybridElements::add(const ElementType* element_type, idx_t nb_elements) {
+    ATLAS_ASSERT(not compacted(), "HybridElements::expand() needs to be called before adding elements");
     util::ObjectHandle<const ElementType> etype(element_type);
 
     idx_t old_size = size();
@@ -237,6 +246,7 @@ idx_t HybridElements::elemtype_nb_edges(idx_t elem_idx) const {
 }
 
 void HybridElements::insert(idx_t type_idx, idx_t position, idx_t nb_elements) {
+    ATLAS_ASSERT(not compacted(), "HybridElements::expand() needs to be called before inserting elements");
     type_idx_.insert(type_idx_.begin() + position, nb_elements, type_idx);
     elements_size_[type_idx] += nb_elements;
     for (idx_t jtype = type_idx + 1; jtype < nb_types() + 1; ++jtype) {
@@ -268,6 +278,56 @@ void HybridElements::clear() {
     element_types_.clear();
     type_idx_.clear();
     elements_.clear();
+    compact_connectivities_.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void HybridElements::compact() {
+    if (compacted()) {
+        return;
+    }
+    for (ConnectivityMap::iterator it = connectivities_.begin(); it != connectivities_.end(); ++it) {
+        Connectivity& connectivity = *it->second;
+        CompactBlocks compact{CompactConnectivity(connectivity), {}};
+        for (idx_t b = 0; b < connectivity.blocks(); ++b) {
+            compact.blocks.emplace_back(connectivity.block(b).rows(), connectivity.block(b).cols());
+        }
+        connectivity.clear();
+        compact_connectivities_.emplace(it->first, std::move(compact));
+    }
+}
+
+void HybridElements::expand() {
+    for (CompactConnectivityMap::iterator it = compact_connectivities_.begin(); it != compact_connectivities_.end();
+         ++it) {
+        const CompactBlocks& compact = it->second;
+        Connectivity& connectivity   = *connectivities_.at(it->first);
+        std::vector<idx_t> values;
+        idx_t row = 0;
+        for (const auto& block : compact.blocks) {
+            const idx_t rows = block.first;
+            const idx_t cols = block.second;
+            values.resize(size_t(rows) * size_t(cols));
+            for (idx_t r = 0; r < rows; ++r) {
+                compact.connectivity.decode(row + r, values.data() + size_t(r) * size_t(cols));
+            }
+            connectivity.add(rows, cols, values.data(), /* fortran_array = */ false);
+            row += rows;
+        }
+        ATLAS_ASSERT(row == compact.connectivity.rows());
+    }
+    compact_connectivities_.clear();
+}
+
+const CompactConnectivity& HybridElements::compact_connectivity(const std::string& name) const {
+    auto it = compact_connectivities_.find(name);
+    if (it == compact_connectivities_.end()) {
+        throw_Exception("HybridElements has no compact connectivity \"" + name +
+                            "\". HybridElements::compact() needs to be called first.",
+                        Here());
+    }
+    return it->second.connectivity;
 }
 
 //-----------------------------------------------------------------------------
@@ -292,6 +352,10 @@ size_t HybridElements::footprint() const {
     for (ConnectivityMap::const_iterator it = connectivities_.begin(); it != connectivities_.end(); ++it) {
         size += (*it).second->footprint();
     }
+    for (CompactConnectivityMap::const_iterator it = compact_connectivities_.begin();
+         it != compact_connectivities_.end(); ++it) {
+        size += (*it).second.connectivity.footprint();
+    }
     size += elements_size_.capacity() * sizeof(idx_t);
     size += elements_begin_.capacity() * sizeof(idx_t);
 
@@ -24,6 +24,7 @@
 #include "atlas/field/Field.h"
 #include "atlas/util/Metadata.h"
 
+#include "atlas/mesh/CompactConnectivity.h"
 #include "atlas/mesh/Connectivity.h"
 
 namespace atlas {
@@ -178,6 +179,20 @@ public:  // methods
 
     void clear();
 
+    /// @brief Replace the connectivity tables by their compressed, read-only form (see CompactConnectivity).
+    /// The regular tables are cleared to release their memory, and remain empty until expand() is called.
+    /// Access the compressed tables with compact_connectivity(name) instead.
+    void compact();
+
+    /// @brief Restore the connectivity tables replaced by compact()
+    void expand();
+
+    /// @brief Whether the connectivity tables are currently stored in compressed form
+    bool compacted() const { return not compact_connectivities_.empty(); }
+
+    /// @brief Compressed connectivity table with given name ("node", "edge" or "cell"), after compact()
+    const CompactConnectivity& compact_connectivity(const std::string& name) const;
+
     /// @brief Return the memory footprint of the elements
     size_t footprint() const;
 
@@ -185,6 +200,13 @@ private:  // -- types
     typedef std::map<std::string, Field> FieldMap;
     typedef std::map<std::string, util::ObjectHandle<Connectivity>> ConnectivityMap;
 
+    /// Compressed connectivity, with the shape of each block to restore it
+    struct CompactBlocks {
+        CompactConnectivity connectivity;
+        std::vector<std::pair<idx_t, idx_t>> blocks;  // {rows, cols} of each block
+    };
+    typedef std::map<std::string, CompactBlocks> CompactConnectivityMap;
+
 private:  // -- methods
     void resize(idx_t size);
 
@@ -211,6 +233,7 @@ private:  // -- Data
     // -- Fields and connectivities
     FieldMap fields_;
     ConnectivityMap connectivities_;
+    CompactConnectivityMap compact_connectivities_;
 
     // -- Metadata
     util::Metadata metadata_;
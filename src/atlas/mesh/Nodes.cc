@@ -17,6 +17,7 @@
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/trace/Memory.h"
 #include "atlas/util/CoordinateEnums.h"
 
 using atlas::array::make_datatype;
@@ -58,6 +59,12 @@ Field Nodes::add(const Field& field) {
         throw_Exception(msg.str(), Here());
     }
     fields_[field.name()] = field;
+
+    // Fields that were not created as part of a mesh are from now on accounted to the mesh
+    auto* owner = field.array().memoryOwner();
+    if (owner && owner->type() == "Field") {
+        fields_[field.name()].array().memoryOwner(runtime::trace::Memory::owner("Mesh"));
+    }
     return field;
 }
 
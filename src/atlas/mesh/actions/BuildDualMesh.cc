@@ -27,6 +27,8 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildDualMesh.h"
 #include "atlas/parallel/Checksum.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -73,7 +75,7 @@ struct Node {
     gidx_t g;
     idx_t i;
 
-    bool operator<(const Node& other) const { return (g < other.g); }
+    bool operator<(const Node& other) const { return (g < other.g) || (g == other.g && i < other.i); }
 };
 
 }  // namespace
@@ -144,7 +146,7 @@ array::Array* build_centroids_xy(const mesh::HybridElements& elements, const Fie
     array::ArrayView<double, 2> centroids = array::make_view<double, 2>(*array_centroids);
     idx_t nb_elems                        = elements.size();
     const mesh::HybridElements::Connectivity& elem_nodes = elements.node_connectivity();
-    for (idx_t e = 0; e < nb_elems; ++e) {
+    atlas_omp_parallel_for(idx_t e = 0; e < nb_elems; ++e) {
         centroids(e, XX)                 = 0.;
         centroids(e, YY)                 = 0.;
         const idx_t nb_nodes_per_elem    = elem_nodes.cols(e);
@@ -180,15 +182,16 @@ void add_median_dual_volume_contribution_cells(const mesh::HybridElements& cells
     // special ordering for bit-identical results
     idx_t nb_cells = cells.size();
     std::vector<Node> ordering(nb_cells);
-    for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
+    atlas_omp_parallel_for(idx_t jcell = 0; jcell < nb_cells; ++jcell) {
         ordering[jcell] = Node(util::unique_lonlat(cell_centroids(jcell, XX), cell_centroids(jcell, YY)), jcell);
     }
-    std::sort(ordering.data(), ordering.data() + nb_cells);
+    omp::sort(ordering.begin(), ordering.end());
 
-    for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
+    // Calls contribute(inode, triag_area) for every contribution of the ordered cell jcell to a node
+    auto for_each_contribution = [&](idx_t jcell, const auto& contribute) {
         idx_t icell = ordering[jcell].i;
         if (patch(icell)) {
-            continue;
+            return;
         }
         double x0 = cell_centroids(icell, XX);
         double y0 = cell_centroids(icell, YY);
@@ -198,13 +201,61 @@ void add_median_dual_volume_contribution_cells(const mesh::HybridElements& cells
             double x1   = edge_centroids(iedge, XX);
             double y1   = edge_centroids(iedge, YY);
             for (idx_t jnode = 0; jnode < 2; ++jnode) {
-                idx_t inode       = edge_node_connectivity(iedge, jnode);
-                double x2         = xy(inode, XX);
-                double y2         = xy(inode, YY);
-                double triag_area = std::abs(x0 * (y1 - y2) + x1 * (y2 - y0) + x2 * (y0 - y1)) * 0.5;
-                dual_volumes(inode) += triag_area;
+                idx_t inode = edge_node_connectivity(iedge, jnode);
+                double x2   = xy(inode, XX);
+                double y2   = xy(inode, YY);
+                contribute(inode, [=]() { return std::abs(x0 * (y1 - y2) + x1 * (y2 - y0) + x2 * (y0 - y1)) * 0.5; });
             }
         }
+    };
+
+    // Contributions are gathered per node in the order of the sorted cells before they are summed, so that every
+    // node accumulates its contributions in the same order as a serial loop would, independent of the number of
+    // threads. The ordered cells are split in contiguous chunks, each counting its contributions per node in its own
+    // histogram; prefix sums over nodes and chunks then give every chunk its insertion position for every node.
+    const idx_t nb_nodes = nodes.size();
+    const int nb_chunks  = atlas_omp_get_max_threads();
+    auto chunk_begin     = [&](int chunk) { return static_cast<idx_t>((size_t(nb_cells) * chunk) / nb_chunks); };
+    std::vector<std::vector<size_t>> histogram(nb_chunks);
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        auto& count = histogram[chunk];
+        count.assign(nb_nodes, 0);
+        for (idx_t jcell = chunk_begin(chunk); jcell < chunk_begin(chunk + 1); ++jcell) {
+            for_each_contribution(jcell, [&](idx_t inode, const auto&) { ++count[inode]; });
+        }
+    }
+
+    std::vector<size_t> displs(nb_nodes + 1, 0);
+    for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        size_t size = 0;
+        for (int chunk = 0; chunk < nb_chunks; ++chunk) {
+            size += histogram[chunk][jnode];
+        }
+        displs[jnode + 1] = displs[jnode] + size;
+    }
+    atlas_omp_parallel_for(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        size_t position = displs[jnode];
+        for (int chunk = 0; chunk < nb_chunks; ++chunk) {
+            const size_t count      = histogram[chunk][jnode];
+            histogram[chunk][jnode] = position;
+            position += count;
+        }
+    }
+
+    std::vector<double> contributions(displs[nb_nodes]);
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        auto& position = histogram[chunk];
+        for (idx_t jcell = chunk_begin(chunk); jcell < chunk_begin(chunk + 1); ++jcell) {
+            for_each_contribution(jcell, [&](idx_t inode, const auto& triag_area) {
+                contributions[position[inode]++] = triag_area();
+            });
+        }
+    }
+
+    atlas_omp_parallel_for(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        for (size_t c = displs[jnode]; c < displs[jnode + 1]; ++c) {
+            dual_volumes(jnode) += contributions[c];
+        }
     }
 }
 
@@ -274,7 +325,6 @@ void build_dual_normals(Mesh& mesh) {
     global_bounding_box(nodes, min, max);
     double tol = 1.e-6;
 
-    double xl, yl, xr, yr;
     array::ArrayView<double, 2> edge_centroids = array::make_view<double, 2>(edges.field("centroids_xy"));
     array::ArrayView<double, 2> dual_normals   = array::make_view<double, 2>(
         edges.add(Field("dual_normals", array::make_datatype<double>(), array::make_shape(nb_edges, 2))));
@@ -291,13 +341,20 @@ void build_dual_normals(Mesh& mesh) {
         }
     }
 
-    for (idx_t edge = 0; edge < nb_edges; ++edge) {
+    const std::vector<idx_t> no_bdry_edges;
+    auto bdry_edges_of = [&](idx_t node) -> const std::vector<idx_t>& {
+        auto it = node_to_bdry_edge.find(node);
+        return it != node_to_bdry_edge.end() ? it->second : no_bdry_edges;
+    };
+
+    // Each iteration only writes to its own edge, and pole edges only read boundary edges which are not pole edges
+    atlas_omp_parallel_for(idx_t edge = 0; edge < nb_edges; ++edge) {
         if (edge_cell_connectivity(edge, 0) == edge_cell_connectivity.missing_value()) {
             // this is a pole edge
             // only compute for one node
             for (idx_t n = 0; n < 2; ++n) {
-                idx_t node                     = edge_node_connectivity(edge, n);
-                std::vector<idx_t>& bdry_edges = node_to_bdry_edge[node];
+                idx_t node                           = edge_node_connectivity(edge, n);
+                const std::vector<idx_t>& bdry_edges = bdry_edges_of(node);
                 double x[2];
                 idx_t cnt                 = 0;
                 const idx_t nb_bdry_edges = static_cast<idx_t>(bdry_edges.size());
@@ -330,10 +387,11 @@ void build_dual_normals(Mesh& mesh) {
             }
         }
         else {
+            double xr, yr;
             idx_t left_elem  = edge_cell_connectivity(edge, 0);
             idx_t right_elem = edge_cell_connectivity(edge, 1);
-            xl               = elem_centroids(left_elem, XX);
-            yl               = elem_centroids(left_elem, YY);
+            double xl        = elem_centroids(left_elem, XX);
+            double yl        = elem_centroids(left_elem, YY);
             if (right_elem == edge_cell_connectivity.missing_value()) {
                 xr = edge_centroids(edge, XX);
                 yr = edge_centroids(edge, YY);
@@ -367,7 +425,7 @@ void make_dual_normals_outward(Mesh& mesh) {
     array::ArrayView<double, 2> dual_normals = array::make_view<double, 2>(edges.field("dual_normals"));
     const idx_t nb_edges                     = edges.size();
 
-    for (idx_t edge = 0; edge < nb_edges; ++edge) {
+    atlas_omp_parallel_for(idx_t edge = 0; edge < nb_edges; ++edge) {
         if (edge_cell_connectivity(edge, 0) != edge_cell_connectivity.missing_value()) {
             // Make normal point from node 1 to node 2
             const idx_t ip1 = edge_node_connectivity(edge, 0);
@@ -15,7 +15,6 @@
 #include <iostream>
 #include <limits>
 #include <memory>
-#include <set>
 #include <stdexcept>
 
 #include "eckit/types/FloatCompare.h"
@@ -34,9 +33,12 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/radix_sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/FlatHashMap.h"
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
 #include "atlas/util/Unique.h"
@@ -62,6 +64,7 @@ struct Sort {
     gidx_t g;
     idx_t i;
     bool operator<(const Sort& other) const { return (g < other.g); }
+    static gidx_t key(const Sort& sort) { return sort.g; }
 };
 }  // anonymous namespace
 
@@ -87,16 +90,15 @@ void build_element_to_edge_connectivity(Mesh& mesh) {
     auto is_pole_edge = [&](idx_t e) { return Topology::check(edge_flags(e), Topology::POLE); };
 
     // Sort edges for bit-reproducibility
-    std::vector<Sort> edge_sort;
-    edge_sort.reserve(nb_edges);
+    std::vector<Sort> edge_sort(nb_edges);
     {
         UniqueLonLat compute_uid(mesh);
 
-        for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
-            edge_sort.emplace_back(Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge));
+        atlas_omp_parallel_for(idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+            edge_sort[jedge] = Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge);
         }
 
-        std::sort(edge_sort.data(), edge_sort.data() + nb_edges);
+        omp::radix_sort(edge_sort.begin(), edge_sort.end(), Sort::key);
     }
 
     // Fill in cell_edge_connectivity
@@ -178,10 +180,10 @@ void build_node_to_edge_connectivity(Mesh& mesh) {
 
     UniqueLonLat compute_uid(mesh);
     std::vector<Sort> edge_sort(nb_edges);
-    for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+    atlas_omp_parallel_for(idx_t jedge = 0; jedge < nb_edges; ++jedge) {
         edge_sort[jedge] = Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge);
     }
-    std::stable_sort(edge_sort.data(), edge_sort.data() + nb_edges);
+    omp::radix_sort(edge_sort.begin(), edge_sort.end(), Sort::key);
 
     for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
         idx_t iedge = edge_sort[jedge].i;
@@ -204,7 +206,8 @@ class AccumulatePoleEdges {
     const array::ArrayView<int, 1> part;
     const array::ArrayView<int, 1> halo;
     const idx_t nb_nodes;
-    std::vector<std::set<int>> pole_nodes;
+    std::vector<std::vector<int>> pole_nodes;
+    std::vector<util::FlatHashMap<int, std::vector<int>>> pole_nodes_at_x;  // microdeg(x) -> pole nodes
 
 public:
     AccumulatePoleEdges(mesh::Nodes& nodes):
@@ -213,7 +216,8 @@ public:
         part(array::make_view<int, 1>(nodes.partition())),
         halo(array::make_view<int, 1>(nodes.halo())),
         nb_nodes(nodes.size()),
-        pole_nodes(2) {
+        pole_nodes(2),
+        pole_nodes_at_x(2) {
         double min[2], max[2];
         min[XX] = std::numeric_limits<double>::max();
         min[YY] = std::numeric_limits<double>::max();
@@ -236,10 +240,15 @@ public:
         // Collect all nodes closest to poles
         for (idx_t node = 0; node < nb_nodes; ++node) {
             if (std::abs(xy(node, YY) - max[YY]) < tol) {
-                pole_nodes[NORTH].insert(node);
+                pole_nodes[NORTH].push_back(node);
             }
             else if (std::abs(xy(node, YY) - min[YY]) < tol) {
-                pole_nodes[SOUTH].insert(node);
+                pole_nodes[SOUTH].push_back(node);
+            }
+        }
+        for (idx_t NS = 0; NS < 2; ++NS) {
+            for (int node : pole_nodes[NS]) {
+                pole_nodes_at_x[NS][microdeg(xy(node, XX))].push_back(node);
             }
         }
 
@@ -247,8 +256,7 @@ public:
         {
             for (idx_t NS = 0; NS < 2; ++NS) {
                 int npart = -1;
-                for (std::set<int>::iterator it = pole_nodes[NS].begin(); it != pole_nodes[NS].end(); ++it) {
-                    int node = *it;
+                for (int node : pole_nodes[NS]) {
                     if (npart == -1) {
                         npart = part(node);
                     }
@@ -267,19 +275,19 @@ public:
         // Create connections over the poles and store in pole_edge_nodes
         nb_pole_edges = 0;
         for (idx_t NS = 0; NS < 2; ++NS) {
-            for (std::set<int>::iterator it = pole_nodes[NS].begin(); it != pole_nodes[NS].end(); ++it) {
-                int node = *it;
+            for (int node : pole_nodes[NS]) {
                 if (!Topology::check(flags(node), Topology::PERIODIC | Topology::GHOST)) {
-                    int x2 = microdeg(xy(node, XX) + 180.);
-                    for (std::set<int>::iterator itr = pole_nodes[NS].begin(); itr != pole_nodes[NS].end(); ++itr) {
-                        int other_node = *itr;
-                        if (microdeg(xy(other_node, XX)) == x2) {
-                            if (!Topology::check(flags(other_node), Topology::PERIODIC)) {
-                                if (halo(node) == _halo && halo(other_node) == _halo) {
-                                    pole_edge_nodes.push_back(node);
-                                    pole_edge_nodes.push_back(other_node);
-                                    ++nb_pole_edges;
-                                }
+                    int x2     = microdeg(xy(node, XX) + 180.);
+                    auto found = pole_nodes_at_x[NS].find(x2);
+                    if (found == pole_nodes_at_x[NS].end()) {
+                        continue;
+                    }
+                    for (int other_node : found->second) {
+                        if (!Topology::check(flags(other_node), Topology::PERIODIC)) {
+                            if (halo(node) == _halo && halo(other_node) == _halo) {
+                                pole_edge_nodes.push_back(node);
+                                pole_edge_nodes.push_back(other_node);
+                                ++nb_pole_edges;
                             }
                         }
                     }
@@ -398,7 +406,9 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
                 idx_t lowest_node_idx = std::min(edge_nodes_data.at(2 * iedge + 0), edge_nodes_data.at(2 * iedge + 1));
                 sorted_edges_by_lowest_node_index.emplace_back(lowest_node_idx, e);
             }
-            std::sort(sorted_edges_by_lowest_node_index.begin(), sorted_edges_by_lowest_node_index.end());
+            // stable, so edges with the same lowest node stay ordered by edge index
+            omp::radix_sort(sorted_edges_by_lowest_node_index.begin(), sorted_edges_by_lowest_node_index.end(),
+                            [](const std::pair<idx_t, idx_t>& edge) { return edge.first; });
             for (idx_t e = edge_start; e < edge_end; ++e) {
                 const idx_t iedge = edge_halo_offsets[halo] + (e - edge_start);
                 const idx_t sedge =
@@ -8,14 +8,15 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
-#include <unordered_map>
-#include <unordered_set>
+#include <type_traits>
 
 #include "atlas/array.h"
 #include "atlas/array/IndexView.h"
@@ -28,14 +29,15 @@
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
-#include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
-#include "atlas/parallel/omp/sort.h"
+#include "atlas/parallel/omp/radix_sort.h"
+#include "atlas/parallel/omp/unique.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/FlatHashMap.h"
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
 #include "atlas/util/PeriodicTransform.h"
@@ -48,9 +50,6 @@
 #include "atlas/output/Gmsh.h"
 #endif
 
-// #define ATLAS_103
-// #define ATLAS_103_SORT
-
 using atlas::mesh::detail::accumulate_facets;
 using atlas::util::LonLatMicroDeg;
 using atlas::util::microdeg;
@@ -70,6 +69,7 @@ struct Entity {
     gidx_t g;
     idx_t i;
     bool operator<(const Entity& other) const { return (g < other.g); }
+    static gidx_t key(const Entity& entity) { return entity.g; }
 };
 
 void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& build_halo, mesh::Nodes& nodes,
@@ -160,7 +160,7 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
         node_sort.emplace_back(glb_idx_gathered[jnode], jnode);
     }
 
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(node_sort.begin(), node_sort.end()); }
+    ATLAS_TRACE_SCOPE("sort on rank 0") { omp::radix_sort(node_sort.begin(), node_sort.end(), Entity::key); }
 
     gidx_t gid               = glb_idx_max + 1;
     const idx_t nb_node_sort = static_cast<idx_t>(node_sort.size());
@@ -260,7 +260,7 @@ void make_cells_global_index_human_readable(const mesh::actions::BuildHalo& buil
         cell_sort.emplace_back(glb_idx_gathered[jcell], jcell);
     }
 
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(cell_sort.begin(), cell_sort.end()); }
+    ATLAS_TRACE_SCOPE("sort on rank 0") { omp::radix_sort(cell_sort.begin(), cell_sort.end(), Entity::key); }
 
     gidx_t gid = glb_idx_max + 1;
     for (idx_t jcell = 0; jcell < glb_nb_cells; ++jcell) {
@@ -337,11 +337,9 @@ void build_lookup_node2elem(const Mesh& mesh, Node2Elem& node2elem) {
     }
 }
 
-void accumulate_partition_bdry_nodes_old(Mesh& mesh, std::vector<idx_t>& bdry_nodes) {
+void accumulate_partition_bdry_nodes(Mesh& mesh, std::vector<idx_t>& bdry_nodes) {
     ATLAS_TRACE();
 
-    std::set<idx_t> bdry_nodes_set;
-
     std::vector<idx_t> facet_nodes;
     std::vector<idx_t> connectivity_facet_to_elem;
 
@@ -360,31 +358,62 @@ void accumulate_partition_bdry_nodes_old(Mesh& mesh, std::vector<idx_t>& bdry_no
         /*out*/ nb_inner_facets,
         /*out*/ missing_value);
 
+    bdry_nodes.clear();
     for (idx_t jface = 0; jface < nb_facets; ++jface) {
         if (connectivity_facet_to_elem[jface * 2 + 1] == missing_value) {
             for (idx_t jnode = 0; jnode < 2; ++jnode)  // 2 nodes per face
             {
-                bdry_nodes_set.insert(facet_nodes[jface * 2 + jnode]);
+                bdry_nodes.push_back(facet_nodes[jface * 2 + jnode]);
             }
         }
     }
-    bdry_nodes = std::vector<idx_t>(bdry_nodes_set.begin(), bdry_nodes_set.end());
+    omp::radix_sort(bdry_nodes.begin(), bdry_nodes.end());
+    bdry_nodes.erase(omp::unique(bdry_nodes.begin(), bdry_nodes.end()), bdry_nodes.end());
 }
 
-void accumulate_partition_bdry_nodes(Mesh& mesh, idx_t halo, std::vector<idx_t>& bdry_nodes) {
-#ifndef ATLAS_103
-    /* deprecated */
-    accumulate_partition_bdry_nodes_old(mesh, bdry_nodes);
-#else
+/// Partitions that can own elements within "distance" element layers of this partition.
+/// Elements sharing a node are owned by the same or by nearest neighbour partitions in the partition graph,
+/// so these are found within "distance" steps in the partition graph. As the partition graph is known to all
+/// partitions and symmetric, so is this relation, which allows sparse point-to-point communication.
+/// With "all_partitions", every partition is returned regardless of distance.
+std::vector<idx_t> halo_partitions(const Mesh& mesh, idx_t distance, bool include_self, bool all_partitions) {
     ATLAS_TRACE();
-    const Mesh::Polygon& polygon = mesh.polygon(halo);
-    bdry_nodes                   = std::vector<int>(polygon.begin(), polygon.end());
-#endif
+    const idx_t rank = static_cast<idx_t>(mpi::rank());
+    if (all_partitions) {
+        std::vector<idx_t> partitions;
+        for (idx_t p = 0; p < static_cast<idx_t>(mpi::size()); ++p) {
+            if (p != rank || include_self) {
+                partitions.push_back(p);
+            }
+        }
+        return partitions;
+    }
 
-#ifdef ATLAS_103_SORT
-    /* not required */
-    std::sort(bdry_nodes.begin(), bdry_nodes.end());
-#endif
+    const Mesh::PartitionGraph& graph = mesh.partitionGraph();
+
+    std::vector<bool> visited(graph.size(), false);
+    std::vector<idx_t> partitions;
+    std::vector<idx_t> front{rank};
+    visited[rank] = true;
+    for (idx_t d = 0; d < distance && front.size(); ++d) {
+        std::vector<idx_t> next;
+        for (idx_t p : front) {
+            for (idx_t neighbour : graph.nearestNeighbours(p)) {
+                if (not visited[neighbour]) {
+                    visited[neighbour] = true;
+                    next.push_back(neighbour);
+                    partitions.push_back(neighbour);
+                }
+            }
+        }
+        front.swap(next);
+    }
+    if (include_self) {
+        // allow periodicity with self (pole caps)
+        partitions.push_back(rank);
+    }
+    std::sort(partitions.begin(), partitions.end());
+    return partitions;
 }
 
 template <typename Predicate>
@@ -432,7 +461,7 @@ private:
     std::vector<std::string> notes;
 };
 
-using Uid2Node = std::unordered_map<uid_t, idx_t>;
+using Uid2Node = util::FlatHashMap<uid_t, idx_t>;
 
 
 void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
@@ -446,6 +475,7 @@ void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
     UniqueLonLat compute_uid(mesh);
 
     uid2node.clear();
+    uid2node.reserve(nb_nodes);
     for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
         uid_t uid     = compute_uid(jnode);
         bool inserted = uid2node.insert(std::make_pair(uid, jnode)).second;
@@ -473,9 +503,9 @@ void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
 }
 
 /// For given nodes, find new connected elements
-void accumulate_elements(const Mesh& mesh, const mpi::BufferView<uid_t>& request_node_uid, const Uid2Node& uid2node,
+void accumulate_elements(const Mesh& mesh, const std::vector<uid_t>& request_node_uid, const Uid2Node& uid2node,
                          const Node2Elem& node2elem, std::vector<idx_t>& found_elements,
-                         std::set<uid_t>& new_nodes_uid) {
+                         std::vector<uid_t>& new_nodes_uid) {
 
     ATLAS_TRACE();
     const mesh::HybridElements::Connectivity& elem_nodes = mesh.cells().node_connectivity();
@@ -485,11 +515,10 @@ void accumulate_elements(const Mesh& mesh, const mpi::BufferView<uid_t>& request
     const idx_t nb_request_nodes = static_cast<idx_t>(request_node_uid.size());
     const int mpi_rank           = static_cast<int>(mpi::rank());
 
-    std::unordered_set<idx_t> found_elements_set;
-    found_elements_set.reserve(nb_request_nodes*2);
+    util::FlatHashSet<idx_t> found_elements_set(nb_request_nodes * 2);
 
     for (idx_t jnode = 0; jnode < nb_request_nodes; ++jnode) {
-        uid_t uid = request_node_uid(jnode);
+        uid_t uid = request_node_uid[jnode];
 
         idx_t inode = -1;
         // search and get node index for uid
@@ -508,27 +537,35 @@ void accumulate_elements(const Mesh& mesh, const mpi::BufferView<uid_t>& request
 
     // found_bdry_elements_set now contains elements for the nodes
     found_elements = std::vector<idx_t>(found_elements_set.begin(), found_elements_set.end());
+    omp::radix_sort(found_elements.begin(), found_elements.end());
 
     UniqueLonLat compute_uid(mesh);
 
-    // Collect all nodes
+    // Collect all nodes, except nodes we already have in the request-buffer
+    util::FlatHashSet<uid_t> collected_nodes_uid(nb_request_nodes + found_elements.size() * 4);
+    for (idx_t jnode = 0; jnode < nb_request_nodes; ++jnode) {
+        collected_nodes_uid.insert(request_node_uid[jnode]);
+    }
     new_nodes_uid.clear();
     for (const idx_t e : found_elements) {
         idx_t nb_elem_nodes = elem_nodes.cols(e);
         for (idx_t n = 0; n < nb_elem_nodes; ++n) {
-            new_nodes_uid.insert(compute_uid(elem_nodes(e, n)));
+            uid_t uid = compute_uid(elem_nodes(e, n));
+            if (collected_nodes_uid.insert(uid).second) {
+                new_nodes_uid.push_back(uid);
+            }
         }
     }
-
-    // Remove nodes we already have in the request-buffer
-    for (idx_t jnode = 0; jnode < nb_request_nodes; ++jnode) {
-        new_nodes_uid.erase(request_node_uid(jnode));
-    }
+    // sorted by uid, as nodes are added to the receiving mesh in this order
+    omp::radix_sort(new_nodes_uid.begin(), new_nodes_uid.end());
 }
 
 class BuildHaloHelper {
 public:
+    /// Buffers of nodes and elements to send to, or received from, each partition in "partitions"
     struct Buffers {
+        std::vector<idx_t> partitions;
+
         std::vector<std::vector<int>> node_part;
 
         std::vector<std::vector<int>> node_ridx;
@@ -553,29 +590,85 @@ public:
 
         std::vector<std::vector<int>> elem_type;
 
-        Buffers(Mesh&) {
-            const idx_t mpi_size = static_cast<idx_t>(mpi::size());
+        Buffers(const std::vector<idx_t>& _partitions): partitions(_partitions) {
+            const size_t nb_partitions = partitions.size();
+
+            node_part.resize(nb_partitions);
+            node_ridx.resize(nb_partitions);
+            node_flags.resize(nb_partitions);
+            node_glb_idx.resize(nb_partitions);
+            node_xy.resize(nb_partitions);
+            elem_glb_idx.resize(nb_partitions);
+            elem_nodes_id.resize(nb_partitions);
+            elem_nodes_displs.resize(nb_partitions);
+            elem_part.resize(nb_partitions);
+            elem_ridx.resize(nb_partitions);
+            elem_flags.resize(nb_partitions);
+            elem_type.resize(nb_partitions);
+        }
+
+        idx_t size() const { return static_cast<idx_t>(partitions.size()); }
+
+        /// Apply visitor to each buffer of partition slot j, 8-byte types first
+        template <typename BuffersT, typename Visitor>
+        static void visit(BuffersT& buf, idx_t j, const Visitor& visitor) {
+            visitor(buf.node_glb_idx[j]);
+            visitor(buf.node_xy[j]);
+            visitor(buf.elem_glb_idx[j]);
+            visitor(buf.elem_nodes_id[j]);
+            visitor(buf.node_part[j]);
+            visitor(buf.node_ridx[j]);
+            visitor(buf.node_flags[j]);
+            visitor(buf.elem_nodes_displs[j]);
+            visitor(buf.elem_part[j]);
+            visitor(buf.elem_ridx[j]);
+            visitor(buf.elem_flags[j]);
+            visitor(buf.elem_type[j]);
+        }
+
+        /// Pack all buffers of partition slot j in a single message: { size, values } for each buffer
+        void pack(idx_t j, std::vector<char>& message) const {
+            size_t bytes = 0;
+            visit(*this, j, [&bytes](const auto& v) {
+                using value_type = typename std::decay_t<decltype(v)>::value_type;
+                bytes += sizeof(size_t) + v.size() * sizeof(value_type);
+            });
+            message.resize(bytes);
+            char* pos = message.data();
+            visit(*this, j, [&pos](const auto& v) {
+                using value_type = typename std::decay_t<decltype(v)>::value_type;
+                const size_t size = v.size();
+                std::memcpy(pos, &size, sizeof(size_t));
+                pos += sizeof(size_t);
+                if (size) {
+                    std::memcpy(pos, v.data(), size * sizeof(value_type));
+                    pos += size * sizeof(value_type);
+                }
+            });
+        }
 
-            node_part.resize(mpi_size);
-            node_ridx.resize(mpi_size);
-            node_flags.resize(mpi_size);
-            node_glb_idx.resize(mpi_size);
-            node_xy.resize(mpi_size);
-            elem_glb_idx.resize(mpi_size);
-            elem_nodes_id.resize(mpi_size);
-            elem_nodes_displs.resize(mpi_size);
-            elem_part.resize(mpi_size);
-            elem_ridx.resize(mpi_size);
-            elem_flags.resize(mpi_size);
-            elem_type.resize(mpi_size);
+        /// Unpack a message created with pack() into the buffers of partition slot j
+        void unpack(idx_t j, const std::vector<char>& message) {
+            const char* pos = message.data();
+            visit(*this, j, [&pos](auto& v) {
+                using value_type = typename std::decay_t<decltype(v)>::value_type;
+                size_t size;
+                std::memcpy(&size, pos, sizeof(size_t));
+                pos += sizeof(size_t);
+                v.resize(size);
+                if (size) {
+                    std::memcpy(v.data(), pos, size * sizeof(value_type));
+                    pos += size * sizeof(value_type);
+                }
+            });
+            ATLAS_ASSERT(pos == message.data() + message.size());
         }
 
         void print(std::ostream& os) const {
-            const idx_t mpi_size = static_cast<idx_t>(mpi::size());
             os << "Nodes\n"
                << "-----\n";
             idx_t n(0);
-            for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+            for (idx_t jpart = 0; jpart < size(); ++jpart) {
                 for (idx_t jnode = 0; jnode < node_glb_idx[jpart].size(); ++jnode ) {
                     auto g = node_glb_idx[jpart][jnode];
                     auto p = node_part[jpart][jnode];
@@ -586,7 +679,7 @@ public:
             os << "Cells\n"
                << "-----\n";
             idx_t e(0);
-            for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+            for (idx_t jpart = 0; jpart < size(); ++jpart) {
                 const idx_t nb_elem = static_cast<idx_t>(elem_glb_idx[jpart].size());
                 for (idx_t jelem = 0; jelem < nb_elem; ++jelem) {
                     os << std::setw(4) << e++ << " :  [ t" << elem_type[jpart][jelem] << " -- p"
@@ -601,23 +694,75 @@ public:
         }
     };
 
-    static void all_to_all(Buffers& send, Buffers& recv) {
+    /// Sparse point-to-point exchange of all buffers, with one message per partition
+    static void exchange(const Buffers& send, Buffers& recv) {
         ATLAS_TRACE();
+        ATLAS_ASSERT(send.partitions == recv.partitions);
         const eckit::mpi::Comm& comm = mpi::comm();
+        const idx_t nb_partitions    = send.size();
+        const int size_tag           = 0;
+        const int message_tag        = 1;
+
+        std::vector<std::vector<char>> send_messages(nb_partitions);
+        std::vector<std::vector<char>> recv_messages(nb_partitions);
+        std::vector<long> send_sizes(nb_partitions);
+        std::vector<long> recv_sizes(nb_partitions);
+        std::vector<eckit::mpi::Request> send_requests(nb_partitions);
+        std::vector<eckit::mpi::Request> recv_requests(nb_partitions);
+
+        ATLAS_TRACE_SCOPE("pack") {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                send.pack(j, send_messages[j]);
+                send_sizes[j] = static_cast<long>(send_messages[j].size());
+            }
+        }
 
-        ATLAS_TRACE_MPI(ALLTOALL) {
-            comm.allToAll(send.node_glb_idx, recv.node_glb_idx);
-            comm.allToAll(send.node_part, recv.node_part);
-            comm.allToAll(send.node_ridx, recv.node_ridx);
-            comm.allToAll(send.node_flags, recv.node_flags);
-            comm.allToAll(send.node_xy, recv.node_xy);
-            comm.allToAll(send.elem_glb_idx, recv.elem_glb_idx);
-            comm.allToAll(send.elem_nodes_id, recv.elem_nodes_id);
-            comm.allToAll(send.elem_part, recv.elem_part);
-            comm.allToAll(send.elem_ridx, recv.elem_ridx);
-            comm.allToAll(send.elem_type, recv.elem_type);
-            comm.allToAll(send.elem_flags, recv.elem_flags);
-            comm.allToAll(send.elem_nodes_displs, recv.elem_nodes_displs);
+        ATLAS_TRACE_MPI(ISEND) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                send_requests[j] = comm.iSend(send_sizes[j], send.partitions[j], size_tag);
+            }
+        }
+        ATLAS_TRACE_MPI(IRECEIVE) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                recv_requests[j] = comm.iReceive(recv_sizes[j], recv.partitions[j], size_tag);
+            }
+        }
+        ATLAS_TRACE_MPI(WAIT) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                comm.wait(send_requests[j]);
+                comm.wait(recv_requests[j]);
+            }
+        }
+
+        ATLAS_TRACE_MPI(IRECEIVE) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                recv_messages[j].resize(recv_sizes[j]);
+                recv_requests[j] =
+                    comm.iReceive(recv_messages[j].data(), recv_messages[j].size(), recv.partitions[j], message_tag);
+            }
+        }
+        ATLAS_TRACE_MPI(ISEND) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                send_requests[j] =
+                    comm.iSend(send_messages[j].data(), send_messages[j].size(), send.partitions[j], message_tag);
+            }
+        }
+        ATLAS_TRACE_MPI(WAIT) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                comm.wait(recv_requests[j]);
+            }
+        }
+
+        ATLAS_TRACE_SCOPE("unpack") {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                recv.unpack(j, recv_messages[j]);
+            }
+        }
+
+        ATLAS_TRACE_MPI(WAIT) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                comm.wait(send_requests[j]);
+            }
         }
     }
 
@@ -718,7 +863,7 @@ public:
                 Topology::set(buf.node_flags[p][jnode], flags(node) | Topology::GHOST);
             }
             else {
-                Log::warning() << "Node with uid " << uid << " needed by [" << p << "] was not found in ["
+                Log::warning() << "Node with uid " << uid << " needed by [" << buf.partitions[p] << "] was not found in ["
                                << mpi::rank() << "]." << std::endl;
                 ATLAS_ASSERT(false);
             }
@@ -787,7 +932,7 @@ public:
                 Topology::set(buf.node_flags[p][jnode], newflags);
             }
             else {
-                Log::warning() << "Node with uid " << uid << " needed by [" << p << "] was not found in ["
+                Log::warning() << "Node with uid " << uid << " needed by [" << buf.partitions[p] << "] was not found in ["
                                << mpi::rank() << "]." << std::endl;
                 ATLAS_ASSERT(false);
             }
@@ -833,41 +978,34 @@ public:
     void add_nodes(Buffers& buf) {
         ATLAS_TRACE();
 
-        const idx_t mpi_size = static_cast<idx_t>(mpi::size());
+        const idx_t nb_partitions = buf.size();
 
         mesh::Nodes& nodes = mesh.nodes();
         int nb_nodes       = nodes.size();
 
         // Nodes might be duplicated from different Tasks. We need to identify
         // unique entries
-        std::vector<uid_t> node_uid(nb_nodes);
-        std::set<uid_t> new_node_uid;
+        util::FlatHashSet<uid_t> node_uid;
         {
             ATLAS_TRACE("compute node_uid");
-            for (int jnode = 0; jnode < nb_nodes; ++jnode) {
-                node_uid[jnode] = compute_uid(jnode);
-            }
-            std::sort(node_uid.begin(), node_uid.end());
-        }
-        auto node_already_exists = [&node_uid, &new_node_uid](uid_t uid) {
-            std::vector<uid_t>::iterator it = std::lower_bound(node_uid.begin(), node_uid.end(), uid);
-            bool not_found                  = (it == node_uid.end() || uid < *it);
-            if (not_found) {
-                bool inserted = new_node_uid.insert(uid).second;
-                return not inserted;
+            size_t nb_recv_nodes = 0;
+            for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
+                nb_recv_nodes += buf.node_glb_idx[jpart].size();
             }
-            else {
-                return true;
+            node_uid.reserve(nb_nodes + nb_recv_nodes);
+            for (int jnode = 0; jnode < nb_nodes; ++jnode) {
+                node_uid.insert(compute_uid(jnode));
             }
-        };
+        }
+        auto node_already_exists = [&node_uid](uid_t uid) { return not node_uid.insert(uid).second; };
 
-        std::vector<std::vector<int>> rfn_idx(mpi_size);
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        std::vector<std::vector<int>> rfn_idx(nb_partitions);
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             rfn_idx[jpart].reserve(buf.node_glb_idx[jpart].size());
         }
 
         int nb_new_nodes = 0;
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             const idx_t nb_nodes_on_part = static_cast<idx_t>(buf.node_glb_idx[jpart].size());
             for (idx_t n = 0; n < nb_nodes_on_part; ++n) {
                 std::array<double,2> crd{buf.node_xy[jpart][n * 2 + XX], buf.node_xy[jpart][n * 2 + YY]};
@@ -897,7 +1035,7 @@ public:
         // Add new nodes
         // -------------
         int new_node = 0;
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             for (size_t n = 0; n < rfn_idx[jpart].size(); ++n) {
                 int loc_idx   = nb_nodes + new_node;
                 halo(loc_idx) = halosize + 1;
@@ -941,45 +1079,41 @@ public:
     void add_elements(Buffers& buf) {
         ATLAS_TRACE();
 
-        const idx_t mpi_size = static_cast<idx_t>(mpi::size());
-        auto cell_gidx       = array::make_view<gidx_t, 1>(mesh.cells().global_index());
+        const idx_t nb_partitions = buf.size();
+        auto cell_gidx            = array::make_view<gidx_t, 1>(mesh.cells().global_index());
         // Elements might be duplicated from different Tasks. We need to identify
         // unique entries
         int nb_elems = mesh.cells().size();
-        //    std::set<uid_t> elem_uid;
-        std::vector<uid_t> elem_uid(2 * nb_elems);
-        std::set<uid_t> new_elem_uid;
+        util::FlatHashSet<uid_t> elem_uid;
         {
             ATLAS_TRACE("compute elem_uid");
+            std::vector<uid_t> existing_elem_uid(2 * nb_elems);
             atlas_omp_parallel_for (int jelem = 0; jelem < nb_elems; ++jelem) {
-                elem_uid[jelem * 2 + 0] = -compute_uid(elem_nodes->row(jelem));
-                elem_uid[jelem * 2 + 1] = cell_gidx(jelem);
+                existing_elem_uid[jelem * 2 + 0] = -compute_uid(elem_nodes->row(jelem));
+                existing_elem_uid[jelem * 2 + 1] = cell_gidx(jelem);
             }
-            omp::sort(elem_uid.begin(), elem_uid.end());
-        }
-        auto element_already_exists = [&elem_uid, &new_elem_uid](uid_t uid) -> bool {
-            std::vector<uid_t>::iterator it = std::lower_bound(elem_uid.begin(), elem_uid.end(), uid);
-            bool not_found                  = (it == elem_uid.end() || uid < *it);
-            if (not_found) {
-                bool inserted = new_elem_uid.insert(uid).second;
-                return not inserted;
+            size_t nb_recv_elems = 0;
+            for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
+                nb_recv_elems += buf.elem_glb_idx[jpart].size();
             }
-            else {
-                return true;
+            elem_uid.reserve(existing_elem_uid.size() + nb_recv_elems);
+            for (uid_t uid : existing_elem_uid) {
+                elem_uid.insert(uid);
             }
-        };
+        }
+        auto element_already_exists = [&elem_uid](uid_t uid) -> bool { return not elem_uid.insert(uid).second; };
 
         if (not status.new_periodic_ghost_cells.size()) {
             status.new_periodic_ghost_cells.resize(mesh.cells().nb_types());
         }
 
-        std::vector<std::vector<idx_t>> received_new_elems(mpi_size);
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        std::vector<std::vector<idx_t>> received_new_elems(nb_partitions);
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             received_new_elems[jpart].reserve(buf.elem_glb_idx[jpart].size());
         }
 
         idx_t nb_new_elems(0);
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             const idx_t nb_elems_from_part = static_cast<idx_t>(buf.elem_glb_idx[jpart].size());
             for (idx_t e = 0; e < nb_elems_from_part; ++e) {
                 if (element_already_exists(buf.elem_glb_idx[jpart][e]) == false) {
@@ -990,10 +1124,10 @@ public:
         }
 
         std::vector<std::vector<std::vector<int>>> elements_of_type(mesh.cells().nb_types(),
-                                                                    std::vector<std::vector<int>>(mpi_size));
+                                                                    std::vector<std::vector<int>>(nb_partitions));
         std::vector<idx_t> nb_elements_of_type(mesh.cells().nb_types(), 0);
 
-        for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+        for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
             for (const idx_t ielem : received_new_elems[jpart]) {
                 elements_of_type[buf.elem_type[jpart][ielem]][jpart].emplace_back(ielem);
                 ++nb_elements_of_type[buf.elem_type[jpart][ielem]];
@@ -1021,7 +1155,7 @@ public:
 
             // Copy information in new elements
             idx_t new_elem(0);
-            for (idx_t jpart = 0; jpart < mpi_size; ++jpart) {
+            for (idx_t jpart = 0; jpart < nb_partitions; ++jpart) {
                 for (const idx_t jelem : elems[jpart]) {
                     int loc_idx                = new_elems_pos + new_elem;
                     elem_type_glb_idx(loc_idx) = std::abs(buf.elem_glb_idx[jpart][jelem]);
@@ -1043,21 +1177,40 @@ public:
         }
     }
 
-    std::vector<std::vector<idx_t>> gather_nb_elements() {
-        idx_t nb_types = mesh.cells().nb_types();
-        idx_t mpi_size = mpi::comm().size();
+    /// Number of elements per type for each of the given partitions (which must include this partition)
+    std::vector<std::vector<idx_t>> gather_nb_elements(const std::vector<idx_t>& partitions) {
+        const eckit::mpi::Comm& comm = mpi::comm();
+        const idx_t rank             = static_cast<idx_t>(comm.rank());
+        const idx_t nb_types         = mesh.cells().nb_types();
+        const idx_t nb_partitions    = static_cast<idx_t>(partitions.size());
+        const int tag                = 2;
         std::vector<idx_t> elems_per_type(nb_types);
         for (idx_t t = 0; t < nb_types; ++t) {
             elems_per_type[t] = mesh.cells().elements(t).size();
         }
-        atlas::mpi::Buffer<idx_t, 1> recv(mpi_size);
-        ATLAS_TRACE_MPI(ALLGATHER) { mpi::comm().allGatherv(elems_per_type.begin(), elems_per_type.end(), recv); }
 
-        std::vector<std::vector<idx_t>> result(nb_types, std::vector<idx_t>(mpi_size));
-        for (idx_t p = 0; p < mpi_size; ++p) {
-            auto recv_p = recv[p];
+        std::vector<idx_t> recv(nb_partitions * nb_types);
+        std::vector<eckit::mpi::Request> requests;
+        requests.reserve(2 * nb_partitions);
+        ATLAS_TRACE_MPI(ALLTOALL) {
+            for (idx_t j = 0; j < nb_partitions; ++j) {
+                if (partitions[j] == rank) {
+                    std::copy(elems_per_type.begin(), elems_per_type.end(), recv.begin() + j * nb_types);
+                }
+                else {
+                    requests.push_back(comm.iReceive(recv.data() + j * nb_types, nb_types, partitions[j], tag));
+                    requests.push_back(comm.iSend(elems_per_type.data(), nb_types, partitions[j], tag));
+                }
+            }
+            for (auto& request : requests) {
+                comm.wait(request);
+            }
+        }
+
+        std::vector<std::vector<idx_t>> result(nb_types, std::vector<idx_t>(nb_partitions));
+        for (idx_t j = 0; j < nb_partitions; ++j) {
             for (idx_t t = 0; t < nb_types; ++t) {
-                result[t][p] = recv_p[t];
+                result[t][j] = recv[j * nb_types + t];
             }
         }
         return result;
@@ -1065,18 +1218,25 @@ public:
 
 
     void add_buffers(Buffers& buf) {
+        // Partitions that can own elements in this mesh: the exchange partitions and this partition
+        std::vector<idx_t> partitions = buf.partitions;
+        const idx_t rank              = static_cast<idx_t>(mpi::rank());
+        if (not std::binary_search(partitions.begin(), partitions.end(), rank)) {
+            partitions.insert(std::upper_bound(partitions.begin(), partitions.end(), rank), rank);
+        }
+
         add_nodes(buf);
 
-        auto nb_elements_pre = gather_nb_elements();
+        auto nb_elements_pre = gather_nb_elements(partitions);
 
         add_elements(buf);
 
-        auto nb_elements_post = gather_nb_elements();
+        auto nb_elements_post = gather_nb_elements(partitions);
 
         // Renumber remote_index as the number of elements per type might have grown
         {
-            auto nb_partitions = mpi::comm().size();
-            auto nb_types      = mesh.cells().nb_types();
+            const idx_t nb_partitions = static_cast<idx_t>(partitions.size());
+            auto nb_types             = mesh.cells().nb_types();
 
             std::vector<std::vector<idx_t>> accumulated_diff(nb_types, std::vector<idx_t>(nb_partitions));
             for (idx_t t = 1; t < nb_types; ++t) {
@@ -1094,7 +1254,13 @@ public:
                 auto& accumulated_diff_t = accumulated_diff[t];
 
                 for (idx_t elem = 0; elem < elements.size(); ++elem) {
-                    ridx(elem) += accumulated_diff_t[partition(elem)];
+                    auto found = std::lower_bound(partitions.begin(), partitions.end(), partition(elem));
+                    if (found == partitions.end() || *found != partition(elem)) {
+                        throw_Exception("Element owned by partition " + std::to_string(partition(elem)) +
+                                            " which is not within halo distance in the partition graph",
+                                        Here());
+                    }
+                    ridx(elem) += accumulated_diff_t[found - partitions.begin()];
                 }
             }
         }
@@ -1104,82 +1270,58 @@ public:
 };
 
 namespace {
-void gather_bdry_nodes(const BuildHaloHelper& helper, const std::vector<uid_t>& send,
-                       atlas::mpi::Buffer<uid_t, 1>& recv, bool periodic = false) {
-    auto& comm = mpi::comm();
-#ifndef ATLAS_103
-    /* deprecated */
-    ATLAS_TRACE("gather_bdry_nodes old way");
-    {
-        ATLAS_TRACE_MPI(ALLGATHER) { comm.allGatherv(send.begin(), send.end(), recv); }
-    }
-#else
+/// Send uid of boundary nodes to given partitions, and receive theirs
+void gather_bdry_nodes(const std::vector<idx_t>& partitions, const std::vector<uid_t>& send,
+                       std::vector<std::vector<uid_t>>& recv) {
     ATLAS_TRACE();
+    const eckit::mpi::Comm& comm = mpi::comm();
+    const idx_t nb_partitions    = static_cast<idx_t>(partitions.size());
+    const int counts_tag         = 0;
+    const int buffer_tag         = 1;
 
-    Mesh::PartitionGraph::Neighbours neighbours = helper.mesh.nearestNeighbourPartitions();
-    if (periodic) {
-        // add own rank to neighbours to allow periodicity with self (pole caps)
-        idx_t rank = comm.rank();
-        neighbours.insert(std::upper_bound(neighbours.begin(), neighbours.end(), rank), rank);
-    }
-
-    const idx_t mpi_size = comm.size();
-    const int counts_tag = 0;
-    const int buffer_tag = 1;
+    std::vector<eckit::mpi::Request> send_requests(nb_partitions);
+    std::vector<eckit::mpi::Request> recv_requests(nb_partitions);
 
-    std::vector<eckit::mpi::Request> counts_requests;
-    counts_requests.reserve(neighbours.size());
-    std::vector<eckit::mpi::Request> buffer_requests;
-    buffer_requests.reserve(neighbours.size());
+    long sendcnt = static_cast<long>(send.size());
+    std::vector<long> recvcnt(nb_partitions);
 
-    int sendcnt = send.size();
     ATLAS_TRACE_MPI(ISEND) {
-        for (idx_t to : neighbours) {
-            counts_requests.push_back(comm.iSend(sendcnt, to, counts_tag));
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            send_requests[j] = comm.iSend(sendcnt, partitions[j], counts_tag);
         }
     }
-
-    recv.counts.assign(0, mpi_size);
-
     ATLAS_TRACE_MPI(IRECEIVE) {
-        for (idx_t from : neighbours) {
-            counts_requests.push_back(comm.iReceive(recv.counts[from], from, counts_tag));
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            recv_requests[j] = comm.iReceive(recvcnt[j], partitions[j], counts_tag);
         }
     }
-
-    ATLAS_TRACE_MPI(ISEND) {
-        for (idx_t to : neighbours) {
-            buffer_requests.push_back(comm.iSend(send.data(), send.size(), to, buffer_tag));
-        }
-    }
-
     ATLAS_TRACE_MPI(WAIT) {
-        for (auto request : counts_requests) {
-            comm.wait(request);
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            comm.wait(send_requests[j]);
+            comm.wait(recv_requests[j]);
         }
     }
 
-    recv.displs[0] = 0;
-    recv.cnt       = recv.counts[0];
-    for (idx_t jpart = 1; jpart < mpi_size; ++jpart) {
-        recv.displs[jpart] = recv.displs[jpart - 1] + recv.counts[jpart - 1];
-        recv.cnt += recv.counts[jpart];
-    }
-    recv.buffer.resize(recv.cnt);
-
+    recv.resize(nb_partitions);
     ATLAS_TRACE_MPI(IRECEIVE) {
-        for (idx_t from : neighbours) {
-            buffer_requests.push_back(
-                comm.iReceive(recv.buffer.data() + recv.displs[from], recv.counts[from], from, buffer_tag));
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            recv[j].resize(recvcnt[j]);
+            recv_requests[j] = comm.iReceive(recv[j].data(), recv[j].size(), partitions[j], buffer_tag);
+        }
+    }
+    ATLAS_TRACE_MPI(ISEND) {
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            send_requests[j] = comm.iSend(send.data(), send.size(), partitions[j], buffer_tag);
         }
     }
-
     ATLAS_TRACE_MPI(WAIT) {
-        for (auto request : buffer_requests) {
-            comm.wait(request);
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            comm.wait(recv_requests[j]);
+        }
+        for (idx_t j = 0; j < nb_partitions; ++j) {
+            comm.wait(send_requests[j]);
         }
     }
-#endif
 }
 }  // namespace
 
@@ -1193,13 +1335,18 @@ void increase_halo_interior(BuildHaloHelper& helper) {
         build_lookup_uid2node(helper.mesh, helper.uid2node);
     }
 
+    // Only partitions that can own elements of the new halo are communicated with
+    const std::vector<idx_t> partitions = halo_partitions(helper.mesh, helper.halosize + 1, /*include_self*/ false,
+                                                          helper.builder_.all_partitions_);
+    const idx_t nb_partitions           = static_cast<idx_t>(partitions.size());
+
     // All buffers needed to move elements and nodes
-    BuildHaloHelper::Buffers sendmesh(helper.mesh);
-    BuildHaloHelper::Buffers recvmesh(helper.mesh);
+    BuildHaloHelper::Buffers sendmesh(partitions);
+    BuildHaloHelper::Buffers recvmesh(partitions);
 
     // 1) Find boundary nodes of this partition:
 
-    accumulate_partition_bdry_nodes(helper.mesh, helper.halosize, helper.bdry_nodes);
+    accumulate_partition_bdry_nodes(helper.mesh, helper.bdry_nodes);
     const std::vector<idx_t>& bdry_nodes = helper.bdry_nodes;
     const idx_t nb_bdry_nodes            = static_cast<idx_t>(bdry_nodes.size());
 
@@ -1210,29 +1357,22 @@ void increase_halo_interior(BuildHaloHelper& helper) {
         send_bdry_nodes_uid[jnode] = helper.compute_uid(bdry_nodes[jnode]);
     }
 
-    idx_t mpi_size = mpi::size();
-    atlas::mpi::Buffer<uid_t, 1> recv_bdry_nodes_uid_from_parts(mpi_size);
+    std::vector<std::vector<uid_t>> recv_bdry_nodes_uid_from_parts;
 
-    gather_bdry_nodes(helper, send_bdry_nodes_uid, recv_bdry_nodes_uid_from_parts);
+    gather_bdry_nodes(partitions, send_bdry_nodes_uid, recv_bdry_nodes_uid_from_parts);
 
     {
         runtime::trace::Barriers set_barriers(false);
         runtime::trace::Logging set_logging(false);
-#ifndef ATLAS_103
-    /* deprecated */
-    atlas_omp_parallel_for (idx_t jpart = 0; jpart < mpi_size; ++jpart)
-#else
-    const Mesh::PartitionGraph::Neighbours neighbours = helper.mesh.nearestNeighbourPartitions();
-    for (idx_t jpart : neighbours)
-#endif
+    atlas_omp_parallel_for (idx_t jpart = 0; jpart < nb_partitions; ++jpart)
     {
         // 3) Find elements and nodes completing these elements in
         //    other tasks that have my nodes through its UID
 
-        mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
+        const std::vector<uid_t>& recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements(helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                             found_bdry_nodes_uid);
@@ -1243,7 +1383,7 @@ void increase_halo_interior(BuildHaloHelper& helper) {
     }
 
     // 5) Now communicate all buffers
-    helper.all_to_all(sendmesh, recvmesh);
+    helper.exchange(sendmesh, recvmesh);
 
 // 6) Adapt mesh
 #ifdef DEBUG_OUTPUT
@@ -1297,14 +1437,20 @@ void increase_halo_periodic(BuildHaloHelper& helper, const PeriodicPoints& perio
     // fail)
     build_lookup_uid2node(helper.mesh, helper.uid2node);
 
+    // Only partitions that can own elements of the new halo are communicated with,
+    // including this partition to allow periodicity with self (pole caps)
+    const std::vector<idx_t> partitions = halo_partitions(helper.mesh, helper.halosize + 1, /*include_self*/ true,
+                                                          helper.builder_.all_partitions_);
+    const idx_t nb_partitions           = static_cast<idx_t>(partitions.size());
+
     // All buffers needed to move elements and nodes
-    BuildHaloHelper::Buffers sendmesh(helper.mesh);
-    BuildHaloHelper::Buffers recvmesh(helper.mesh);
+    BuildHaloHelper::Buffers sendmesh(partitions);
+    BuildHaloHelper::Buffers recvmesh(partitions);
 
     // 1) Find boundary nodes of this partition:
 
     if (!helper.bdry_nodes.size()) {
-        accumulate_partition_bdry_nodes(helper.mesh, helper.halosize, helper.bdry_nodes);
+        accumulate_partition_bdry_nodes(helper.mesh, helper.bdry_nodes);
     }
 
     std::vector<idx_t> bdry_nodes = filter_nodes(helper.bdry_nodes, periodic_points);
@@ -1322,34 +1468,23 @@ void increase_halo_periodic(BuildHaloHelper& helper, const PeriodicPoints& perio
         send_bdry_nodes_uid[jnode] = util::unique_lonlat(crd);
     }
 
-    idx_t mpi_size = mpi::size();
-    atlas::mpi::Buffer<uid_t, 1> recv_bdry_nodes_uid_from_parts(mpi_size);
+    std::vector<std::vector<uid_t>> recv_bdry_nodes_uid_from_parts;
 
-    gather_bdry_nodes(helper, send_bdry_nodes_uid, recv_bdry_nodes_uid_from_parts,
-                      /* periodic = */ true);
+    gather_bdry_nodes(partitions, send_bdry_nodes_uid, recv_bdry_nodes_uid_from_parts);
 
     {
         runtime::trace::Barriers set_barriers(false);
         runtime::trace::Logging set_logging(false);
-#ifndef ATLAS_103
-    /* deprecated */
-    atlas_omp_parallel_for (idx_t jpart = 0; jpart < mpi_size; ++jpart)
-#else
-    Mesh::PartitionGraph::Neighbours neighbours = helper.mesh.nearestNeighbourPartitions();
-    // add own rank to neighbours to allow periodicity with self (pole caps)
-    idx_t rank = mpi::rank();
-    neighbours.insert(std::upper_bound(neighbours.begin(), neighbours.end(), rank), rank);
-    for (idx_t jpart : neighbours)
-#endif
+    atlas_omp_parallel_for (idx_t jpart = 0; jpart < nb_partitions; ++jpart)
     {
 
         // 3) Find elements and nodes completing these elements in
         //    other tasks that have my nodes through its UID
 
-        atlas::mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
+        const std::vector<uid_t>& recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements(helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                             found_bdry_nodes_uid);
@@ -1360,7 +1495,7 @@ void increase_halo_periodic(BuildHaloHelper& helper, const PeriodicPoints& perio
     }
 
     // 5) Now communicate all buffers
-    helper.all_to_all(sendmesh, recvmesh);
+    helper.exchange(sendmesh, recvmesh);
 
 // 6) Adapt mesh
 #ifdef DEBUG_OUTPUT
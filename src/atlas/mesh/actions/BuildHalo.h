@@ -32,6 +32,10 @@ private:
 public:
     std::vector<idx_t> periodic_points_local_index_;
     std::vector<std::vector<idx_t>> periodic_cells_local_index_;
+
+    /// Exchange with all partitions rather than only with those within reach in the partition graph.
+    /// This is how halos were built before the neighbour-only exchange, and serves as its reference.
+    bool all_partitions_{false};
 };
 
 /// @brief Enlarge each partition of the mesh with a halo of elements
@@ -32,8 +32,11 @@
 #include "atlas/mesh/actions/BuildEdges.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
@@ -59,12 +62,15 @@ struct Sort {
     }
     gidx_t g;
     idx_t i;
-    bool operator<(const Sort& other) const { return (g < other.g); }
+    // Ties are broken by index, so the (unstable) parallel sort gives the same order as a stable sort
+    bool operator<(const Sort& other) const { return (g < other.g) || (g == other.g && i < other.i); }
 };
 }  // anonymous namespace
 
 void BuildNode2CellConnectivity::operator()() {
+    ATLAS_TRACE("BuildNode2CellConnectivity");
     mesh::Nodes& nodes   = mesh_.nodes();
+    const idx_t nb_nodes = nodes.size();
     const idx_t nb_cells = mesh_.cells().size();
 
     mesh::Nodes::Connectivity& node_to_cell = nodes.cell_connectivity();
@@ -72,34 +78,53 @@ void BuildNode2CellConnectivity::operator()() {
 
     const mesh::HybridElements::Connectivity& cell_node_connectivity = mesh_.cells().node_connectivity();
 
-    std::vector<idx_t> to_cell_size(nodes.size(), 0);
-    for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
-        for (idx_t j = 0; j < cell_node_connectivity.cols(jcell); ++j) {
-            ++to_cell_size[cell_node_connectivity(jcell, j)];
-        }
-    }
-
-    node_to_cell.add(nodes.size(), to_cell_size.data());
-
-    for (idx_t jnode = 0; jnode < nodes.size(); ++jnode) {
-        to_cell_size[jnode] = 0;
-    }
-
     UniqueLonLat compute_uid(mesh_);
     std::vector<Sort> cell_sort(nb_cells);
-    for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
+    atlas_omp_parallel_for(idx_t jcell = 0; jcell < nb_cells; ++jcell) {
         cell_sort[jcell] = Sort(compute_uid(cell_node_connectivity.row(jcell)), jcell);
     }
 
+    ATLAS_TRACE_SCOPE("sort") { omp::sort(cell_sort.begin(), cell_sort.end()); }
+
+    // The sorted cells are split in contiguous chunks, and every chunk counts its cells per node in its own
+    // histogram. A prefix sum over the chunks then gives for every node the column where each chunk starts
+    // inserting, so that cells are inserted in sorted order without atomics, independent of the number of threads.
+    const int nb_chunks = atlas_omp_get_max_threads();
+    auto chunk_begin    = [&](int chunk) { return static_cast<idx_t>((size_t(nb_cells) * chunk) / nb_chunks); };
+    std::vector<std::vector<idx_t>> histogram(nb_chunks);
+
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        auto& count = histogram[chunk];
+        count.assign(nb_nodes, 0);
+        for (idx_t jcell = chunk_begin(chunk); jcell < chunk_begin(chunk + 1); ++jcell) {
+            const idx_t icell = cell_sort[jcell].i;
+            for (idx_t j = 0; j < cell_node_connectivity.cols(icell); ++j) {
+                ++count[cell_node_connectivity(icell, j)];
+            }
+        }
+    }
+
+    std::vector<idx_t> to_cell_size(nb_nodes);
+    atlas_omp_parallel_for(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        idx_t size = 0;
+        for (int chunk = 0; chunk < nb_chunks; ++chunk) {
+            const idx_t count       = histogram[chunk][jnode];
+            histogram[chunk][jnode] = size;
+            size += count;
+        }
+        to_cell_size[jnode] = size;
+    }
 
-    std::stable_sort(cell_sort.data(), cell_sort.data() + nb_cells);
+    node_to_cell.add(nb_nodes, to_cell_size.data());
 
-    for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
-        idx_t icell = cell_sort[jcell].i;
-        ATLAS_ASSERT(icell < nb_cells);
-        for (idx_t j = 0; j < cell_node_connectivity.cols(icell); ++j) {
-            idx_t node = cell_node_connectivity(icell, j);
-            node_to_cell.set(node, to_cell_size[node]++, icell);
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        auto& column = histogram[chunk];
+        for (idx_t jcell = chunk_begin(chunk); jcell < chunk_begin(chunk + 1); ++jcell) {
+            const idx_t icell = cell_sort[jcell].i;
+            for (idx_t j = 0; j < cell_node_connectivity.cols(icell); ++j) {
+                const idx_t node = cell_node_connectivity(icell, j);
+                node_to_cell.set(node, column[node]++, icell);
+            }
         }
     }
 }
@@ -25,10 +25,12 @@
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/radix_sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/FlatHashMap.h"
 #include "atlas/util/PeriodicTransform.h"
 #include "atlas/util/Unique.h"
 
@@ -86,6 +88,7 @@ struct Node {
     gidx_t g;
     idx_t i;
     bool operator<(const Node& other) const { return (g < other.g); }
+    static gidx_t key(const Node& node) { return node.g; }
 };
 
 }  // namespace
@@ -222,7 +225,7 @@ void renumber_nodes_glb_idx(mesh::Nodes& nodes) {
         for (idx_t jnode = 0; jnode < glb_id.shape(0); ++jnode) {
             node_sort.emplace_back(glb_id(jnode), jnode);
         }
-        std::sort(node_sort.begin(), node_sort.end());
+        omp::radix_sort(node_sort.begin(), node_sort.end(), Node::key);
     }
 
     // Assume edge gid start
@@ -293,7 +296,7 @@ Field& build_nodes_remote_idx(mesh::Nodes& nodes) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::FlatHashMap<uid_t, int> lookup(nb_nodes);
     for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
         uid_t uid = compute_uid(jnode);
 
@@ -330,7 +333,7 @@ Field& build_nodes_remote_idx(mesh::Nodes& nodes) {
             uid_t uid = recv_node[jnode * varsize + 0];
             int inode = recv_node[jnode * varsize + 1];
             send_found[proc[jpart]].push_back(inode);
-            send_found[proc[jpart]].push_back(lookup.count(uid) ? lookup[uid] : -1);
+            send_found[proc[jpart]].push_back(lookup.contains(uid) ? lookup[uid] : -1);
         }
     }
 
@@ -442,7 +445,7 @@ Field& build_edges_partition(Mesh& mesh) {
 
     std::vector<gidx_t> bdry_edges;
     bdry_edges.reserve(nb_edges);
-    std::map<gidx_t, idx_t> global_to_local;
+    util::FlatHashMap<gidx_t, idx_t> global_to_local(nb_edges);
 
 
     PeriodicTransform transform_periodic_east(-360.);
@@ -573,7 +576,7 @@ Field& build_edges_partition(Mesh& mesh) {
         }
         edge_part(jedge) = p;
     }
-    std::sort(bdry_edges.begin(), bdry_edges.end());
+    omp::radix_sort(bdry_edges.begin(), bdry_edges.end());
     auto is_bdry_edge = [&bdry_edges](gidx_t gid) {
         std::vector<uid_t>::iterator it = std::lower_bound(bdry_edges.begin(), bdry_edges.end(), gid);
         bool found                      = !(it == bdry_edges.end() || gid < *it);
@@ -792,7 +795,7 @@ Field& build_edges_remote_idx(Mesh& mesh) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::FlatHashMap<uid_t, int> lookup(nb_edges);
 
     PeriodicTransform transform;
 
@@ -863,7 +866,6 @@ Field& build_edges_remote_idx(Mesh& mesh) {
     std::vector<std::vector<int>> send_found(mpi::size());
     std::vector<std::vector<int>> recv_found(mpi::size());
 
-    std::map<uid_t, int>::iterator found;
     for (idx_t jpart = 0; jpart < nparts; ++jpart) {
         const std::vector<uid_t>& recv_edge = recv_needed[jpart];
         const idx_t nb_recv_edges           = idx_t(recv_edge.size()) / varsize;
@@ -872,7 +874,7 @@ Field& build_edges_remote_idx(Mesh& mesh) {
         for (idx_t jedge = 0; jedge < nb_recv_edges; ++jedge) {
             uid_t recv_uid = recv_edge[jedge * varsize + 0];
             int recv_idx   = recv_edge[jedge * varsize + 1];
-            found          = lookup.find(recv_uid);
+            auto found     = lookup.find(recv_uid);
             if (found != lookup.end()) {
                 send_found[jpart].push_back(recv_idx);
                 send_found[jpart].push_back(found->second);
@@ -986,7 +988,7 @@ Field& build_edges_global_idx(Mesh& mesh) {
     for (idx_t jedge = 0; jedge < glb_edge_id.shape(0); ++jedge) {
         edge_sort.emplace_back(Node(glb_edge_id(jedge), jedge));
     }
-    std::sort(edge_sort.begin(), edge_sort.end());
+    omp::radix_sort(edge_sort.begin(), edge_sort.end(), Node::key);
 
     // Assume edge gid start
     uid_t gid(0);
@@ -1058,7 +1060,7 @@ Field& build_cells_remote_idx(mesh::Cells& cells, const mesh::Nodes& nodes) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::FlatHashMap<uid_t, int> lookup(nb_cells);
     for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
         uid_t uid = compute_uid(jcell);
 
@@ -1095,7 +1097,7 @@ Field& build_cells_remote_idx(mesh::Cells& cells, const mesh::Nodes& nodes) {
             uid_t uid = recv_cell[jcell * varsize + 0];
             int icell = recv_cell[jcell * varsize + 1];
             send_found[proc[jpart]].push_back(icell);
-            send_found[proc[jpart]].push_back(lookup.count(uid) ? lookup[uid] : -1);
+            send_found[proc[jpart]].push_back(lookup.contains(uid) ? lookup[uid] : -1);
         }
     }
 
@@ -24,6 +24,8 @@
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -72,10 +74,10 @@ struct ReorderField<Value, 1> {
         idx_t size = end - begin;
         array::ArrayT<Value> tmp_array(size);
         auto tmp = array::make_view<Value, Rank>(tmp_array);
-        for (idx_t n = 0; n < size; ++n) {
+        atlas_omp_parallel_for(idx_t n = 0; n < size; ++n) {
             tmp(n) = array(begin + n);
         }
-        for (idx_t n = 0; n < size; ++n) {
+        atlas_omp_parallel_for(idx_t n = 0; n < size; ++n) {
             array(begin + n) = tmp(order[n]);
         }
         return field.name();
@@ -93,13 +95,14 @@ struct ReorderField<Value, 2> {
         idx_t size = end - begin;
         array::ArrayT<Value> tmp_array(size, field.shape(1));
         auto tmp = array::make_view<Value, Rank>(tmp_array);
-        for (idx_t n = 0; n < size; ++n) {
-            for (idx_t v = 0; v < array.shape(1); ++v) {
+        const idx_t nb_vars = array.shape(1);
+        atlas_omp_parallel_for(idx_t n = 0; n < size; ++n) {
+            for (idx_t v = 0; v < nb_vars; ++v) {
                 tmp(n, v) = array(begin + n, v);
             }
         }
-        for (idx_t n = 0; n < size; ++n) {
-            for (idx_t v = 0; v < array.shape(1); ++v) {
+        atlas_omp_parallel_for(idx_t n = 0; n < size; ++n) {
+            for (idx_t v = 0; v < nb_vars; ++v) {
                 array(begin + n, v) = tmp(order[n], v);
             }
         }
@@ -146,14 +149,23 @@ std::string reorder_field(Field& field, const std::vector<idx_t>& order, idx_t b
 // ------------------------------------------------------------------
 
 void update_connectivity(mesh::HybridElements::Connectivity& connectivity, const std::vector<idx_t>& order) {
+    const idx_t size = static_cast<idx_t>(order.size());
     for (idx_t b = 0; b < connectivity.blocks(); ++b) {
-        auto& block = connectivity.block(b);
-        for (idx_t r = 0; r < block.rows(); ++r) {
-            for (idx_t c = 0; c < block.cols(); ++c) {
+        auto& block        = connectivity.block(b);
+        const idx_t rows   = block.rows();
+        const idx_t cols   = block.cols();
+        idx_t out_of_range = 0;
+        atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+            for (idx_t c = 0; c < cols; ++c) {
                 idx_t n = block(r, c);
-                block.set(r, c, order.at(n));
+                if (n < 0 || n >= size) {
+                    atlas_omp_critical { ++out_of_range; }
+                    continue;
+                }
+                block.set(r, c, order[n]);
             }
         }
+        ATLAS_ASSERT(out_of_range == 0);
     }
 }
 
@@ -163,16 +175,11 @@ void reorder_connectivity(BlockConnectivity& connectivity, const std::vector<idx
     ATLAS_ASSERT(connectivity.rows() == static_cast<idx_t>(order.size()));
     BlockConnectivity tmp;
     tmp.add(connectivity.rows(), connectivity.cols(), connectivity.data(), true);
-    for (idx_t r = 0; r < connectivity.rows(); ++r) {
-        for (idx_t c = 0; c < connectivity.cols(); ++c) {
-            if (connectivity(r, c) != tmp(r, c)) {
-                ATLAS_DEBUG_VAR(r);
-                ATLAS_DEBUG_VAR(c);
-                ATLAS_DEBUG_VAR(connectivity(r, c));
-                ATLAS_DEBUG_VAR(tmp(r, c));
-            }
-            ATLAS_ASSERT(connectivity(r, c) == tmp(r, c));
-            connectivity.set(r, c, tmp(order.at(r), c));
+    const idx_t rows = connectivity.rows();
+    const idx_t cols = connectivity.cols();
+    atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+        for (idx_t c = 0; c < cols; ++c) {
+            connectivity.set(r, c, tmp(order[r], c));
         }
     }
 }
@@ -180,8 +187,9 @@ void reorder_connectivity(BlockConnectivity& connectivity, const std::vector<idx
 // ------------------------------------------------------------------
 
 void ReorderImpl::reorderNodes(Mesh& mesh, const std::vector<idx_t>& order) {
+    ATLAS_TRACE("ReorderImpl::reorderNodes");
     std::vector<idx_t> order_inverse(order.size());
-    for (idx_t i = 0; i < static_cast<idx_t>(order.size()); ++i) {
+    atlas_omp_parallel_for(idx_t i = 0; i < static_cast<idx_t>(order.size()); ++i) {
         order_inverse[order[i]] = i;
     }
 
@@ -205,22 +213,20 @@ void reorder_elements_using_nodes(Mesh& mesh, Mesh::HybridElements& elements) {
         auto& connectivity = elems.node_connectivity();
         idx_t nb_nodes     = elems.nb_nodes();
         idx_t nb_elems     = elems.size();
-        std::vector<std::pair<idx_t, idx_t>> node_lowest_index;
-        node_lowest_index.reserve(elems.size());
-        for (idx_t e = 0; e < nb_elems; ++e) {
+        std::vector<std::pair<idx_t, idx_t>> node_lowest_index(nb_elems);
+        atlas_omp_parallel_for(idx_t e = 0; e < nb_elems; ++e) {
             idx_t lowest = std::numeric_limits<idx_t>::max();
             for (idx_t n = 0; n < nb_nodes; ++n) {
                 lowest = std::min(lowest, connectivity(e, n));
             }
-            node_lowest_index.emplace_back(lowest, e);
+            node_lowest_index[e] = {lowest, e};
         }
-        std::sort(node_lowest_index.begin(), node_lowest_index.end());
-        std::vector<idx_t> order;
-        order.reserve(nb_elems);
-        for (const auto& pair : node_lowest_index) {
-            order.emplace_back(pair.second);
+        omp::sort(node_lowest_index.begin(), node_lowest_index.end());
+        std::vector<idx_t> order(nb_elems);
+        atlas_omp_parallel_for(idx_t e = 0; e < nb_elems; ++e) {
+            order[e] = node_lowest_index[e].second;
         }
-        for (idx_t ifield = 0; ifield < mesh.edges().nb_fields(); ++ifield) {
+        for (idx_t ifield = 0; ifield < elements.nb_fields(); ++ifield) {
             reorder_field(elements.field(ifield), order, elems.begin(), elems.end());
         }
 
@@ -231,12 +237,14 @@ void reorder_elements_using_nodes(Mesh& mesh, Mesh::HybridElements& elements) {
 // ------------------------------------------------------------------
 
 void ReorderImpl::reorderCellsUsingNodes(Mesh& mesh) {
+    ATLAS_TRACE("ReorderImpl::reorderCellsUsingNodes");
     reorder_elements_using_nodes(mesh, mesh.cells());
 }
 
 // ------------------------------------------------------------------
 
 void ReorderImpl::reorderEdgesUsingNodes(Mesh& mesh) {
+    ATLAS_TRACE("ReorderImpl::reorderEdgesUsingNodes");
     reorder_elements_using_nodes(mesh, mesh.edges());
 }
 
@@ -14,6 +14,7 @@
 
 #include "eckit/filesystem/PathName.h"
 
+#include "atlas/array/MakeView.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/IsGhostNode.h"
 #include "atlas/mesh/Mesh.h"
@@ -21,6 +22,7 @@
 #include "atlas/mesh/actions/WriteLoadBalanceReport.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/library/FloatingPointExceptions.h"
 
 using atlas::mesh::IsGhostNode;
@@ -56,6 +58,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
     std::vector<idx_t> nb_owned_edges(npart, 0);
     std::vector<idx_t> nb_ghost_edges(npart, 0);
     std::vector<double> nb_ghost_ratio_edges(npart, 0);
+    std::vector<idx_t> nb_cut_edges(npart, 0);
 
     {
         const mesh::Nodes& nodes = mesh.nodes();
@@ -102,24 +105,33 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
         const mesh::Nodes& nodes = mesh.nodes();
         IsGhostNode is_ghost(nodes);
         const mesh::HybridElements::Connectivity& edge_nodes = mesh.edges().node_connectivity();
+        auto partition                                       = array::make_view<int, 1>(nodes.partition());
         idx_t nb_edges                                       = mesh.edges().size();
         idx_t nowned(0);
         idx_t nghost(0);
+        idx_t ncut(0);
         for (idx_t j = 0; j < nb_edges; ++j) {
             if (is_ghost(edge_nodes(j, 0))) {
                 ++nghost;
             }
             else {
                 ++nowned;
+                // Owned edge connecting nodes of different partitions: contributes to communication volume
+                if (partition(edge_nodes(j, 0)) != partition(edge_nodes(j, 1))) {
+                    ++ncut;
+                }
             }
         }
 
         /// @note this could be improved by packing the 3 integers in a vector, and
         /// doing only comm() call
 
-        mpi::comm().gather(nb_edges, nb_total_edges, root);
-        mpi::comm().gather(nowned, nb_owned_edges, root);
-        mpi::comm().gather(nghost, nb_ghost_nodes, root);
+        ATLAS_TRACE_MPI(GATHER) {
+            mpi::comm().gather(nb_edges, nb_total_edges, root);
+            mpi::comm().gather(nowned, nb_owned_edges, root);
+            mpi::comm().gather(nghost, nb_ghost_edges, root);
+            mpi::comm().gather(ncut, nb_cut_edges, root);
+        }
     }
 
     if (mpi::rank() == 0) {
@@ -134,6 +146,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << "edges";
             ofs << std::setw(idt) << "oedges";
             ofs << std::setw(idt) << "gedges";
+            ofs << std::setw(idt) << "cedges";
         }
         ofs << "\n";
         ofs << std::setw(6) << "# tot ";
@@ -145,6 +158,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << std::accumulate(nb_total_edges.data(), nb_total_edges.data() + npart, 0);
             ofs << std::setw(idt) << std::accumulate(nb_owned_edges.data(), nb_owned_edges.data() + npart, 0);
             ofs << std::setw(idt) << std::accumulate(nb_ghost_edges.data(), nb_ghost_edges.data() + npart, 0);
+            ofs << std::setw(idt) << std::accumulate(nb_cut_edges.data(), nb_cut_edges.data() + npart, 0);
         }
         ofs << "\n";
         ofs << std::setw(6) << "# max ";
@@ -157,6 +171,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << *std::max_element(nb_total_edges.data(), nb_total_edges.data() + npart);
             ofs << std::setw(idt) << *std::max_element(nb_owned_edges.data(), nb_owned_edges.data() + npart);
             ofs << std::setw(idt) << *std::max_element(nb_ghost_edges.data(), nb_ghost_edges.data() + npart);
+            ofs << std::setw(idt) << *std::max_element(nb_cut_edges.data(), nb_cut_edges.data() + npart);
         }
         ofs << "\n";
         ofs << std::setw(6) << "# min ";
@@ -169,6 +184,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << *std::min_element(nb_total_edges.data(), nb_total_edges.data() + npart);
             ofs << std::setw(idt) << *std::min_element(nb_owned_edges.data(), nb_owned_edges.data() + npart);
             ofs << std::setw(idt) << *std::min_element(nb_ghost_edges.data(), nb_ghost_edges.data() + npart);
+            ofs << std::setw(idt) << *std::min_element(nb_cut_edges.data(), nb_cut_edges.data() + npart);
         }
         ofs << "\n";
         ofs << std::setw(6) << "# avg ";
@@ -182,8 +198,16 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << std::accumulate(nb_total_edges.data(), nb_total_edges.data() + npart, 0) / npart;
             ofs << std::setw(idt) << std::accumulate(nb_owned_edges.data(), nb_owned_edges.data() + npart, 0) / npart;
             ofs << std::setw(idt) << std::accumulate(nb_ghost_edges.data(), nb_ghost_edges.data() + npart, 0) / npart;
+            ofs << std::setw(idt) << std::accumulate(nb_cut_edges.data(), nb_cut_edges.data() + npart, 0) / npart;
         }
         ofs << "\n";
+        ofs << std::setw(6) << "# imb ";
+        ofs << std::setw(idt) << "";
+        ofs << std::setw(idt) << std::fixed << std::setprecision(3)
+            << static_cast<double>(*std::max_element(nb_owned_nodes.data(), nb_owned_nodes.data() + npart)) /
+                   (static_cast<double>(std::accumulate(nb_owned_nodes.data(), nb_owned_nodes.data() + npart, 0)) /
+                    static_cast<double>(npart));
+        ofs << "\n";
         ofs << "#----------------------------------------------------\n";
         ofs << "# PER TASK\n";
         ofs << std::setw(6) << "# part";
@@ -195,6 +219,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
             ofs << std::setw(idt) << "edges";
             ofs << std::setw(idt) << "oedges";
             ofs << std::setw(idt) << "gedges";
+            ofs << std::setw(idt) << "cedges";
         }
         ofs << "\n";
         for (idx_t jpart = 0; jpart < npart; ++jpart) {
@@ -207,6 +232,7 @@ void write_load_balance_report(const Mesh& mesh, std::ostream& ofs) {
                 ofs << std::setw(idt) << nb_total_edges[jpart];
                 ofs << std::setw(idt) << nb_owned_edges[jpart];
                 ofs << std::setw(idt) << nb_ghost_edges[jpart];
+                ofs << std::setw(idt) << nb_cut_edges[jpart];
             }
             ofs << "\n";
         }
@@ -0,0 +1,174 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/mesh/actions/WriteLocalityReport.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace mesh {
+namespace actions {
+
+namespace {
+
+struct Distance {
+    double sum{0};
+    size_t count{0};
+    idx_t max{0};
+
+    void add(idx_t d) {
+        sum += d;
+        ++count;
+        max = std::max(max, d);
+    }
+    void add(const Distance& other) {
+        sum += other.sum;
+        count += other.count;
+        max = std::max(max, other.max);
+    }
+    double average() const { return count ? sum / double(count) : 0.; }
+};
+
+/// Accumulate distances computed by f(n, distance) for n in [0,size) over all threads
+template <typename Functor>
+Distance accumulate_distance(idx_t size, const Functor& f) {
+    Distance total;
+    atlas_omp_parallel {
+        Distance thread_distance;
+        atlas_omp_for(idx_t n = 0; n < size; ++n) { f(n, thread_distance); }
+        atlas_omp_critical { total.add(thread_distance); }
+    }
+    return total;
+}
+
+template <typename Connectivity>
+idx_t lowest(const Connectivity& connectivity, idx_t e) {
+    idx_t l = std::numeric_limits<idx_t>::max();
+    for (idx_t c = 0; c < connectivity.cols(e); ++c) {
+        l = std::min(l, connectivity(e, c));
+    }
+    return l;
+}
+
+}  // namespace
+
+LocalityStatistics compute_locality_statistics(const Mesh& mesh) {
+    ATLAS_TRACE("compute_locality_statistics");
+    LocalityStatistics stats;
+    stats.nb_nodes = mesh.nodes().size();
+    stats.nb_edges = mesh.edges().size();
+    stats.nb_cells = mesh.cells().size();
+
+    const auto& edge2node = mesh.edges().node_connectivity();
+    const auto& cell2node = mesh.cells().node_connectivity();
+
+    Distance neighbours;
+    if (stats.nb_edges) {
+        neighbours = accumulate_distance(stats.nb_edges, [&](idx_t e, Distance& d) {
+            d.add(std::abs(edge2node(e, 0) - edge2node(e, 1)));
+        });
+    }
+    else {
+        neighbours = accumulate_distance(stats.nb_cells, [&](idx_t e, Distance& d) {
+            const idx_t nb_nodes = cell2node.cols(e);
+            for (idx_t c = 0; c < nb_nodes; ++c) {
+                d.add(std::abs(cell2node(e, c) - cell2node(e, (c + 1) % nb_nodes)));
+            }
+        });
+    }
+    stats.node_neighbour_distance = neighbours.average();
+    stats.node_bandwidth          = neighbours.max;
+
+    if (stats.nb_edges) {
+        std::vector<idx_t> first_edge(stats.nb_nodes, std::numeric_limits<idx_t>::max());
+        std::vector<idx_t> last_edge(stats.nb_nodes, -1);
+        for (idx_t e = 0; e < stats.nb_edges; ++e) {
+            for (idx_t c = 0; c < edge2node.cols(e); ++c) {
+                const idx_t n = edge2node(e, c);
+                first_edge[n] = std::min(first_edge[n], e);
+                last_edge[n]  = std::max(last_edge[n], e);
+            }
+        }
+        auto node2edge = accumulate_distance(stats.nb_nodes, [&](idx_t n, Distance& d) {
+            if (last_edge[n] >= 0) {
+                d.add(last_edge[n] - first_edge[n]);
+            }
+        });
+        stats.node2edge_span      = node2edge.average();
+        stats.node2edge_bandwidth = node2edge.max;
+
+        auto stride = accumulate_distance(stats.nb_edges - 1, [&](idx_t e, Distance& d) {
+            d.add(std::abs(lowest(edge2node, e + 1) - lowest(edge2node, e)));
+        });
+        stats.edge_stride = stride.average();
+    }
+
+    if (stats.nb_cells) {
+        auto span = accumulate_distance(stats.nb_cells, [&](idx_t e, Distance& d) {
+            idx_t lo = std::numeric_limits<idx_t>::max();
+            idx_t hi = std::numeric_limits<idx_t>::min();
+            for (idx_t c = 0; c < cell2node.cols(e); ++c) {
+                lo = std::min(lo, cell2node(e, c));
+                hi = std::max(hi, cell2node(e, c));
+            }
+            d.add(hi - lo);
+        });
+        stats.cell2node_span      = span.average();
+        stats.cell2node_bandwidth = span.max;
+
+        auto stride = accumulate_distance(stats.nb_cells - 1, [&](idx_t e, Distance& d) {
+            d.add(std::abs(lowest(cell2node, e + 1) - lowest(cell2node, e)));
+        });
+        stats.cell_stride = stride.average();
+    }
+    return stats;
+}
+
+void write_locality_report(const Mesh& mesh, std::ostream& out) {
+    auto stats = compute_locality_statistics(mesh);
+
+    // Formatted in a local stream, so that the flags and precision of "out" are left untouched
+    std::ostringstream report;
+    auto line = [&](const std::string& name, double average, idx_t maximum) {
+        report << std::setw(20) << std::left << name << std::setw(12) << std::right << std::fixed
+               << std::setprecision(2) << average << std::setw(12) << maximum << '\n';
+    };
+
+    report << "# locality report of partition " << mpi::rank() << " (nodes: " << stats.nb_nodes
+           << ", edges: " << stats.nb_edges << ", cells: " << stats.nb_cells << ")\n";
+    report << std::setw(20) << std::left << "# index distance" << std::setw(12) << std::right << "average"
+           << std::setw(12) << "maximum" << '\n';
+    line("node neighbours", stats.node_neighbour_distance, stats.node_bandwidth);
+    line("node-to-edge span", stats.node2edge_span, stats.node2edge_bandwidth);
+    line("cell-to-node span", stats.cell2node_span, stats.cell2node_bandwidth);
+    report << std::setw(20) << std::left << "edge stride" << std::setw(12) << std::right << stats.edge_stride << '\n';
+    report << std::setw(20) << std::left << "cell stride" << std::setw(12) << std::right << stats.cell_stride << '\n';
+    out << report.str() << std::flush;
+}
+
+// ------------------------------------------------------------------
+
+}  // namespace actions
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,58 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+class Mesh;
+namespace mesh {
+namespace actions {
+
+/// Measures of memory locality of the local mesh, to compare reorderings (e.g. "hilbert", "reverse_cuthill_mckee",
+/// "none") for kernels that loop over edges or cells and access their nodes.
+/// Index distances are differences of local indices; smaller values mean that connected entities are closer in memory.
+struct LocalityStatistics {
+    idx_t nb_nodes{0};
+    idx_t nb_edges{0};
+    idx_t nb_cells{0};
+
+    /// Average and maximum index distance between neighbouring nodes.
+    /// Neighbours are connected by an edge, or consecutive nodes of a cell if the mesh has no edges.
+    /// The maximum is the bandwidth of the node-to-node adjacency matrix.
+    double node_neighbour_distance{0};
+    idx_t node_bandwidth{0};
+
+    /// Average and maximum span (largest minus smallest index) of the edges connected to a node.
+    /// The maximum is the bandwidth of the node-to-edge connectivity.
+    double node2edge_span{0};
+    idx_t node2edge_bandwidth{0};
+
+    /// Average and maximum span of the nodes of a cell.
+    double cell2node_span{0};
+    idx_t cell2node_bandwidth{0};
+
+    /// Average index distance between the lowest nodes of consecutive edges, and of consecutive cells
+    double edge_stride{0};
+    double cell_stride{0};
+};
+
+LocalityStatistics compute_locality_statistics(const Mesh& mesh);
+
+void write_locality_report(const Mesh& mesh, std::ostream& out);
+
+// ------------------------------------------------------------------
+
+}  // namespace actions
+}  // namespace mesh
+}  // namespace atlas
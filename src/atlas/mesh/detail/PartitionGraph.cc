@@ -13,6 +13,8 @@
 #include "eckit/log/Bytes.h"
 #include "eckit/types/FloatCompare.h"
 
+#include "atlas/domain.h"
+#include "atlas/grid/Grid.h"
 #include "atlas/mesh/Elements.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
@@ -58,16 +60,34 @@ PartitionGraph* build_partition_graph(const MeshImpl& mesh) {
         }
     }
 
+    // Points on the periodic boundary are matched after wrapping x into [xmin, xmin + period), with the period
+    // taken from the domain of the grid. Without a grid, the mesh is assumed periodic over 360 degrees.
+    bool periodic = true;
+    double xmin   = 0.;
+    double period = 360.;
+    if (mesh.grid()) {
+        RectangularDomain domain(mesh.grid().domain());
+        if (domain) {
+            bool periodic_mesh = false;
+            mesh.metadata().get("periodic", periodic_mesh);
+            periodic = domain.zonal_band() || periodic_mesh;
+            xmin     = domain.xmin();
+            period   = domain.xmax() - domain.xmin();
+        }
+    }
+
     std::map<uidx_t, std::set<idx_t>> uid_2_parts;
     idx_t jpart = 0;
     for (const PolygonXY& _polygon : polygons) {
         for (const PointXY& pxy : _polygon) {
             PointLonLat pll = pxy;
-            if (eckit::types::is_strictly_greater(0., pll.lon())) {
-                pll.lon() += 360.;
-            }
-            if (eckit::types::is_approximately_greater_or_equal(pll.lon(), 360.)) {
-                pll.lon() -= 360.;
+            if (periodic) {
+                if (eckit::types::is_strictly_greater(xmin, pll.lon())) {
+                    pll.lon() += period;
+                }
+                if (eckit::types::is_approximately_greater_or_equal(pll.lon(), xmin + period)) {
+                    pll.lon() -= period;
+                }
             }
             uidx_t uid = util::unique_lonlat(pll.data());
             uid_2_parts[uid].insert(jpart);
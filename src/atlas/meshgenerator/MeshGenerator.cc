@@ -15,6 +15,7 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/meshgenerator/MeshGenerator.h"
 #include "atlas/runtime/Exception.h"
+#include "atlas/runtime/trace/Memory.h"
 
 #include "atlas/meshgenerator/detail/MeshGeneratorFactory.h"
 #include "atlas/meshgenerator/detail/MeshGeneratorImpl.h"
@@ -42,22 +43,28 @@ void MeshGenerator::hash(eckit::Hash& h) const {
 }
 
 Mesh MeshGenerator::generate(const Grid& g, const grid::Distribution& d) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->generate(g, d);
 }
 Mesh MeshGenerator::generate(const Grid& g, const grid::Partitioner& p) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->generate(g, p);
 }
 Mesh MeshGenerator::generate(const Grid& g) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->generate(g);
 }
 
 Mesh MeshGenerator::operator()(const Grid& g, const grid::Distribution& d) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->operator()(g, d);
 }
 Mesh MeshGenerator::operator()(const Grid& g, const grid::Partitioner& p) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->operator()(g, p);
 }
 Mesh MeshGenerator::operator()(const Grid& g) const {
+    runtime::trace::Memory::Scope owner("Mesh");
     return get()->operator()(g);
 }
 
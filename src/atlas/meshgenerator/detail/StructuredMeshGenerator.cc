@@ -15,7 +15,6 @@
 #include <numeric>
 #include <vector>
 
-#include "eckit/log/ProgressTimer.h"
 #include "eckit/types/FloatCompare.h"
 #include "eckit/utils/Hash.h"
 
@@ -35,6 +34,7 @@
 #include "atlas/meshgenerator/detail/MeshGeneratorFactory.h"
 #include "atlas/meshgenerator/detail/StructuredMeshGenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -56,6 +56,7 @@ static double to_deg = 180. * M_1_PI;
 struct Region {
     int north {-1};
     int south {-1};
+    int elems_north {-1};  // latitude of first row of elements in elems
     std::unique_ptr<array::Array> elems;
     int ntriags {0};
     int nquads {0};
@@ -63,6 +64,8 @@ struct Region {
     std::vector<idx_t> lat_begin;
     std::vector<idx_t> lat_end;
     std::vector<idx_t> nb_lat_elems;
+    std::vector<idx_t> nb_lat_quads;
+    std::vector<idx_t> nb_lat_triags;
 };
 
 StructuredMeshGenerator::StructuredMeshGenerator(const eckit::Parametrisation& p) {
@@ -285,6 +288,8 @@ void StructuredMeshGenerator::generate_region(const StructuredGrid& rg, const gr
     region.lat_begin.resize(rg.ny(), -1);
     region.lat_end.resize(rg.ny(), -1);
     region.nb_lat_elems.resize(rg.ny(), 0);
+    region.nb_lat_quads.resize(rg.ny(), 0);
+    region.nb_lat_triags.resize(rg.ny(), 0);
 
     idx_t lat_north = -1;
     idx_t lat_south = -1;
@@ -389,8 +394,9 @@ We need to connect to next region
         ++lat_south;
     }
 
-    region.north = lat_north;
-    region.south = lat_south;
+    region.north       = lat_north;
+    region.south       = lat_south;
+    region.elems_north = lat_north;
 
     array::ArrayShape shape = array::make_shape(region.south - region.north, 4 * rg.nxmax(), 4);
 
@@ -403,16 +409,22 @@ We need to connect to next region
     array::ArrayView<int, 3> elemview = array::make_view<int, 3>(*region.elems);
     elemview.assign(-1);
 
-    ATLAS_TRACE_SCOPE("generate elements") {
-        eckit::Channel blackhole;
-
-        eckit::ProgressTimer progress("Generating elements for " + std::to_string(lat_south - lat_north) + " rows",
-                                      lat_south - lat_north, " row", 5.,
-                                      lat_south - lat_north > 1280 ? Log::trace() : blackhole);
+    // Range of longitude indices used by the elements of one row (latN,latS), for the latitudes latN and latS
+    struct RowBounds {
+        idx_t beginN{-1};
+        idx_t endN{-1};
+        idx_t beginS{-1};
+        idx_t endS{-1};
+    };
+    std::vector<RowBounds> row_bounds(lat_south - lat_north);
 
-        for (idx_t jlat = lat_north; jlat < lat_south; ++jlat, ++progress) {
-            //    std::stringstream filename; filename << "/tmp/debug/"<<jlat;
+    auto update_begin = [](idx_t& begin, idx_t ip) { begin = (begin == -1) ? ip : std::min(begin, ip); };
+    auto update_end   = [](idx_t& end, idx_t ip) { end = std::max(end, ip); };
 
+    ATLAS_TRACE_SCOPE("generate elements") {
+        // Rows are independent: each row only writes its own elements and row-local bounds and counts.
+        // These are merged in order of rows afterwards, so that the result is identical to a serial generation.
+        atlas_omp_parallel_for (idx_t jlat = lat_north; jlat < lat_south; ++jlat) {
             idx_t ilat, latN, latS;
             idx_t ipN1, ipN2, ipS1, ipS2;
             double xN1, xN2, yN, xS1, xS2, yS;
@@ -420,7 +432,7 @@ We need to connect to next region
             bool try_make_triangle_up, try_make_triangle_down, try_make_quad;
             bool add_triag, add_quad;
 
-            ilat = jlat - region.north;
+            ilat = jlat - region.elems_north;
 
             auto lat_elems_view = elemview.slice(ilat, Range::all(), Range::all());
 
@@ -448,8 +460,11 @@ We need to connect to next region
             ipN2 = std::min(ipN1 + 1, endN);
             ipS2 = std::min(ipS1 + 1, endS);
 
-            idx_t jelem = 0;
-            int pE      = distribution.partition(offset.at(latN));
+            idx_t jelem   = 0;
+            idx_t nquads  = 0;
+            idx_t ntriags = 0;
+            auto& bounds  = row_bounds[jlat - lat_north];
+            int pE        = distribution.partition(offset.at(latN));
 
 #if DEBUG_OUTPUT
             Log::info() << "=================\n";
@@ -678,20 +693,13 @@ We need to connect to next region
                     }
                     add_quad = (pE == mypart);
                     if (add_quad) {
-                        ++region.nquads;
+                        ++nquads;
                         ++jelem;
-                        ++nelems;
 
-                        if (region.lat_begin.at(latN) == -1) {
-                            region.lat_begin.at(latN) = ipN1;
-                        }
-                        if (region.lat_begin.at(latS) == -1) {
-                            region.lat_begin.at(latS) = ipS1;
-                        }
-                        region.lat_begin.at(latN) = std::min<int>(region.lat_begin.at(latN), ipN1);
-                        region.lat_begin.at(latS) = std::min<int>(region.lat_begin.at(latS), ipS1);
-                        region.lat_end.at(latN)   = std::max<int>(region.lat_end.at(latN), ipN2);
-                        region.lat_end.at(latS)   = std::max<int>(region.lat_end.at(latS), ipS2);
+                        update_begin(bounds.beginN, ipN1);
+                        update_begin(bounds.beginS, ipS1);
+                        update_end(bounds.endN, ipN2);
+                        update_end(bounds.endS, ipS2);
                     }
                     else {
 #if DEBUG_OUTPUT
@@ -721,20 +729,13 @@ We need to connect to next region
 
                     if (add_triag) {
                         ATLAS_ASSERT(ipN1 != ipN2, "Faulty triangle with latN = "+std::to_string(latN)+"("+std::to_string(rg.y(latN))+")");
-                        ++region.ntriags;
+                        ++ntriags;
                         ++jelem;
-                        ++nelems;
 
-                        if (region.lat_begin.at(latN) == -1) {
-                            region.lat_begin.at(latN) = ipN1;
-                        }
-                        if (region.lat_begin.at(latS) == -1) {
-                            region.lat_begin.at(latS) = ipS1;
-                        }
-                        region.lat_begin.at(latN) = std::min<int>(region.lat_begin.at(latN), ipN1);
-                        region.lat_begin.at(latS) = std::min<int>(region.lat_begin.at(latS), ipS1);
-                        region.lat_end.at(latN)   = std::max<int>(region.lat_end.at(latN), ipN2);
-                        region.lat_end.at(latS)   = std::max<int>(region.lat_end.at(latS), ipS1);
+                        update_begin(bounds.beginN, ipN1);
+                        update_begin(bounds.beginS, ipS1);
+                        update_end(bounds.endN, ipN2);
+                        update_end(bounds.endS, ipS1);
                     }
                     else {
 #if DEBUG_OUTPUT
@@ -775,20 +776,13 @@ We need to connect to next region
                     add_triag = (mypart == pE);
 
                     if (add_triag) {
-                        ++region.ntriags;
+                        ++ntriags;
                         ++jelem;
-                        ++nelems;
 
-                        if (region.lat_begin.at(latN) == -1) {
-                            region.lat_begin.at(latN) = ipN1;
-                        }
-                        if (region.lat_begin.at(latS) == -1) {
-                            region.lat_begin.at(latS) = ipS1;
-                        }
-                        region.lat_begin.at(latN) = std::min(region.lat_begin.at(latN), ipN1);
-                        region.lat_begin.at(latS) = std::min(region.lat_begin.at(latS), ipS1);
-                        region.lat_end.at(latN)   = std::max(region.lat_end.at(latN), ipN1);
-                        region.lat_end.at(latS)   = std::max(region.lat_end.at(latS), ipS2);
+                        update_begin(bounds.beginN, ipN1);
+                        update_begin(bounds.beginS, ipS1);
+                        update_end(bounds.endN, ipN1);
+                        update_end(bounds.endS, ipS2);
                     }
                     else {
 #if DEBUG_OUTPUT
@@ -804,10 +798,36 @@ We need to connect to next region
                 ipN2 = std::min(endN, ipN1 + 1);
                 ipS2 = std::min(endS, ipS1 + 1);
             }
-            region.nb_lat_elems.at(jlat) = jelem;
+            region.nb_lat_elems.at(jlat)  = jelem;
+            region.nb_lat_quads.at(jlat)  = nquads;
+            region.nb_lat_triags.at(jlat) = ntriags;
 #if DEBUG_OUTPUT
             ATLAS_DEBUG_VAR(region.nb_lat_elems.at(jlat));
 #endif
+        }  // for jlat
+    }
+
+    ATLAS_TRACE_SCOPE("merge rows") {
+        for (idx_t jlat = lat_north; jlat < lat_south; ++jlat) {
+            const idx_t latN        = jlat;
+            const idx_t latS        = jlat + 1;
+            const double yN         = rg.y(latN);
+            const double yS         = rg.y(latS);
+            const RowBounds& bounds = row_bounds[jlat - lat_north];
+
+            if (bounds.beginN != -1) {
+                update_begin(region.lat_begin.at(latN), bounds.beginN);
+            }
+            if (bounds.beginS != -1) {
+                update_begin(region.lat_begin.at(latS), bounds.beginS);
+            }
+            update_end(region.lat_end.at(latN), bounds.endN);
+            update_end(region.lat_end.at(latS), bounds.endS);
+
+            region.nquads += region.nb_lat_quads.at(jlat);
+            region.ntriags += region.nb_lat_triags.at(jlat);
+            nelems += region.nb_lat_elems.at(jlat);
+
             if (region.nb_lat_elems.at(jlat) == 0 && latN == region.north) {
                 ++region.north;
             }
@@ -1096,18 +1116,27 @@ void StructuredMeshGenerator::generate_mesh(const StructuredGrid& rg, const grid
         }
     }
 
+    // Local index of the first node of each latitude, so that latitudes can be filled independently
     idx_t jnode = 0;
-    l           = 0;
     for (idx_t jlat = region.north; jlat <= region.south; ++jlat) {
-        idx_t ilat          = jlat - region.north;
-        offset_loc.at(ilat) = l;
-        l += region.lat_end.at(jlat) - region.lat_begin.at(jlat) + 1;
+        offset_loc.at(jlat - region.north) = jnode;
+        idx_t nb_lat_nodes = region.lat_end.at(jlat) - region.lat_begin.at(jlat) + 1;
+        if (!include_periodic_ghost_points) {
+            // skip periodic point
+            nb_lat_nodes -=
+                std::max<idx_t>(0, region.lat_end.at(jlat) - std::max(region.lat_begin.at(jlat), rg.nx(jlat)) + 1);
+        }
+        jnode += nb_lat_nodes;
+    }
+
+    atlas_omp_parallel_for (idx_t jlat = region.north; jlat <= region.south; ++jlat) {
+        idx_t jnode = offset_loc.at(jlat - region.north);
 
         double y = rg.y(jlat);
         for (idx_t jlon = region.lat_begin.at(jlat); jlon <= region.lat_end.at(jlat); ++jlon) {
             if (jlon < rg.nx(jlat)) {
                 idx_t inode = node_numbering.at(jnode);
-                n           = offset_glb.at(jlat) + jlon;
+                idx_t n     = offset_glb.at(jlat) + jlon;
 
                 double x = rg.x(jlon, jlat);
                 // std::cout << "jlat = " << jlat << "; jlon = " << jlon << "; x = " <<
@@ -1195,9 +1224,6 @@ void StructuredMeshGenerator::generate_mesh(const StructuredGrid& rg, const grid
                 }
                 ++jnode;
             }
-            else {
-                --l;
-            }
         }
     }
 
@@ -1304,14 +1330,30 @@ void StructuredMeshGenerator::generate_mesh(const StructuredGrid& rg, const grid
     }
 
     if ((region.nquads + region.ntriags) > 0) {
+    // Index of the first quadrilateral and triangle of each row, so that rows can be filled independently
+    std::vector<idx_t> lat_quad_begin(region.south - region.north);
+    std::vector<idx_t> lat_triag_begin(region.south - region.north);
     for (idx_t jlat = region.north; jlat < region.south; ++jlat) {
-        idx_t ilat  = jlat - region.north;
-        idx_t jlatN = jlat;
-        idx_t jlatS = jlat + 1;
-        idx_t ilatN = ilat;
-        idx_t ilatS = ilat + 1;
+        lat_quad_begin[jlat - region.north]  = jquad;
+        lat_triag_begin[jlat - region.north] = jtriag;
+        jquad += region.nb_lat_quads.at(jlat);
+        jtriag += region.nb_lat_triags.at(jlat);
+    }
+
+    auto elems = array::make_view<int, 3>(*region.elems);
+    atlas_omp_parallel_for (idx_t jlat = region.north; jlat < region.south; ++jlat) {
+        idx_t ilat   = jlat - region.north;
+        idx_t jlatN  = jlat;
+        idx_t jlatS  = jlat + 1;
+        idx_t ilatN  = ilat;
+        idx_t ilatS  = ilat + 1;
+        idx_t jquad  = lat_quad_begin[ilat];
+        idx_t jtriag = lat_triag_begin[ilat];
+        idx_t jcell;
+        idx_t quad_nodes[4];
+        idx_t triag_nodes[3];
         for (idx_t jelem = 0; jelem < region.nb_lat_elems.at(jlat); ++jelem) {
-            const auto elem = array::make_view<int, 3>(*region.elems).slice(ilat, jelem, Range::all());
+            const auto elem = elems.slice(jlat - region.elems_north, jelem, Range::all());
 
             if (elem(2) >= 0 && elem(3) >= 0)  // This is a quad
             {
@@ -81,6 +81,10 @@ alignment::alignment(int value) {
     set("alignment", value);
 }
 
+memory_resource::memory_resource(const std::string& value) {
+    set("memory_resource", value);
+}
+
 // ----------------------------------------------------------------------------
 
 }  // namespace option
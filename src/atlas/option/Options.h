@@ -95,6 +95,15 @@ public:
 
 // ----------------------------------------------------------------------------
 
+/// Name of the array::MemoryResource to allocate the field from, e.g. "system", "pool", "arena", "huge_pages".
+/// "arena" selects the arena of the enclosing array::ScopedMemoryResource("arena"), and is rejected outside of one.
+class memory_resource : public util::Config {
+public:
+    memory_resource(const std::string&);
+};
+
+// ----------------------------------------------------------------------------
+
 class halo : public util::Config {
 public:
     halo(size_t size);
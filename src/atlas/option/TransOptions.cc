@@ -45,6 +45,10 @@ fft::fft(const std::string& fft) {
     set("fft", fft);
 }
 
+precision::precision(const std::string& precision) {
+    set("precision", precision);
+}
+
 split_latitudes::split_latitudes(bool split_latitudes) {
     set("split_latitudes", split_latitudes);
 }
@@ -73,6 +73,13 @@ public:
 
 // ----------------------------------------------------------------------------
 
+class precision : public util::Config {
+public:
+    precision(const std::string&);  // "double" (default) or "single"
+};
+
+// ----------------------------------------------------------------------------
+
 class split_latitudes : public util::Config {
 public:
     split_latitudes(bool);
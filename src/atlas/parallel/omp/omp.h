@@ -33,6 +33,8 @@ int atlas_omp_get_nested(void);
 
 #define atlas_omp_parallel_for atlas_omp_pragma(omp parallel for schedule(guided) ) for
 #define atlas_omp_for atlas_omp_pragma(omp for schedule(guided)) for
+#define atlas_omp_parallel_for_static atlas_omp_pragma(omp parallel for schedule(static) ) for
+#define atlas_omp_for_static atlas_omp_pragma(omp for schedule(static)) for
 #define atlas_omp_parallel atlas_omp_pragma(omp parallel)
 #define atlas_omp_critical atlas_omp_pragma(omp critical)
 
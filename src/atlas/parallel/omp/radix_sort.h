@@ -0,0 +1,148 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "atlas/parallel/omp/omp.h"
+
+namespace atlas {
+namespace omp {
+
+/**
+ * radix_sort
+ * ==========
+ *
+ * 1)  template <typename RandomAccessIterator>
+ *       void radix_sort ( RandomAccessIterator first, RandomAccessIterator last );
+ *
+ * 2)  template <typename RandomAccessIterator, typename KeyFunction>
+ *       void radix_sort ( RandomAccessIterator first, RandomAccessIterator last, KeyFunction key );
+ *
+ * Sort elements in range [first,last) into ascending order of an integral key, using a least significant
+ * digit radix sort with 8-bit digits.
+ *
+ * The key is the element itself for the first version, and key(element) for the second, e.g.
+ * a lambda returning the global index of a struct { gidx_t g; idx_t i; }.
+ *
+ * The sort is stable: elements with equal keys keep their original relative order, also when running with
+ * multiple threads. Every pass distributes the elements in contiguous chunks; each chunk counts its digits
+ * in its own histogram, and prefix sums over buckets and chunks give the scatter positions without atomics.
+ * Passes where all elements have the same digit (e.g. the high bytes of small keys) are skipped.
+ *
+ * Memory: two temporary copies of the range.
+ */
+
+namespace detail {
+
+/// Map integral key to unsigned integer with the same ordering
+template <typename Key>
+typename std::make_unsigned<Key>::type radix_ordered(Key key) {
+    using unsigned_type = typename std::make_unsigned<Key>::type;
+    auto ordered        = static_cast<unsigned_type>(key);
+    if (std::is_signed<Key>::value) {
+        ordered ^= unsigned_type(1) << (std::numeric_limits<unsigned_type>::digits - 1);
+    }
+    return ordered;
+}
+
+/// Below this size the sort runs in a single chunk
+constexpr size_t radix_sort_parallel_threshold() {
+    return 1 << 14;
+}
+
+}  // namespace detail
+
+template <typename RandomAccessIterator, typename KeyFunction>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyFunction key) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    using key_type   = typename std::decay<decltype(key(*first))>::type;
+    static_assert(std::is_integral<key_type>::value, "radix_sort requires an integral key");
+
+    constexpr int nb_buckets = 256;
+    constexpr int nb_passes  = sizeof(key_type);
+
+    const size_t size = std::distance(first, last);
+    if (size < 2) {
+        return;
+    }
+
+    const int nb_chunks = size >= detail::radix_sort_parallel_threshold() ? atlas_omp_get_max_threads() : 1;
+    auto chunk_begin    = [&](int chunk) { return (size * chunk) / nb_chunks; };
+
+    std::vector<value_type> buffer_1(first, last);
+    std::vector<value_type> buffer_2(buffer_1);
+    value_type* source      = buffer_1.data();
+    value_type* destination = buffer_2.data();
+
+    std::vector<std::array<size_t, nb_buckets>> histogram(nb_chunks);
+    for (int pass = 0; pass < nb_passes; ++pass) {
+        const int shift = 8 * pass;
+        auto digit      = [&](const value_type& value) {
+            return static_cast<int>((detail::radix_ordered(key(value)) >> shift) & (nb_buckets - 1));
+        };
+
+        atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+            auto& count = histogram[chunk];
+            count.fill(0);
+            const size_t end = chunk_begin(chunk + 1);
+            for (size_t i = chunk_begin(chunk); i < end; ++i) {
+                ++count[digit(source[i])];
+            }
+        }
+
+        bool single_bucket = false;
+        size_t position    = 0;
+        for (int bucket = 0; bucket < nb_buckets; ++bucket) {
+            const size_t bucket_begin = position;
+            for (int chunk = 0; chunk < nb_chunks; ++chunk) {
+                const size_t count       = histogram[chunk][bucket];
+                histogram[chunk][bucket] = position;
+                position += count;
+            }
+            single_bucket = single_bucket || (position - bucket_begin == size);
+        }
+        if (single_bucket) {
+            continue;
+        }
+
+        atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+            auto& scatter    = histogram[chunk];
+            const size_t end = chunk_begin(chunk + 1);
+            for (size_t i = chunk_begin(chunk); i < end; ++i) {
+                destination[scatter[digit(source[i])]++] = std::move(source[i]);
+            }
+        }
+        std::swap(source, destination);
+    }
+
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        const size_t end = chunk_begin(chunk + 1);
+        for (size_t i = chunk_begin(chunk); i < end; ++i) {
+            first[i] = std::move(source[i]);
+        }
+    }
+}
+
+template <typename RandomAccessIterator>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    ::atlas::omp::radix_sort(first, last, [](const value_type& value) { return value; });
+}
+
+}  // namespace omp
+}  // namespace atlas
@@ -13,9 +13,13 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "atlas/library/config.h"
 #include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/radix_sort.h"
 
 #if ATLAS_HAVE_OMP && ATLAS_OMP_TASK_SUPPORTED
 #include <omp.h>
@@ -66,6 +70,37 @@ namespace omp {
  *
  *
  *
+ * stable_sort
+ * ===========
+ *
+ * 1)  template <typename RandomAccessIterator>
+ *       void stable_sort ( RandomAccessIterator first, RandomAccessIterator last );
+ *
+ * 2)  template <typename RandomAccessIterator, typename Compare>
+ *       void stable_sort ( RandomAccessIterator first, RandomAccessIterator last, Compare comp );
+ *
+ * As sort, but equivalent elements keep their original relative order.
+ *
+ *
+ *
+ * sort_by_key
+ * ===========
+ *
+ * 1)  template <typename RandomAccessIterator, typename RandomAccessIterator2>
+ *       void sort_by_key ( RandomAccessIterator keys_first, RandomAccessIterator keys_last,
+ *                          RandomAccessIterator2 values_first );
+ *
+ * 2)  template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+ *       void sort_by_key ( RandomAccessIterator keys_first, RandomAccessIterator keys_last,
+ *                          RandomAccessIterator2 values_first, Compare comp );
+ *
+ * Sort keys in range [keys_first,keys_last) into ascending order, and apply the same permutation to the
+ * values in range [values_first, values_first + (keys_last-keys_first)).
+ * The sort is stable. Integral keys compared with operator< (first version) are sorted with radix_sort,
+ * other keys with stable_sort.
+ *
+ *
+ *
  * merge_blocks
  * ============
  *
@@ -93,8 +128,18 @@ namespace omp {
 
 namespace detail {
 
+template <bool Stable, typename RandomAccessIterator, typename Compare>
+void sort_seq(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+    if (Stable) {
+        std::stable_sort(first, last, compare);
+    }
+    else {
+        std::sort(first, last, compare);
+    }
+}
+
 #if ATLAS_HAVE_OMP_SORTING
-template <typename RandomAccessIterator, typename Compare>
+template <bool Stable, typename RandomAccessIterator, typename Compare>
 void merge_sort_recursive(const RandomAccessIterator& iterator, size_t begin, size_t end, Compare compare) {
     auto size = end - begin;
     if (size >= 256) {
@@ -108,20 +153,20 @@ void merge_sort_recursive(const RandomAccessIterator& iterator, size_t begin, si
 #else
 #pragma omp task shared(iterator)
 #endif
-            merge_sort_recursive(iterator, begin, mid, compare);
+            merge_sort_recursive<Stable>(iterator, begin, mid, compare);
 #if ATLAS_OMP_TASK_UNTIED_SUPPORTED
 #pragma omp task shared(iterator) untied if (size >= (1 << 15))
 #else
 #pragma omp task shared(iterator)
 #endif
-            merge_sort_recursive(iterator, mid, end, compare);
+            merge_sort_recursive<Stable>(iterator, mid, end, compare);
 //#pragma omp taskyield
 #pragma omp taskwait
         }
         std::inplace_merge(iterator + begin, iterator + mid, iterator + end, compare);
     }
     else {
-        std::sort(iterator + begin, iterator + end, compare);
+        sort_seq<Stable>(iterator + begin, iterator + end, compare);
     }
 }
 #endif
@@ -172,30 +217,88 @@ void merge_blocks_recursive_seq(RandomAccessIterator& iterator, const Indexable&
     std::inplace_merge(begin, mid, end, compare);
 }
 
-}  // namespace detail
 
-template <typename RandomAccessIterator, typename Compare>
-void sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+template <bool Stable, typename RandomAccessIterator, typename Compare>
+void merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
 #if ATLAS_HAVE_OMP_SORTING
     if (atlas_omp_get_max_threads() > 1) {
 #pragma omp parallel
 #pragma omp single
-        detail::merge_sort_recursive(first, 0, std::distance(first, last), compare);
+        merge_sort_recursive<Stable>(first, 0, std::distance(first, last), compare);
     }
     else {
-        std::sort(first, last, compare);
+        sort_seq<Stable>(first, last, compare);
     }
 #else
-    std::sort(first, last, compare);
+    sort_seq<Stable>(first, last, compare);
 #endif
 }
 
+template <typename RandomAccessIterator, typename RandomAccessIterator2, typename SortPairs>
+void sort_by_key(RandomAccessIterator keys_first, RandomAccessIterator keys_last, RandomAccessIterator2 values_first,
+                 SortPairs sort_pairs) {
+    using key_type   = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    using value_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+    const long size  = std::distance(keys_first, keys_last);
+
+    // Sorting (key,value) pairs keeps keys and values together in memory
+    std::vector<std::pair<key_type, value_type>> pairs(size);
+    atlas_omp_parallel_for(long i = 0; i < size; ++i) {
+        pairs[i] = std::make_pair(keys_first[i], values_first[i]);
+    }
+    sort_pairs(pairs.begin(), pairs.end());
+    atlas_omp_parallel_for(long i = 0; i < size; ++i) {
+        keys_first[i]   = std::move(pairs[i].first);
+        values_first[i] = std::move(pairs[i].second);
+    }
+}
+
+}  // namespace detail
+
+template <typename RandomAccessIterator, typename Compare>
+void sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+    detail::merge_sort<false>(first, last, compare);
+}
+
 template <typename RandomAccessIterator>
 void sort(RandomAccessIterator first, RandomAccessIterator last) {
     using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
     ::atlas::omp::sort(first, last, std::less<value_type>());
 }
 
+template <typename RandomAccessIterator, typename Compare>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare) {
+    detail::merge_sort<true>(first, last, compare);
+}
+
+template <typename RandomAccessIterator>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    ::atlas::omp::stable_sort(first, last, std::less<value_type>());
+}
+
+template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+void sort_by_key(RandomAccessIterator keys_first, RandomAccessIterator keys_last, RandomAccessIterator2 values_first,
+                 Compare compare) {
+    detail::sort_by_key(keys_first, keys_last, values_first, [&compare](auto first, auto last) {
+        ::atlas::omp::stable_sort(first, last,
+                                  [&compare](const auto& a, const auto& b) { return compare(a.first, b.first); });
+    });
+}
+
+template <typename RandomAccessIterator, typename RandomAccessIterator2>
+void sort_by_key(RandomAccessIterator keys_first, RandomAccessIterator keys_last, RandomAccessIterator2 values_first) {
+    using key_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    if constexpr (std::is_integral<key_type>::value) {
+        detail::sort_by_key(keys_first, keys_last, values_first, [](auto first, auto last) {
+            ::atlas::omp::radix_sort(first, last, [](const auto& pair) { return pair.first; });
+        });
+    }
+    else {
+        ::atlas::omp::sort_by_key(keys_first, keys_last, values_first, std::less<key_type>());
+    }
+}
+
 template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
 void merge_blocks(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 blocks_size_first,
                   RandomAccessIterator2 blocks_size_last, Compare compare) {
@@ -0,0 +1,92 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "atlas/parallel/omp/omp.h"
+
+namespace atlas {
+namespace omp {
+
+/**
+ * unique
+ * ======
+ *
+ * 1)  template <typename RandomAccessIterator>
+ *       RandomAccessIterator unique ( RandomAccessIterator first, RandomAccessIterator last );
+ *
+ * 2)  template <typename RandomAccessIterator, typename BinaryPredicate>
+ *       RandomAccessIterator unique ( RandomAccessIterator first, RandomAccessIterator last, BinaryPredicate equal );
+ *
+ * Remove all but the first element from every group of consecutive equivalent elements in range [first,last),
+ * and return the past-the-end iterator of the new range, as std::unique.
+ *
+ * Elements are compared using operator== for the first version, and equal for the second, which must be
+ * an equivalence relation as every element is compared to its predecessor in the original range.
+ *
+ * With multiple threads, the elements to keep are flagged and counted per contiguous chunk, and every chunk then
+ * moves its elements from a temporary copy of the range to the position given by the prefix sum of the counts.
+ */
+
+template <typename RandomAccessIterator, typename BinaryPredicate>
+RandomAccessIterator unique(RandomAccessIterator first, RandomAccessIterator last, BinaryPredicate equal) {
+    using value_type  = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    const size_t size = std::distance(first, last);
+    if (atlas_omp_get_max_threads() == 1 || size < (1 << 14)) {
+        return std::unique(first, last, equal);
+    }
+
+    const int nb_chunks = atlas_omp_get_max_threads();
+    auto chunk_begin    = [&](int chunk) { return (size * chunk) / nb_chunks; };
+
+    std::vector<value_type> buffer(first, last);
+    std::vector<char> keep(size);
+
+    std::vector<size_t> offset(nb_chunks + 1, 0);
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        size_t count     = 0;
+        const size_t end = chunk_begin(chunk + 1);
+        for (size_t i = chunk_begin(chunk); i < end; ++i) {
+            keep[i] = (i == 0 || !equal(buffer[i - 1], buffer[i]));
+            count += keep[i];
+        }
+        offset[chunk + 1] = count;
+    }
+    for (int chunk = 0; chunk < nb_chunks; ++chunk) {
+        offset[chunk + 1] += offset[chunk];
+    }
+
+    atlas_omp_parallel_for(int chunk = 0; chunk < nb_chunks; ++chunk) {
+        auto result      = first + offset[chunk];
+        const size_t end = chunk_begin(chunk + 1);
+        for (size_t i = chunk_begin(chunk); i < end; ++i) {
+            if (keep[i]) {
+                *(result++) = std::move(buffer[i]);
+            }
+        }
+    }
+    return first + offset[nb_chunks];
+}
+
+template <typename RandomAccessIterator>
+RandomAccessIterator unique(RandomAccessIterator first, RandomAccessIterator last) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    return ::atlas::omp::unique(first, last, std::equal_to<value_type>());
+}
+
+}  // namespace omp
+}  // namespace atlas
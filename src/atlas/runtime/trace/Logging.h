@@ -18,6 +18,8 @@ namespace atlas {
 namespace runtime {
 namespace trace {
 
+/// Controls whether traces log and execute barriers, which happens only on the master thread of parallel regions.
+/// Timings are recorded on all threads.
 class Control {
 public:
     static bool enabled();
@@ -0,0 +1,232 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "Memory.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/log/Bytes.h"
+
+#include "atlas/util/Config.h"
+
+//-----------------------------------------------------------------------------------------------------------
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+namespace {
+
+void update_maximum(std::atomic<size_t>& maximum, size_t value) {
+    size_t previous = maximum;
+    while (previous < value && !maximum.compare_exchange_weak(previous, value)) {
+    }
+}
+
+class MemoryRegistry {
+public:
+    // Intentionally never destroyed: data stores and caches in other static objects may still release memory
+    // through their MemoryOwner during static destruction, in any order.
+    static MemoryRegistry& instance() {
+        static auto* registry = new MemoryRegistry;
+        return *registry;
+    }
+
+    MemoryOwner& owner(const std::string& type, const std::string& name) {
+        // Owners are never removed, so they can be cached per thread, avoiding the lock for known owners.
+        // Names accounted to the overflow owner are not cached, which keeps the cache bounded as well.
+        thread_local std::map<std::string, std::map<std::string, MemoryOwner*>> cache;
+        auto cached_type = cache.find(type);
+        if (cached_type != cache.end()) {
+            auto cached = cached_type->second.find(name);
+            if (cached != cached_type->second.end()) {
+                return *cached->second;
+            }
+        }
+        MemoryOwner& owner = find_or_create(type, name);
+        if (owner.name() == name) {
+            cache[type][name] = &owner;
+        }
+        return owner;
+    }
+
+    void report(std::ostream& out, const eckit::Configuration& config) {
+        long top_config = 20;
+        config.get("top", top_config);
+        const size_t top = top_config;
+
+        std::vector<const MemoryOwner*> owners;
+        std::vector<const MemoryOwner*> totals;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& type : types_) {
+                for (auto& owner : type.second.names) {
+                    if (owner.second->high()) {
+                        owners.emplace_back(owner.second.get());
+                    }
+                }
+                if (type.second.other && type.second.other->high()) {
+                    owners.emplace_back(type.second.other.get());
+                }
+                if (type.second.total->high()) {
+                    totals.emplace_back(type.second.total.get());
+                }
+            }
+        }
+        if (owners.empty()) {
+            return;
+        }
+        auto larger = [](const MemoryOwner* a, const MemoryOwner* b) {
+            return a->bytes() != b->bytes() ? a->bytes() > b->bytes() : a->high() > b->high();
+        };
+        std::sort(owners.begin(), owners.end(), larger);
+        std::sort(totals.begin(), totals.end(), larger);
+
+        size_t max_type_length = 4;
+        size_t max_name_length = 4;
+        for (auto* owner : owners) {
+            max_type_length = std::max(max_type_length, owner->type().size());
+            max_name_length = std::max(max_name_length, owner->name().size());
+        }
+
+        const std::string box_vertical("\u2502");
+        const std::string sep = std::string(" ") + box_vertical + std::string(" ");
+
+        auto bytes = [](size_t b) {
+            std::ostringstream s;
+            s << eckit::Bytes(double(b));
+            return s.str();
+        };
+        auto print = [&](const MemoryOwner& owner) {
+            out << "  " << std::left << std::setw(max_type_length) << owner.type() << sep
+                << std::setw(max_name_length) << owner.name() << sep << std::right << std::setw(8)
+                << owner.allocations() << sep << std::setw(12) << bytes(owner.bytes()) << sep << std::setw(12)
+                << bytes(owner.high()) << '\n';
+        };
+        auto header = [&](const std::string& title) {
+            out << "  " << std::left << std::setw(max_type_length) << "type" << sep << std::setw(max_name_length)
+                << title << sep << std::right << std::setw(8) << "cnt" << sep << std::setw(12) << "live"
+                << sep << std::setw(12) << "high" << '\n';
+        };
+
+        out << "\nMemory owners: " << std::min(top, owners.size()) << " of " << owners.size()
+            << " largest by live bytes\n";
+        header("name");
+        for (size_t j = 0; j < std::min(top, owners.size()); ++j) {
+            print(*owners[j]);
+        }
+        out << "\nMemory per owner type\n";
+        header("");
+        for (auto* total : totals) {
+            print(*total);
+        }
+    }
+
+private:
+    struct TypeOwners {
+        std::unique_ptr<MemoryOwner> total;
+        std::unique_ptr<MemoryOwner> other;  // accumulates names beyond Memory::max_owners_per_type
+        std::map<std::string, std::unique_ptr<MemoryOwner>> names;
+    };
+
+    MemoryOwner& find_or_create(const std::string& type, const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& owners = types_[type];
+        if (not owners.total) {
+            owners.total.reset(new MemoryOwner(type, "total"));
+        }
+        auto it = owners.names.find(name);
+        if (it != owners.names.end()) {
+            return *it->second;
+        }
+        if (owners.names.size() >= Memory::max_owners_per_type) {
+            if (not owners.other) {
+                owners.other.reset(new MemoryOwner(type, "(other)", owners.total.get()));
+            }
+            return *owners.other;
+        }
+        auto& owner = owners.names[name];
+        owner.reset(new MemoryOwner(type, name, owners.total.get()));
+        return *owner;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, TypeOwners> types_;
+};
+
+thread_local MemoryOwner* scoped_owner = nullptr;
+
+}  // namespace
+
+//-----------------------------------------------------------------------------------------------------------
+
+void MemoryOwner::allocate(size_t bytes) {
+    update_maximum(high_, bytes_ += bytes);
+    ++allocations_;
+    if (total_) {
+        total_->allocate(bytes);
+    }
+}
+
+void MemoryOwner::deallocate(size_t bytes) {
+    bytes_ -= bytes;
+    --allocations_;
+    if (total_) {
+        total_->deallocate(bytes);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------
+
+Memory::Scope::Scope(const std::string& type, const std::string& name): Scope(Memory::owner(type, name)) {}
+
+Memory::Scope::Scope(MemoryOwner& owner): previous_(scoped_owner) {
+    scoped_owner = &owner;
+}
+
+Memory::Scope::~Scope() {
+    scoped_owner = previous_;
+}
+
+MemoryOwner& Memory::owner(const std::string& type, const std::string& name) {
+    return MemoryRegistry::instance().owner(type, name);
+}
+
+MemoryOwner& Memory::current() {
+    static MemoryOwner* untracked = &owner("untracked");  // owned by the immortal registry
+    return scoped_owner ? *scoped_owner : *untracked;
+}
+
+MemoryOwner& Memory::current(const std::string& type, const std::string& name) {
+    return scoped_owner ? *scoped_owner : owner(type, name);
+}
+
+std::string Memory::report() {
+    return report(util::NoConfig());
+}
+
+std::string Memory::report(const Configuration& config) {
+    std::ostringstream out;
+    MemoryRegistry::instance().report(out, config);
+    return out.str();
+}
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
@@ -0,0 +1,104 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+//-----------------------------------------------------------------------------------------------------------
+
+namespace eckit {
+class Configuration;
+}
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+/// Live bytes, number of live allocations and high watermark of one owner of memory,
+/// e.g. type "Field" with the field name, or type "Mesh".
+/// Owners are created once by Memory::owner() and live until the end of the program;
+/// allocate() and deallocate() only update atomic counters.
+/// At most Memory::max_owners_per_type names are registered per type, further names share the owner "(other)".
+class MemoryOwner {
+public:
+    MemoryOwner(const std::string& type, const std::string& name, MemoryOwner* total = nullptr):
+        type_(type), name_(name), total_(total) {}
+
+    const std::string& type() const { return type_; }
+    const std::string& name() const { return name_; }
+
+    void allocate(size_t bytes);
+    void deallocate(size_t bytes);
+
+    size_t bytes() const { return bytes_; }
+    size_t high() const { return high_; }
+    size_t allocations() const { return allocations_; }
+
+private:
+    std::string type_;
+    std::string name_;
+    MemoryOwner* total_;  // accumulates all owners of same type
+    std::atomic<size_t> bytes_{0};
+    std::atomic<size_t> high_{0};
+    std::atomic<size_t> allocations_{0};
+};
+
+//-----------------------------------------------------------------------------------------------------------
+
+/// Registry of memory owners.
+///
+/// Arrays are accounted to the innermost Memory::Scope of the allocating thread; fields outside of any scope
+/// are accounted to their own name. Memory that is not allocated through arrays, such as interpolation or
+/// trans caches, is accounted explicitly with MemoryOwner::allocate() and deallocate().
+/// The report lists the owners holding most memory, and is part of Trace::report().
+class Memory {
+public:
+    using Configuration = eckit::Configuration;
+
+    /// Select owner of memory allocated by the calling thread within the lifetime of this object
+    class Scope {
+    public:
+        Scope(const std::string& type, const std::string& name = "");
+        Scope(MemoryOwner&);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MemoryOwner* previous_;
+    };
+
+    /// Maximum number of named owners per type, which bounds the registry for e.g. many differently named fields
+    static constexpr size_t max_owners_per_type = 1000;
+
+public:  // static methods
+    /// Owner with given type and name, created on first use.
+    /// Known owners are looked up in a cache of the calling thread, without locking.
+    static MemoryOwner& owner(const std::string& type, const std::string& name = "");
+
+    /// Owner of the innermost Scope of the calling thread, or else the owner "untracked"
+    static MemoryOwner& current();
+
+    /// Owner of the innermost Scope of the calling thread, or else the owner with given type and name
+    static MemoryOwner& current(const std::string& type, const std::string& name);
+
+    static std::string report();
+
+    /// Configuration options:
+    ///   - "top" : number of owners listed (default 20)
+    static std::string report(const Configuration&);
+};
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
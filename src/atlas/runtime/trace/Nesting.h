@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/trace/CallStack.h"
 #include "atlas/runtime/trace/CodeLocation.h"
 #include "atlas/runtime/trace/Logging.h"
@@ -20,28 +21,38 @@ namespace atlas {
 namespace runtime {
 namespace trace {
 
+/// @class CurrentCallStack
+/// Call stack of the currently running traces.
+/// Inside OpenMP parallel regions every thread has its own call stack, which continues from the call stack of the
+/// enclosing serial region. The serial call stack is not modified inside parallel regions.
 class CurrentCallStack {
 private:
-    CurrentCallStack() {}
+    CurrentCallStack(const CurrentCallStack* parent = nullptr): parent_(parent) {}
     CallStack stack_;
+    const CurrentCallStack* parent_;
+    size_t base_{0};
 
 public:
     CurrentCallStack(CurrentCallStack const&) = delete;
     CurrentCallStack& operator=(CurrentCallStack const&) = delete;
     static CurrentCallStack& instance() {
         static CurrentCallStack state;
+        if (atlas_omp_in_parallel()) {
+            thread_local CurrentCallStack thread_state(&state);
+            return thread_state;
+        }
         return state;
     }
     operator CallStack() const { return stack_; }
     CallStack& push(const CodeLocation& loc, const std::string& id) {
-        if (Control::enabled())
-            stack_.push(loc, id);
+        if (parent_ && stack_.size() == base_) {
+            stack_ = parent_->stack_;
+            base_  = stack_.size();
+        }
+        stack_.push(loc, id);
         return stack_;
     }
-    void pop() {
-        if (Control::enabled())
-            stack_.pop();
-    }
+    void pop() { stack_.pop(); }
 };
 
 }  // namespace trace
@@ -14,9 +14,12 @@
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/filesystem/PathName.h"
@@ -36,6 +39,24 @@ namespace trace {
 
 class TimingsRegistry {
 private:
+    /// Timings recorded by a single thread. They are merged when a report is created.
+    struct ThreadTimings {
+        std::vector<long> counts;
+        std::vector<double> tot_timings;
+        std::vector<double> min_timings;
+        std::vector<double> max_timings;
+        std::vector<double> var_timings;
+        void update(size_t idx, double seconds);
+    };
+
+    /// The mutex is only contended while a report takes a snapshot, so that reports are safe while other threads
+    /// are still recording timings.
+    struct ThreadBuffer {
+        std::mutex mutex;
+        ThreadTimings timings;
+    };
+
+    // Timings merged over all threads, see merge()
     std::vector<long> counts_;
     std::vector<double> tot_timings_;
     std::vector<double> min_timings_;
@@ -49,6 +70,10 @@ private:
 
     std::map<std::string, std::vector<size_t>> labels_;
 
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+    std::vector<ThreadTimings> snapshot_;  // Copy of the thread buffers taken by merge()
+    std::mutex mutex_;
+
     TimingsRegistry() = default;
 
 public:
@@ -66,6 +91,10 @@ public:
     void report(std::ostream& out, const eckit::Configuration& config);
 
 private:
+    ThreadBuffer& thread_buffer();
+
+    void merge();
+
     std::string filter_filepath(const std::string& filepath) const;
 
     friend class Tree;
@@ -146,15 +175,20 @@ struct Tree {
 size_t TimingsRegistry::add(const CodeLocation& loc, const CallStack& stack, const std::string& title,
                             const Timings::Labels& labels) {
     size_t key = stack.hash();
-    auto it    = index_.find(key);
+
+    // Avoid locking for timers that this thread has seen before
+    thread_local std::unordered_map<size_t, size_t> cache;
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t idx;
+    auto it = index_.find(key);
     if (it == index_.end()) {
-        size_t idx  = size();
+        idx         = size();
         index_[key] = idx;
-        counts_.emplace_back(0);
-        tot_timings_.emplace_back(0);
-        min_timings_.emplace_back(std::numeric_limits<double>::max());
-        max_timings_.emplace_back(0);
-        var_timings_.emplace_back(0);
         titles_.emplace_back(title);
         locations_.emplace_back(loc);
         nest_.emplace_back(stack.size());
@@ -163,28 +197,93 @@ size_t TimingsRegistry::add(const CodeLocation& loc, const CallStack& stack, con
         for (const auto& label : labels) {
             labels_[label].emplace_back(idx);
         }
-
-        return idx;
     }
     else {
-        return it->second;
+        idx = it->second;
     }
+    cache[key] = idx;
+    return idx;
+}
+
+void TimingsRegistry::ThreadTimings::update(size_t idx, double seconds) {
+    if (idx >= counts.size()) {
+        counts.resize(idx + 1, 0);
+        tot_timings.resize(idx + 1, 0.);
+        min_timings.resize(idx + 1, std::numeric_limits<double>::max());
+        max_timings.resize(idx + 1, 0.);
+        var_timings.resize(idx + 1, 0.);
+    }
+    auto sqr         = [](double x) { return x * x; };
+    double n         = counts[idx] + 1;
+    double avg_nm1   = tot_timings[idx] / std::max(n, 1.);
+    double var_nm1   = var_timings[idx];
+    var_timings[idx] = n == 1. ? 0. : (n - 2.) / (n - 1.) * var_nm1 + 1. / n * sqr(seconds - avg_nm1);
+    min_timings[idx] = std::min(seconds, min_timings[idx]);
+    max_timings[idx] = std::max(seconds, max_timings[idx]);
+    tot_timings[idx] += seconds;
+    counts[idx] += 1;
 }
 
 void TimingsRegistry::update(size_t idx, double seconds) {
-    auto sqr          = [](double x) { return x * x; };
-    double n          = counts_[idx] + 1;
-    double avg_nm1    = tot_timings_[idx] / std::max(n, 1.);
-    double var_nm1    = var_timings_[idx];
-    var_timings_[idx] = n == 1. ? 0. : (n - 2.) / (n - 1.) * var_nm1 + 1. / n * sqr(seconds - avg_nm1);
-    min_timings_[idx] = std::min(seconds, min_timings_[idx]);
-    max_timings_[idx] = std::max(seconds, max_timings_[idx]);
-    tot_timings_[idx] += seconds;
-    counts_[idx] += 1;
+    auto& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.timings.update(idx, seconds);
+}
+
+TimingsRegistry::ThreadBuffer& TimingsRegistry::thread_buffer() {
+    thread_local ThreadBuffer* buffer = [this] {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.emplace_back(new ThreadBuffer());
+        return threads_.back().get();
+    }();
+    return *buffer;
+}
+
+void TimingsRegistry::merge() {
+    const size_t n = size();
+    counts_.assign(n, 0);
+    tot_timings_.assign(n, 0.);
+    min_timings_.assign(n, std::numeric_limits<double>::max());
+    max_timings_.assign(n, 0.);
+    var_timings_.assign(n, 0.);
+
+    // Other threads may still be recording: work on a consistent copy of each buffer
+    snapshot_.clear();
+    snapshot_.reserve(threads_.size());
+    for (const auto& buffer : threads_) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        snapshot_.emplace_back(buffer->timings);
+    }
+
+    // Pooled variance: sum of squared deviations within each thread, plus deviations of the thread means
+    std::vector<double> sum_sqr(n, 0.);
+    for (const auto& thread : snapshot_) {
+        for (size_t j = 0; j < thread.counts.size(); ++j) {
+            if (thread.counts[j]) {
+                counts_[j] += thread.counts[j];
+                tot_timings_[j] += thread.tot_timings[j];
+                min_timings_[j] = std::min(min_timings_[j], thread.min_timings[j]);
+                max_timings_[j] = std::max(max_timings_[j], thread.max_timings[j]);
+                sum_sqr[j] += double(thread.counts[j] - 1) * thread.var_timings[j];
+            }
+        }
+    }
+    for (const auto& thread : snapshot_) {
+        for (size_t j = 0; j < thread.counts.size(); ++j) {
+            if (thread.counts[j]) {
+                double avg        = tot_timings_[j] / double(counts_[j]);
+                double thread_avg = thread.tot_timings[j] / double(thread.counts[j]);
+                sum_sqr[j] += double(thread.counts[j]) * (thread_avg - avg) * (thread_avg - avg);
+            }
+        }
+    }
+    for (size_t j = 0; j < n; ++j) {
+        var_timings_[j] = counts_[j] > 1 ? sum_sqr[j] / double(counts_[j] - 1) : 0.;
+    }
 }
 
 size_t TimingsRegistry::size() const {
-    return counts_.size();
+    return titles_.size();
 }
 
 void TimingsRegistry::report(std::ostream& out, const eckit::Configuration& config) {
@@ -207,10 +306,14 @@ void TimingsRegistry::report(std::ostream& out, const eckit::Configuration& conf
     std::string box_T_left("\u2524");
     std::string box_cross("\u253C");
 
+    std::lock_guard<std::mutex> lock(mutex_);
+    merge();
+
     long indent                                     = config.getLong("indent", 2);
     long depth                                      = config.getLong("depth", 0);
     long decimals                                   = config.getLong("decimals", 5);
     bool header                                     = config.getBool("header", true);
+    bool threads                                    = config.getBool("threads", snapshot_.size() > 1);
     std::vector<std::string> excluded_labels_vector = config.getStringVector("exclude", std::vector<std::string>());
     std::vector<std::string> include_back;
 
@@ -421,6 +524,57 @@ void TimingsRegistry::report(std::ostream& out, const eckit::Configuration& conf
 
     out << print_horizontal(sepf) << std::endl;
 
+    if (threads) {
+        // Load balance across threads: statistics of the total time that each thread spent in a timer
+        size_t max_threads_length = std::max(std::string("thr").size(), size_t(digits(long(snapshot_.size()))));
+        size_t time_length        = max_digits_before_decimal + decimals + 2;
+
+        auto print_threads_horizontal = [&](const std::string& sep) -> std::string {
+            std::stringstream ss;
+            ss << print_line(max_title_length + digits(size()) + 3) << sep << print_line(max_threads_length) << sep
+               << print_line(time_length) << sep << print_line(time_length) << sep << print_line(time_length) << sep
+               << print_line(7);
+            return ss.str();
+        };
+
+        out << print_threads_horizontal(sept) << std::endl;
+        out << std::left << std::setw(max_title_length + digits(size()) + 3) << "Timers" << sep
+            << std::setw(max_threads_length) << "thr" << sep << std::setw(time_length) << "min/thr" << sep
+            << std::setw(time_length) << "avg/thr" << sep << std::setw(time_length) << "max/thr" << sep << "max/avg"
+            << std::endl;
+        out << print_threads_horizontal(seph) << std::endl;
+
+        for (size_t i = 0; i < size(); ++i) {
+            size_t j = order[i];
+            if (excluded(j)) {
+                continue;
+            }
+            long nb_threads(0);
+            double min = std::numeric_limits<double>::max();
+            double max(0);
+            double tot(0);
+            for (const auto& thread : snapshot_) {
+                if (j < thread.counts.size() && thread.counts[j]) {
+                    ++nb_threads;
+                    min = std::min(min, thread.tot_timings[j]);
+                    max = std::max(max, thread.tot_timings[j]);
+                    tot += thread.tot_timings[j];
+                }
+            }
+            min        = std::min(min, max);
+            double avg = nb_threads ? tot / double(nb_threads) : 0.;
+            std::stringstream balance;
+            balance << std::fixed << std::setprecision(2) << (avg > 0. ? max / avg : 1.);
+
+            out << std::setw(digits(long(size()))) << j << " : " << prefix_[j] << std::left
+                << std::setw(max_title_length - nest_[j] * indent) << titles_[j] << sep << std::left
+                << std::setw(max_threads_length) << nb_threads << sep << print_time(min) << sep << print_time(avg)
+                << sep << print_time(max) << sep << balance.str() << std::endl;
+        }
+
+        out << print_threads_horizontal(sepf) << std::endl;
+    }
+
     std::string sepc = box_horizontal(3);
 
     out << std::left << box_horizontal(40) << sept << box_horizontal(5) << sept << box_horizontal(12) << "\n";
@@ -40,6 +40,8 @@ public:  // static methods
 
     static void update(const Identifier& id, double seconds);
 
+    /// Report of all timings. It may be created while other threads are still recording: each thread's timings are
+    /// copied under a lock that is otherwise uncontended. Timers that have not stopped yet are not included.
     static std::string report();
 
     static std::string report(const Configuration&);
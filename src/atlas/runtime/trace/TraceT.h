@@ -14,9 +14,9 @@
 #include <string>
 #include <vector>
 
-#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/trace/CallStack.h"
 #include "atlas/runtime/trace/CodeLocation.h"
+#include "atlas/runtime/trace/Memory.h"
 #include "atlas/runtime/trace/Nesting.h"
 #include "atlas/runtime/trace/StopWatch.h"
 #include "atlas/runtime/trace/Timings.h"
@@ -93,9 +93,7 @@ private:  // member data
 
 template <typename TraceTraits>
 inline std::string TraceT<TraceTraits>::formatTitle(const std::string& _title) {
-    std::string title =
-        _title + (Barriers::state() ? " [b]" : "") +
-        (atlas_omp_get_num_threads() > 1 ? " @thread[" + std::to_string(atlas_omp_get_thread_num()) + "]" : "");
+    std::string title = _title + (Barriers::state() ? " [b]" : "");
     return title;
 }
 
@@ -106,13 +104,14 @@ inline TraceT<TraceTraits>::TraceT(const CodeLocation& loc, const std::string& t
 }
 
 template <typename TraceTraits>
-inline TraceT<TraceTraits>::TraceT(const CodeLocation& loc): loc_(loc), title_(loc_ ? loc_.func() : "") {
+inline TraceT<TraceTraits>::TraceT(const CodeLocation& loc):
+    loc_(loc), title_(formatTitle(loc_ ? loc_.func() : "")) {
     start();
 }
 
 template <typename TraceTraits>
 inline TraceT<TraceTraits>::TraceT(const CodeLocation& loc, const std::string& title, const Labels& labels):
-    loc_(loc), title_(title), labels_(labels) {
+    loc_(loc), title_(formatTitle(title)), labels_(labels) {
     start();
 }
 
@@ -128,10 +127,7 @@ inline void TraceT<TraceTraits>::barrier() const {
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::registerTimer() {
-    std::string title =
-        title_ + (Barriers::state() ? " [b]" : "") +
-        (atlas_omp_get_num_threads() > 1 ? " @thread[" + std::to_string(atlas_omp_get_thread_num()) + "]" : "");
-    id_ = Timings::add(loc_, callstack_, title, labels_);
+    id_ = Timings::add(loc_, callstack_, title_, labels_);
 }
 
 template <typename TraceTraits>
@@ -146,26 +142,30 @@ inline bool TraceT<TraceTraits>::running() const {
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::start() {
+    running_ = true;
+    if (not callstack_) {
+        callstack_ = CurrentCallStack::instance().push(loc_, title_);
+    }
+    registerTimer();
     if (Control::enabled()) {
-        running_ = true;
-        if (not callstack_) {
-            callstack_ = CurrentCallStack::instance().push(loc_, title_);
-        }
-        registerTimer();
         Tracing::start(title_);
         barrier();
-        stopwatch_.start();
     }
+    stopwatch_.start();
 }
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::stop() {
     if (running_) {
-        barrier();
+        if (Control::enabled()) {
+            barrier();
+        }
         stopwatch_.stop();
         CurrentCallStack::instance().pop();
         updateTimings();
-        Tracing::stop(title_, stopwatch_.elapsed());
+        if (Control::enabled()) {
+            Tracing::stop(title_, stopwatch_.elapsed());
+        }
         running_ = false;
     }
 }
@@ -173,7 +173,9 @@ inline void TraceT<TraceTraits>::stop() {
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::pause() {
     if (running_) {
-        barrier();
+        if (Control::enabled()) {
+            barrier();
+        }
         stopwatch_.stop();
         CurrentCallStack::instance().pop();
     }
@@ -182,7 +184,9 @@ inline void TraceT<TraceTraits>::pause() {
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::resume() {
     if (running_) {
-        barrier();
+        if (Control::enabled()) {
+            barrier();
+        }
         CurrentCallStack::instance().push(loc_, title_);
         stopwatch_.start();
     }
@@ -195,12 +199,12 @@ inline double TraceT<TraceTraits>::elapsed() const {
 
 template <typename TraceTraits>
 inline std::string TraceT<TraceTraits>::report() {
-    return Timings::report() + Barriers::report();
+    return Timings::report() + Barriers::report() + Memory::report();
 }
 
 template <typename TraceTraits>
 inline std::string TraceT<TraceTraits>::report(const eckit::Configuration& config) {
-    return Timings::report(config) + Barriers::report();
+    return Timings::report(config) + Barriers::report() + Memory::report(config);
 }
 
 //-----------------------------------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/Memory.h"
 #include "atlas/trans/Trans.h"
 
 namespace atlas {
@@ -28,6 +29,11 @@ TransCacheFileEntry::TransCacheFileEntry(const eckit::PathName& path): buffer_(p
     dh->openForRead();
     dh->read(buffer_.data(), buffer_.size());
     dh->close();
+    runtime::trace::Memory::owner("Trans cache", "file").allocate(buffer_.size());
+}
+
+TransCacheFileEntry::~TransCacheFileEntry() {
+    runtime::trace::Memory::owner("Trans cache", "file").deallocate(buffer_.size());
 }
 
 TransCacheMemoryEntry::TransCacheMemoryEntry(const void* data, size_t size): data_(data), size_(size) {
@@ -73,12 +79,14 @@ TransCache::TransCache(const Trans& trans): Cache(trans.get()) {}
 TransCacheOwnedMemoryEntry::TransCacheOwnedMemoryEntry(size_t size): size_(size) {
     if (size_) {
         data_ = std::malloc(size_);
+        runtime::trace::Memory::owner("Trans cache", "memory").allocate(size_);
     }
 }
 
 TransCacheOwnedMemoryEntry::~TransCacheOwnedMemoryEntry() {
     if (size_) {
         std::free(data_);
+        runtime::trace::Memory::owner("Trans cache", "memory").deallocate(size_);
     }
 }
 
@@ -62,6 +62,7 @@ private:
 
 public:
     TransCacheFileEntry(const eckit::PathName& path);
+    virtual ~TransCacheFileEntry() override;
     virtual size_t size() const override { return buffer_.size(); }
     virtual const void* data() const override { return buffer_.data(); }
 };
@@ -536,6 +536,39 @@ void TransIFS::dirtrans(const int nb_fields, const double wind_fields[], double
 // anonymous namespace
 namespace {
 
+/// Indices of the owned points of a StructuredColumns, in the row-major order of the grid as used by trans.
+/// For the default "ij" ordering this is the identity and nothing is stored; other orderings (e.g. "hilbert")
+/// permute owned points. The order is only recomputed when used with a different function space.
+class TransOrder {
+public:
+    const TransOrder& operator()(const StructuredColumns& sc) {
+        if (sc.get() == fs_.get()) {
+            return *this;
+        }
+        fs_   = sc;
+        size_ = sc.sizeOwned();
+        order_.clear();
+        if (sc.ordering() != "ij") {
+            order_.reserve(size_);
+            for (idx_t j = sc.j_begin(); j < sc.j_end(); ++j) {
+                for (idx_t i = sc.i_begin(j); i < sc.i_end(j); ++i) {
+                    order_.emplace_back(sc.index(i, j));
+                }
+            }
+            ATLAS_ASSERT(idx_t(order_.size()) == size_);
+        }
+        return *this;
+    }
+
+    idx_t size() const { return size_; }
+    idx_t operator[](idx_t n) const { return order_.empty() ? n : order_[n]; }
+
+private:
+    StructuredColumns fs_;
+    std::vector<idx_t> order_;
+    idx_t size_{0};
+};
+
 struct PackNodeColumns {
     LocalView<double, 2>& rgpview_;
     IsGhostNode is_ghost;
@@ -609,20 +642,22 @@ struct PackNodeColumns {
 
 struct PackStructuredColumns {
     LocalView<double, 2>& rgpview_;
+    TransOrder trans_order_;
     size_t f;
 
     PackStructuredColumns(LocalView<double, 2>& rgpview): rgpview_(rgpview), f(0) {}
 
     void operator()(const StructuredColumns& sc, const Field& field, idx_t components = 0) {
+        const auto& node = trans_order_(sc);
         switch (field.rank()) {
             case 1:
-                pack_1(sc, field, components);
+                pack_1(node, field, components);
                 break;
             case 2:
-                pack_2(sc, field, components);
+                pack_2(node, field, components);
                 break;
             case 3:
-                pack_3(sc, field, components);
+                pack_3(node, field, components);
                 break;
             default:
                 ATLAS_DEBUG_VAR(field.rank());
@@ -631,25 +666,25 @@ struct PackStructuredColumns {
         }
     }
 
-    void pack_1(const StructuredColumns& sc, const Field& field, idx_t) {
+    void pack_1(const TransOrder& node, const Field& field, idx_t) {
         auto gpfield = make_view<double, 1>(field);
 
-        for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-            rgpview_(f, jnode) = gpfield(jnode);
+        for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+            rgpview_(f, jnode) = gpfield(node[jnode]);
         }
         ++f;
     }
-    void pack_2(const StructuredColumns& sc, const Field& field, idx_t) {
+    void pack_2(const TransOrder& node, const Field& field, idx_t) {
         auto gpfield      = make_view<double, 2>(field);
         const idx_t nvars = gpfield.shape(1);
         for (idx_t jvar = 0; jvar < nvars; ++jvar) {
-            for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-                rgpview_(f, jnode) = gpfield(jnode, jvar);
+            for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+                rgpview_(f, jnode) = gpfield(node[jnode], jvar);
             }
             ++f;
         }
     }
-    void pack_3(const StructuredColumns& sc, const Field& field, idx_t components) {
+    void pack_3(const TransOrder& node, const Field& field, idx_t components) {
         auto gpfield = make_view<double, 3>(field);
         if (not components) {
             components = gpfield.shape(2);
@@ -657,8 +692,8 @@ struct PackStructuredColumns {
         for (idx_t jcomp = 0; jcomp < components; ++jcomp) {
             const idx_t nvars = gpfield.shape(1);
             for (idx_t jvar = 0; jvar < nvars; ++jvar) {
-                for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-                    rgpview_(f, jnode) = gpfield(jnode, jvar, jcomp);
+                for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+                    rgpview_(f, jnode) = gpfield(node[jnode], jvar, jcomp);
                 }
                 ++f;
             }
@@ -781,20 +816,22 @@ struct UnpackNodeColumns {
 
 struct UnpackStructuredColumns {
     const LocalView<double, 2>& rgpview_;
+    TransOrder trans_order_;
     size_t f;
 
     UnpackStructuredColumns(const LocalView<double, 2>& rgpview): rgpview_(rgpview), f(0) {}
 
     void operator()(const StructuredColumns& sc, Field& field, int components = 0) {
+        const auto& node = trans_order_(sc);
         switch (field.rank()) {
             case 1:
-                unpack_1(sc, field, components);
+                unpack_1(node, field, components);
                 break;
             case 2:
-                unpack_2(sc, field, components);
+                unpack_2(node, field, components);
                 break;
             case 3:
-                unpack_3(sc, field, components);
+                unpack_3(node, field, components);
                 break;
             default:
                 ATLAS_DEBUG_VAR(field.rank());
@@ -803,32 +840,32 @@ struct UnpackStructuredColumns {
         }
     }
 
-    void unpack_1(const StructuredColumns& sc, Field& field, idx_t) {
+    void unpack_1(const TransOrder& node, Field& field, idx_t) {
         auto gpfield = make_view<double, 1>(field);
-        for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-            gpfield(jnode) = rgpview_(f, jnode);
+        for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+            gpfield(node[jnode]) = rgpview_(f, jnode);
         }
         ++f;
     }
-    void unpack_2(const StructuredColumns& sc, Field& field, idx_t) {
+    void unpack_2(const TransOrder& node, Field& field, idx_t) {
         auto gpfield      = make_view<double, 2>(field);
         const idx_t nvars = gpfield.shape(1);
         for (idx_t jvar = 0; jvar < nvars; ++jvar) {
-            for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-                gpfield(jnode, jvar) = rgpview_(f, jnode);
+            for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+                gpfield(node[jnode], jvar) = rgpview_(f, jnode);
             }
             ++f;
         }
     }
-    void unpack_3(const StructuredColumns& sc, Field& field, idx_t components) {
+    void unpack_3(const TransOrder& node, Field& field, idx_t components) {
         auto gpfield = make_view<double, 3>(field);
         if (not components) {
             components = gpfield.shape(2);
         }
         for (idx_t jcomp = 0; jcomp < components; ++jcomp) {
             for (idx_t jlev = 0; jlev < gpfield.shape(1); ++jlev) {
-                for (idx_t jnode = 0; jnode < sc.sizeOwned(); ++jnode) {
-                    gpfield(jnode, jlev, jcomp) = rgpview_(f, jnode);
+                for (idx_t jnode = 0; jnode < idx_t(node.size()); ++jnode) {
+                    gpfield(node[jnode], jlev, jcomp) = rgpview_(f, jnode);
                 }
                 ++f;
             }
@@ -2117,22 +2154,24 @@ void TransIFS::__invtrans_grad(const Spectral& sp, const FieldSet& spfields, con
     // Unpack the gridpoint fields
     {
         int f = nfld;  // skip to where derivatives start
+        TransOrder trans_order;
         for (idx_t dim = 0; dim < 2; ++dim) {
             for (idx_t jfld = 0; jfld < gradfields.size(); ++jfld) {
-                const idx_t nb_nodes = StructuredColumns(gradfields[jfld].functionspace()).sizeOwned();
+                const auto& node     = trans_order(StructuredColumns(gradfields[jfld].functionspace()));
+                const idx_t nb_nodes = node.size();
                 const idx_t nlev     = gradfields[jfld].levels();
                 if (nlev) {
                     auto field = make_view<double, 3>(gradfields[jfld]);
                     for (idx_t jlev = 0; jlev < nlev; ++jlev) {
                         for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
-                            field(jnode, jlev, 1 - dim) = rgpview(f, jnode);
+                            field(node[jnode], jlev, 1 - dim) = rgpview(f, jnode);
                         }
                     }
                 }
                 else {
                     auto field = make_view<double, 2>(gradfields[jfld]);
                     for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
-                        field(jnode, 1 - dim) = rgpview(f, jnode);
+                        field(node[jnode], 1 - dim) = rgpview(f, jnode);
                     }
                 }
                 ++f;
@@ -0,0 +1,416 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/trans/local/LegendreButterfly.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace trans {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Interpolative decomposition  M ~ M(:,skeleton) . T  using a column pivoted Householder QR,
+// stopped when the norm of the largest remaining column drops below threshold.
+//   M : column-major rows x cols, overwritten
+//   T : column-major rank x cols, with T(:,skeleton) the identity
+void interpolative_decomposition(std::vector<double>& M, const size_t rows, const size_t cols, const double threshold,
+                                 std::vector<size_t>& skeleton, std::vector<double>& T) {
+    std::vector<size_t> perm(cols);
+    std::iota(perm.begin(), perm.end(), 0);
+
+    std::vector<double> norms(cols);
+    for (size_t c = 0; c < cols; ++c) {
+        const double* mc = M.data() + rows * c;
+        double norm      = 0.;
+        for (size_t i = 0; i < rows; ++i) {
+            norm += mc[i] * mc[i];
+        }
+        norms[c] = norm;
+    }
+
+    const double threshold2 = threshold * threshold;
+    const size_t kmax       = std::min(rows, cols);
+    std::vector<double> v(rows);
+    size_t k = 0;
+    for (; k < kmax; ++k) {
+        size_t p = k;
+        for (size_t c = k + 1; c < cols; ++c) {
+            if (norms[c] > norms[p]) {
+                p = c;
+            }
+        }
+        if (norms[p] <= threshold2) {
+            break;
+        }
+        if (p != k) {
+            std::swap_ranges(M.begin() + rows * k, M.begin() + rows * (k + 1), M.begin() + rows * p);
+            std::swap(perm[k], perm[p]);
+            std::swap(norms[k], norms[p]);
+        }
+
+        // Householder reflection annihilating M(k+1:rows,k)
+        double* mk   = M.data() + rows * k;
+        double alpha = 0.;
+        for (size_t i = k; i < rows; ++i) {
+            alpha += mk[i] * mk[i];
+        }
+        alpha = (mk[k] > 0.) ? -std::sqrt(alpha) : std::sqrt(alpha);
+        double vnorm2 = 0.;
+        v[k]          = mk[k] - alpha;
+        vnorm2 += v[k] * v[k];
+        for (size_t i = k + 1; i < rows; ++i) {
+            v[i] = mk[i];
+            vnorm2 += v[i] * v[i];
+            mk[i] = 0.;
+        }
+        mk[k] = alpha;
+
+        for (size_t c = k + 1; c < cols; ++c) {
+            double* mc = M.data() + rows * c;
+            if (vnorm2 > 0.) {
+                double dot = 0.;
+                for (size_t i = k; i < rows; ++i) {
+                    dot += v[i] * mc[i];
+                }
+                const double f = 2. * dot / vnorm2;
+                for (size_t i = k; i < rows; ++i) {
+                    mc[i] -= f * v[i];
+                }
+            }
+            // recompute rather than downdate, for stability
+            double norm = 0.;
+            for (size_t i = k + 1; i < rows; ++i) {
+                norm += mc[i] * mc[i];
+            }
+            norms[c] = norm;
+        }
+    }
+
+    // T(:,perm[0:k]) = I,  T(:,perm[k:cols]) = R11^{-1} R12
+    const size_t rank = k;
+    skeleton.assign(perm.begin(), perm.begin() + rank);
+    T.assign(rank * cols, 0.);
+    for (size_t i = 0; i < rank; ++i) {
+        T[i + rank * perm[i]] = 1.;
+    }
+    std::vector<double> x(rank);
+    for (size_t j = rank; j < cols; ++j) {
+        const double* mj = M.data() + rows * j;
+        for (size_t ii = rank; ii-- > 0;) {
+            double sum = mj[ii];
+            for (size_t l = ii + 1; l < rank; ++l) {
+                sum -= M[ii + rows * l] * x[l];
+            }
+            x[ii] = sum / M[ii + rows * ii];
+        }
+        for (size_t i = 0; i < rank; ++i) {
+            T[i + rank * perm[j]] = x[i];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// out(v,i) = sum_j M(i,j) in(v,j)
+//   M   : column-major m x n
+//   in  : column-major nvec x n
+//   out : column-major nvec x m
+inline void apply_block(const size_t m, const size_t n, const size_t nvec, const double* M, const double* in,
+                        double* out) {
+    for (size_t i = 0; i < m; ++i) {
+        double* out_i = out + nvec * i;
+        for (size_t v = 0; v < nvec; ++v) {
+            out_i[v] = 0.;
+        }
+        for (size_t j = 0; j < n; ++j) {
+            const double mij  = M[i + m * j];
+            const double* inj = in + nvec * j;
+            for (size_t v = 0; v < nvec; ++v) {
+                out_i[v] += mij * inj[v];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+LegendreButterfly LegendreButterfly::compress(const double legendre[], const size_t nwavenumbers, const size_t nlats,
+                                              const double tolerance, const size_t leaf_size) {
+    ATLAS_ASSERT(leaf_size > 0);
+    LegendreButterfly b;
+    b.nrows_ = nlats;
+    b.ncols_ = nwavenumbers;
+
+    auto A = [&](size_t i, size_t j) { return legendre[j + nwavenumbers * i]; };
+
+    size_t L = 0;
+    while ((nwavenumbers >> (L + 1)) >= leaf_size && (nlats >> (L + 1)) >= leaf_size) {
+        ++L;
+    }
+
+    if (L == 0) {
+        b.data_storage_.resize(nlats * nwavenumbers);
+        for (size_t j = 0; j < nwavenumbers; ++j) {
+            for (size_t i = 0; i < nlats; ++i) {
+                b.data_storage_[i + nlats * j] = A(i, j);
+            }
+        }
+        b.data_  = b.data_storage_.data();
+        b.ndata_ = b.data_storage_.size();
+        return b;
+    }
+
+    b.nlevels_        = L;
+    const size_t nb   = size_t(1) << L;
+    b.nnodes_         = (L + 1) * nb;
+    const auto nnodes = b.nnodes_;
+
+    // Tolerance relative to the largest column of the whole matrix
+    double max_norm = 0.;
+    for (size_t j = 0; j < nwavenumbers; ++j) {
+        double norm = 0.;
+        for (size_t i = 0; i < nlats; ++i) {
+            norm += A(i, j) * A(i, j);
+        }
+        max_norm = std::max(max_norm, norm);
+    }
+    const double threshold = tolerance * std::sqrt(max_norm);
+
+    std::vector<std::vector<size_t>> skeleton(nnodes);
+    std::vector<std::vector<double>> T(nnodes);
+
+    // level 0: column blocks over all rows
+    atlas_omp_parallel_for(size_t j = 0; j < nb; ++j) {
+        const size_t c0    = b.col_begin(j);
+        const size_t ncols = b.col_begin(j + 1) - c0;
+        std::vector<double> M(nlats * ncols);
+        for (size_t c = 0; c < ncols; ++c) {
+            for (size_t i = 0; i < nlats; ++i) {
+                M[i + nlats * c] = A(i, c0 + c);
+            }
+        }
+        std::vector<size_t> idx;
+        interpolative_decomposition(M, nlats, ncols, threshold, idx, T[j]);
+        skeleton[j].resize(idx.size());
+        for (size_t s = 0; s < idx.size(); ++s) {
+            skeleton[j][s] = c0 + idx[s];
+        }
+    }
+
+    // levels 1..L: bisect rows, merge pairs of column groups
+    for (size_t l = 1; l <= L; ++l) {
+        const size_t ngroups = size_t(1) << (L - l);
+        atlas_omp_parallel_for(size_t local = 0; local < nb; ++local) {
+            const size_t r      = local / ngroups;
+            const size_t g      = local % ngroups;
+            const size_t a      = (l - 1) * nb + (r / 2) * (2 * ngroups) + 2 * g;
+            const size_t node   = l * nb + local;
+            const size_t r0     = b.row_begin(l, r);
+            const size_t nrows  = b.row_begin(l, r + 1) - r0;
+            std::vector<size_t> C(skeleton[a]);
+            C.insert(C.end(), skeleton[a + 1].begin(), skeleton[a + 1].end());
+
+            std::vector<double> M(nrows * C.size());
+            for (size_t c = 0; c < C.size(); ++c) {
+                for (size_t i = 0; i < nrows; ++i) {
+                    M[i + nrows * c] = A(r0 + i, C[c]);
+                }
+            }
+            std::vector<size_t> idx;
+            interpolative_decomposition(M, nrows, C.size(), threshold, idx, T[node]);
+            skeleton[node].resize(idx.size());
+            for (size_t s = 0; s < idx.size(); ++s) {
+                skeleton[node][s] = C[idx[s]];
+            }
+        }
+    }
+
+    // Pack ranks, interpolation matrices and final dense blocks A(rows, skeleton)
+    b.ranks_storage_.resize(nnodes);
+    size_t ndata = 0;
+    for (size_t node = 0; node < nnodes; ++node) {
+        b.ranks_storage_[node] = static_cast<int64_t>(skeleton[node].size());
+        ndata += T[node].size();
+    }
+    for (size_t r = 0; r < nb; ++r) {
+        ndata += (b.row_begin(L, r + 1) - b.row_begin(L, r)) * skeleton[L * nb + r].size();
+    }
+    b.data_storage_.reserve(ndata);
+    for (size_t node = 0; node < nnodes; ++node) {
+        b.data_storage_.insert(b.data_storage_.end(), T[node].begin(), T[node].end());
+    }
+    for (size_t r = 0; r < nb; ++r) {
+        const auto& S      = skeleton[L * nb + r];
+        const size_t r0    = b.row_begin(L, r);
+        const size_t nrows = b.row_begin(L, r + 1) - r0;
+        for (size_t s = 0; s < S.size(); ++s) {
+            for (size_t i = 0; i < nrows; ++i) {
+                b.data_storage_.push_back(A(r0 + i, S[s]));
+            }
+        }
+    }
+    ATLAS_ASSERT(b.data_storage_.size() == ndata);
+
+    b.ranks_ = b.ranks_storage_.data();
+    b.data_  = b.data_storage_.data();
+    b.ndata_ = ndata;
+    b.setup_offsets();
+    return b;
+}
+
+//-----------------------------------------------------------------------------
+
+void LegendreButterfly::setup_offsets() {
+    if (nnodes_ == 0) {
+        ATLAS_ASSERT(ndata_ == nrows_ * ncols_);
+        return;
+    }
+    const size_t L  = nlevels_;
+    const size_t nb = size_t(1) << L;
+    offsets_.resize(nnodes_ + nb + 1);
+    size_t offset = 0;
+    for (size_t j = 0; j < nb; ++j) {
+        offsets_[j] = offset;
+        offset += size_t(ranks_[j]) * (col_begin(j + 1) - col_begin(j));
+    }
+    for (size_t l = 1; l <= L; ++l) {
+        const size_t ngroups = size_t(1) << (L - l);
+        for (size_t local = 0; local < nb; ++local) {
+            const size_t r    = local / ngroups;
+            const size_t g    = local % ngroups;
+            const size_t a    = (l - 1) * nb + (r / 2) * (2 * ngroups) + 2 * g;
+            const size_t node = l * nb + local;
+            offsets_[node]    = offset;
+            offset += size_t(ranks_[node]) * size_t(ranks_[a] + ranks_[a + 1]);
+        }
+    }
+    for (size_t r = 0; r < nb; ++r) {
+        offsets_[nnodes_ + r] = offset;
+        offset += (row_begin(L, r + 1) - row_begin(L, r)) * size_t(ranks_[L * nb + r]);
+    }
+    offsets_[nnodes_ + nb] = offset;
+    ATLAS_ASSERT(offset == ndata_);
+}
+
+//-----------------------------------------------------------------------------
+
+void LegendreButterfly::apply(const size_t nvec, const double x[], double y[]) const {
+    if (nnodes_ == 0) {
+        apply_block(nrows_, ncols_, nvec, data_, x, y);
+        return;
+    }
+
+    const size_t L  = nlevels_;
+    const size_t nb = size_t(1) << L;
+
+    std::vector<double> z_prev;
+    std::vector<double> z_curr;
+    std::vector<size_t> zoffset_prev(nb + 1);
+    std::vector<size_t> zoffset_curr(nb + 1);
+
+    auto allocate_level = [&](size_t l) {
+        zoffset_curr[0] = 0;
+        for (size_t local = 0; local < nb; ++local) {
+            zoffset_curr[local + 1] = zoffset_curr[local] + nvec * size_t(ranks_[l * nb + local]);
+        }
+        z_curr.resize(zoffset_curr[nb]);
+    };
+
+    // level 0
+    allocate_level(0);
+    atlas_omp_parallel_for(size_t j = 0; j < nb; ++j) {
+        const size_t c0 = col_begin(j);
+        apply_block(size_t(ranks_[j]), col_begin(j + 1) - c0, nvec, data_ + offsets_[j], x + nvec * c0,
+                    z_curr.data() + zoffset_curr[j]);
+    }
+
+    // levels 1..L
+    for (size_t l = 1; l <= L; ++l) {
+        std::swap(z_prev, z_curr);
+        std::swap(zoffset_prev, zoffset_curr);
+        allocate_level(l);
+        const size_t ngroups = size_t(1) << (L - l);
+        atlas_omp_parallel_for(size_t local = 0; local < nb; ++local) {
+            const size_t r    = local / ngroups;
+            const size_t g    = local % ngroups;
+            const size_t a    = (r / 2) * (2 * ngroups) + 2 * g;  // children a and a+1 are contiguous in z_prev
+            const size_t node = l * nb + local;
+            const size_t n    = size_t(ranks_[(l - 1) * nb + a] + ranks_[(l - 1) * nb + a + 1]);
+            apply_block(size_t(ranks_[node]), n, nvec, data_ + offsets_[node], z_prev.data() + zoffset_prev[a],
+                        z_curr.data() + zoffset_curr[local]);
+        }
+    }
+
+    // final dense blocks
+    atlas_omp_parallel_for(size_t r = 0; r < nb; ++r) {
+        const size_t r0 = row_begin(L, r);
+        apply_block(row_begin(L, r + 1) - r0, size_t(ranks_[L * nb + r]), nvec, data_ + offsets_[nnodes_ + r],
+                    z_curr.data() + zoffset_curr[r], y + nvec * r0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t LegendreButterfly::serialized_size() const {
+    return 5 * sizeof(int64_t) + nnodes_ * sizeof(int64_t) + ndata_ * sizeof(double);
+}
+
+char* LegendreButterfly::serialize(char* buffer) const {
+    int64_t header[5] = {int64_t(nrows_), int64_t(ncols_), int64_t(nlevels_), int64_t(nnodes_), int64_t(ndata_)};
+    std::memcpy(buffer, header, sizeof(header));
+    buffer += sizeof(header);
+    if (nnodes_) {
+        std::memcpy(buffer, ranks_, nnodes_ * sizeof(int64_t));
+        buffer += nnodes_ * sizeof(int64_t);
+    }
+    std::memcpy(buffer, data_, ndata_ * sizeof(double));
+    buffer += ndata_ * sizeof(double);
+    return buffer;
+}
+
+LegendreButterfly LegendreButterfly::deserialize(const char*& buffer) {
+    LegendreButterfly b;
+    const int64_t* header = reinterpret_cast<const int64_t*>(buffer);
+    b.nrows_              = size_t(header[0]);
+    b.ncols_              = size_t(header[1]);
+    b.nlevels_            = size_t(header[2]);
+    b.nnodes_             = size_t(header[3]);
+    b.ndata_              = size_t(header[4]);
+    buffer += 5 * sizeof(int64_t);
+    b.ranks_ = reinterpret_cast<const int64_t*>(buffer);
+    buffer += b.nnodes_ * sizeof(int64_t);
+    b.data_ = reinterpret_cast<const double*>(buffer);
+    buffer += b.ndata_ * sizeof(double);
+    b.setup_offsets();
+    return b;
+}
+
+bool LegendreButterfly::is_cache(const void* data, size_t size) {
+    if (data == nullptr || size < cache_header_size()) {
+        return false;
+    }
+    int64_t magic;
+    std::memcpy(&magic, data, sizeof(int64_t));
+    return magic == cache_magic();
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
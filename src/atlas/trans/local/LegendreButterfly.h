@@ -0,0 +1,108 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atlas {
+namespace trans {
+
+//-----------------------------------------------------------------------------
+// Butterfly compressed representation of the matrix of associated Legendre
+// functions for one zonal wavenumber (and one parity), used for the fast
+// Legendre transform (flt) in TransLocal.
+//
+// The matrix A (nlats x nwavenumbers) is compressed following
+//   M. O'Neil, F. Woolfe, V. Rokhlin, An algorithm for the rapid evaluation
+//   of special function transforms, Appl. Comput. Harmon. Anal. 28 (2010)
+// and
+//   M. Tygert, Fast algorithms for spherical harmonic expansions, III,
+//   J. Comput. Phys. 229 (2010)
+//
+// Columns are split into 2^L blocks, which are merged pairwise at each level
+// while rows are bisected. At every level the blocks are represented by an
+// interpolative decomposition on a subset of "skeleton" columns, so that
+// applying the matrix costs O(N log N) rather than O(N^2) per zonal wavenumber.
+//
+// The compressed data can be stored in, and used directly from, a Legendre cache
+// (see serialize/deserialize).
+//
+class LegendreButterfly {
+public:
+    LegendreButterfly()                         = default;
+    LegendreButterfly(LegendreButterfly&&)      = default;
+    LegendreButterfly(const LegendreButterfly&) = delete;
+    LegendreButterfly& operator=(LegendreButterfly&&) = default;
+    LegendreButterfly& operator=(const LegendreButterfly&) = delete;
+
+    // Compress the matrix A(i,j) = legendre[ j + nwavenumbers * i ], with i in [0,nlats) and j in [0,nwavenumbers),
+    // which is the (column-major, nwavenumbers x nlats) storage used for the dense Legendre coefficients.
+    // Matrices smaller than 2*leaf_size in either dimension are stored as dense blocks.
+    static LegendreButterfly compress(const double legendre[], const size_t nwavenumbers, const size_t nlats,
+                                      const double tolerance, const size_t leaf_size);
+
+    // y = A . x  for nvec vectors:
+    //   x : column-major nvec x nwavenumbers
+    //   y : column-major nvec x nlats
+    void apply(const size_t nvec, const double x[], double y[]) const;
+
+    size_t nlats() const { return nrows_; }
+    size_t nwavenumbers() const { return ncols_; }
+    size_t levels() const { return nlevels_; }
+
+    // Number of stored coefficients, to compare against nlats * nwavenumbers for the dense matrix
+    size_t footprint() const { return ndata_; }
+
+    // -- Serialisation into a contiguous buffer, all entries 8-byte aligned
+    size_t serialized_size() const;
+    char* serialize(char* buffer) const;
+
+    // Reference data in the buffer without copying it, and advance the buffer past this butterfly
+    static LegendreButterfly deserialize(const char*& buffer);
+
+    // -- Legendre cache layout for the fast Legendre transform:
+    //    header { magic, version, number of butterflies } followed by the serialized butterflies
+    //    There is no dedicated cache type: a LegendreCache holding dense coefficients (raw doubles or floats) is
+    //    distinguished from a compressed one only by this magic header, see is_cache().
+    static constexpr int64_t cache_magic() { return 0x464c545f534c5441; }  // "ATLS_TLF"
+    static constexpr int64_t cache_version() { return 1; }
+    static constexpr size_t cache_header_size() { return 3 * sizeof(int64_t); }
+    static bool is_cache(const void* data, size_t size);
+
+private:
+    void setup_offsets();
+
+    size_t row_begin(size_t level, size_t r) const { return (r * nrows_) >> level; }
+    size_t col_begin(size_t j) const { return (j * ncols_) >> nlevels_; }
+
+private:
+    size_t nrows_{0};
+    size_t ncols_{0};
+    size_t nlevels_{0};
+    size_t nnodes_{0};  // (nlevels+1) * 2^nlevels interpolation nodes, 0 for a dense block
+    size_t ndata_{0};
+
+    const int64_t* ranks_{nullptr};  // rank of each interpolation node
+    const double* data_{nullptr};    // interpolation matrices, followed by the final dense blocks
+
+    std::vector<size_t> offsets_;  // offsets in data_ of each node, followed by each final dense block
+
+    // storage when not referencing external memory
+    std::vector<int64_t> ranks_storage_;
+    std::vector<double> data_storage_;
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
@@ -57,6 +57,11 @@ std::string hash(const eckit::Configuration& config) {
 
     // Add options and other unique keys
     h << "flt" << config.getBool("flt", false);
+    // Only added for non-default precision, to keep identifiers of existing double precision caches
+    std::string precision = config.getString("precision", "double");
+    if (precision != "double") {
+        h << "precision" << precision;
+    }
 
     return truncate(h.digest());
 }
@@ -146,7 +151,8 @@ Cache LegendreCacheCreatorLocal::create() const {
 }
 
 size_t LegendreCacheCreatorLocal::estimate() const {
-    return size_t(truncation_ * truncation_ * truncation_) / 2 * sizeof(double);
+    const size_t value_size = config_.getString("precision", "double") == "single" ? sizeof(float) : sizeof(double);
+    return size_t(truncation_ * truncation_ * truncation_) / 2 * value_size;
 }
 
 
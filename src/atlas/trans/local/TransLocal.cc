@@ -10,9 +10,11 @@
 
 #include "atlas/trans/local/TransLocal.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
+#include <type_traits>
 
 #include "atlas/linalg/dense.h"
 #include "eckit/config/YAMLConfiguration.h"
@@ -29,11 +31,13 @@
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/Trans.h"
 #include "atlas/trans/VorDivToUV.h"
 #include "atlas/trans/detail/TransFactory.h"
+#include "atlas/trans/local/LegendreButterfly.h"
 #include "atlas/trans/local/LegendrePolynomials.h"
 #include "atlas/util/Constants.h"
 
@@ -48,6 +52,10 @@ static constexpr double latPole = 89.9999999;
 // (latPole=89.9999999 seems to produce the best accuracy. Moving it further away
 //  or closer to the pole both increase the errors!)
 
+// accuracy and smallest block size of the butterfly compression used for the fast Legendre transform (flt)
+static constexpr double flt_tolerance = 1.e-13;
+static constexpr size_t flt_leaf_size = 32;
+
 namespace atlas {
 namespace trans {
 
@@ -83,6 +91,8 @@ public:
 
     bool export_legendre() const { return config_.getBool("export_legendre", false); }
 
+    bool flt() const { return config_.getBool("flt", false); }
+
     int warning() const { return config_.getInt("warning", 1); }
 
     int fft() const {
@@ -97,6 +107,15 @@ public:
 
     std::string matrix_multiply() const { return config_.getString("matrix_multiply", ""); }
 
+    bool single_precision() const {
+        std::string precision = config_.getString("precision", "double");
+        if (precision != "double" && precision != "single") {
+            throw_Exception("TransLocal: unsupported precision \"" + precision + "\", expected \"double\" or \"single\"",
+                            Here());
+        }
+        return precision == "single";
+    }
+
 
 private:
     const eckit::Configuration& config_;
@@ -186,32 +205,65 @@ size_t num_n(const int truncation, const int m, const bool symmetric) {
 }
 
 
-void alloc_aligned(double*& ptr, size_t n) {
+template <typename Value>
+void alloc_aligned(Value*& ptr, size_t n) {
     const size_t alignment = 64 * sizeof(double);
-    size_t bytes           = sizeof(double) * n;
+    size_t bytes           = sizeof(Value) * n;
     int err                = posix_memalign((void**)&ptr, alignment, bytes);
     if (err) {
         throw_AllocationFailed(bytes, Here());
     }
 }
 
-void free_aligned(double*& ptr) {
+template <typename Value>
+void free_aligned(Value*& ptr) {
     free(ptr);
     ptr = nullptr;
 }
 
-void alloc_aligned(double*& ptr, size_t n, const char* msg) {
+template <typename Value>
+void alloc_aligned(Value*& ptr, size_t n, const char* msg) {
     ATLAS_ASSERT(msg);
-    Log::debug() << "TransLocal: allocating '" << msg << "': " << eckit::Bytes(sizeof(double) * n) << std::endl;
+    Log::debug() << "TransLocal: allocating '" << msg << "': " << eckit::Bytes(sizeof(Value) * n) << std::endl;
     alloc_aligned(ptr, n);
 }
 
-void free_aligned(double*& ptr, const char* msg) {
+template <typename Value>
+void free_aligned(Value*& ptr, const char* msg) {
     ATLAS_ASSERT(msg);
     Log::debug() << "TransLocal: deallocating '" << msg << "'" << std::endl;
     free_aligned(ptr);
 }
 
+void copy_to_single_precision(const double* in, size_t n, float* out) {
+    for (size_t j = 0; j < n; ++j) {
+        out[j] = static_cast<float>(in[j]);
+    }
+}
+
+// Access spectral data in the working precision, converting only if needed
+const double* spectra_in_precision(const double* spectra, size_t, std::vector<double>&) {
+    return spectra;
+}
+
+const float* spectra_in_precision(const double* spectra, size_t size, std::vector<float>& buffer) {
+    buffer.assign(spectra, spectra + size);
+    return buffer.data();
+}
+
+template <typename Value>
+struct MatrixType;
+template <>
+struct MatrixType<double> {
+    using type = linalg::Matrix;
+};
+template <>
+struct MatrixType<float> {
+    using type = linalg::MatrixFloat;
+};
+template <typename Value>
+using LinalgMatrix = typename MatrixType<Value>::type;
+
 size_t add_padding(size_t n) {
     return size_t(std::ceil(n / 8.)) * 8;
 }
@@ -284,10 +336,72 @@ struct FFTW_Data {
     fftw_complex* in;
     double* out;
     std::vector<fftw_plan> plans;
+#if ATLAS_HAVE_FFTW_SINGLE
+    fftwf_complex* in_sp;
+    float* out_sp;
+    std::vector<fftwf_plan> plans_sp;
+#endif
 #endif
 };
 }  // namespace detail
 
+#if ATLAS_HAVE_FFTW
+namespace {
+// Selects the FFTW buffers and plans matching the precision of the Fourier coefficients
+template <typename Value>
+struct FFTW;
+
+template <>
+struct FFTW<double> {
+    static fftw_complex* in(detail::FFTW_Data& fftw) { return fftw.in; }
+    static double* out(detail::FFTW_Data& fftw) { return fftw.out; }
+    static void execute(detail::FFTW_Data& fftw, int jplan) {
+        fftw_execute_dft_c2r(fftw.plans[jplan], fftw.in, fftw.out);
+    }
+};
+
+#if ATLAS_HAVE_FFTW_SINGLE
+template <>
+struct FFTW<float> {
+    static fftwf_complex* in(detail::FFTW_Data& fftw) { return fftw.in_sp; }
+    static float* out(detail::FFTW_Data& fftw) { return fftw.out_sp; }
+    static void execute(detail::FFTW_Data& fftw, int jplan) {
+        fftwf_execute_dft_c2r(fftw.plans_sp[jplan], fftw.in_sp, fftw.out_sp);
+    }
+};
+#else
+// Without single precision FFTW, single precision Fourier coefficients are transformed with double precision plans
+template <>
+struct FFTW<float> : FFTW<double> {};
+#endif
+}  // namespace
+#endif
+
+template <>
+double* TransLocal::legendre_sym<double>() const {
+    return legendre_sym_;
+}
+template <>
+float* TransLocal::legendre_sym<float>() const {
+    return legendre_sym_sp_;
+}
+template <>
+double* TransLocal::legendre_asym<double>() const {
+    return legendre_asym_;
+}
+template <>
+float* TransLocal::legendre_asym<float>() const {
+    return legendre_asym_sp_;
+}
+template <>
+double* TransLocal::fourier<double>() const {
+    return fourier_;
+}
+template <>
+float* TransLocal::fourier<float>() const {
+    return fourier_sp_;
+}
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // Class TransLocal
@@ -327,6 +441,17 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
     useFFT_           = TransParameters(config).fft();
     unstruct_precomp_ = (config.has("precompute") ? precompute_ : false);
     no_symmetry_      = false;
+    single_precision_ = TransParameters(config).single_precision();
+    flt_              = TransParameters(config).flt();
+    if (flt_ && single_precision_) {
+        throw_NotImplemented("TransLocal: fast Legendre transform (flt) is only implemented for precision \"double\"",
+                             Here());
+    }
+    if (flt_ && not(StructuredGrid(grid_) && not grid_.projection())) {
+        throw_NotImplemented(
+            "TransLocal: fast Legendre transform (flt) is only implemented for structured grids without projection",
+            Here());
+    }
     nlatsNH_          = 0;
     nlatsSH_          = 0;
     nlatsLeg_         = 0;
@@ -370,6 +495,12 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 nlatsLegDomain_ = nlatsNH_;
                 gridGlobal_     = grid_;
                 useGlobalLeg    = false;
+                if (flt_) {
+                    Log::warning() << "TransLocal: fast Legendre transform (flt) is not used for regional regular "
+                                      "grids; using the dense Legendre transform instead"
+                                   << std::endl;
+                    flt_ = false;
+                }
             }
             else {  // non-nested reduced grids are not supported
                 std::ostringstream log;
@@ -543,6 +674,8 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
             }
         }
         Log::debug() << " - fft: " << std::boolalpha << useFFT_ << '\n';
+        Log::debug() << " - precision: " << (single_precision_ ? "single" : "double") << '\n';
+        Log::debug() << " - flt: " << std::boolalpha << flt_ << '\n';
         Log::debug() << " - linalg_backend: ";
         if (using_eckit_default_backend(linalg_backend_)) {
             Log::debug() << "eckit_linalg default (currently \"" << detect_linalg_backend(linalg_backend_)
@@ -570,7 +703,178 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 legendre_asym_begin_[jm + 1] = size_asym;
             }
 
-            if (legendre_cache_) {
+            // Compressed and dense Legendre caches are both plain LegendreCache buffers; they are told apart
+            // by the header magic written by the fast Legendre transform (see LegendreButterfly::is_cache).
+            if (not flt_ && legendre_cache_ && LegendreButterfly::is_cache(legendre_cache_, legendre_cachesize_)) {
+                throw_Exception("TransLocal: Legendre cache contains compressed coefficients for the fast Legendre "
+                                "transform; use option \"flt\"",
+                                Here());
+            }
+            if (flt_) {
+                // Fast Legendre transform: the Legendre coefficients for each zonal wavenumber are compressed
+                // in butterfly form. A Legendre cache may contain either the compressed or the dense coefficients.
+                const size_t nbutterflies = 2 * size_t(truncation_ + 1);
+                butterfly_sym_.resize(truncation_ + 1);
+                butterfly_asym_.resize(truncation_ + 1);
+                if (legendre_cache_ && LegendreButterfly::is_cache(legendre_cache_, legendre_cachesize_)) {
+                    ReadCache legendre(legendre_cache_);
+                    const int64_t* header = legendre.read<int64_t>(3);
+                    ATLAS_ASSERT(header[2] == static_cast<int64_t>(nbutterflies));
+                    const char* buffer = legendre.begin + legendre.pos;
+                    for (idx_t jm = 0; jm <= truncation_; jm++) {
+                        butterfly_sym_[jm]  = LegendreButterfly::deserialize(buffer);
+                        butterfly_asym_[jm] = LegendreButterfly::deserialize(buffer);
+                    }
+                    ATLAS_ASSERT(size_t(buffer - legendre.begin) == legendre_cachesize_);
+                }
+                else {
+                    double* legendre_sym_dp  = nullptr;
+                    double* legendre_asym_dp = nullptr;
+                    if (legendre_cache_) {
+                        ATLAS_ASSERT(legendre_cachesize_ == sizeof(double) * (size_sym + size_asym));
+                        ReadCache legendre(legendre_cache_);
+                        legendre_sym_dp  = legendre.read<double>(size_sym);
+                        legendre_asym_dp = legendre.read<double>(size_asym);
+                    }
+                    else {
+                        alloc_aligned(legendre_sym_dp, size_sym, "Legendre coeffs symmetric (uncompressed)");
+                        alloc_aligned(legendre_asym_dp, size_asym, "Legendre coeffs asymmetric (uncompressed)");
+                        ATLAS_TRACE_SCOPE("Legendre precomputations (structured)") {
+                            compute_legendre_polynomials(truncation_ + 1, nlatsLeg_, lats.data(), legendre_sym_dp,
+                                                         legendre_asym_dp, legendre_sym_begin_.data(),
+                                                         legendre_asym_begin_.data());
+                        }
+                    }
+                    ATLAS_TRACE_SCOPE("Legendre butterfly compression") {
+                        atlas_omp_parallel_for(idx_t jm = 0; jm <= truncation_; jm++) {
+                            const size_t size_sym_jm  = num_n(truncation_ + 1, jm, /*symmetric*/ true);
+                            const size_t size_asym_jm = num_n(truncation_ + 1, jm, /*symmetric*/ false);
+                            const size_t nlats_jm     = nlatsLegReduced_ - nlat0_[jm];
+                            if (size_sym_jm > 0 && nlats_jm > 0) {
+                                butterfly_sym_[jm] = LegendreButterfly::compress(
+                                    legendre_sym_dp + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym_jm, size_sym_jm,
+                                    nlats_jm, flt_tolerance, flt_leaf_size);
+                            }
+                            if (size_asym_jm > 0 && nlats_jm > 0) {
+                                butterfly_asym_[jm] = LegendreButterfly::compress(
+                                    legendre_asym_dp + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym_jm,
+                                    size_asym_jm, nlats_jm, flt_tolerance, flt_leaf_size);
+                            }
+                        }
+                    }
+                    if (not legendre_cache_) {
+                        free_aligned(legendre_sym_dp, "Legendre coeffs symmetric (uncompressed)");
+                        free_aligned(legendre_asym_dp, "Legendre coeffs asymmetric (uncompressed)");
+                    }
+                    size_t footprint = 0;
+                    size_t bytes     = LegendreButterfly::cache_header_size();
+                    for (idx_t jm = 0; jm <= truncation_; jm++) {
+                        footprint += butterfly_sym_[jm].footprint() + butterfly_asym_[jm].footprint();
+                        bytes += butterfly_sym_[jm].serialized_size() + butterfly_asym_[jm].serialized_size();
+                    }
+                    Log::debug() << "TransLocal: compressed Legendre coefficients: "
+                                 << eckit::Bytes(sizeof(double) * footprint) << " (uncompressed: "
+                                 << eckit::Bytes(sizeof(double) * (size_sym + size_asym)) << ")" << std::endl;
+
+                    auto serialize = [&](char* buffer) {
+                        int64_t* header = reinterpret_cast<int64_t*>(buffer);
+                        header[0]       = LegendreButterfly::cache_magic();
+                        header[1]       = LegendreButterfly::cache_version();
+                        header[2]       = static_cast<int64_t>(nbutterflies);
+                        buffer += LegendreButterfly::cache_header_size();
+                        for (idx_t jm = 0; jm <= truncation_; jm++) {
+                            buffer = butterfly_sym_[jm].serialize(buffer);
+                            buffer = butterfly_asym_[jm].serialize(buffer);
+                        }
+                    };
+
+                    if (TransParameters(config).export_legendre()) {
+                        ATLAS_ASSERT(not cache_.legendre());
+                        Log::debug() << "TransLocal: allocating LegendreCache: " << eckit::Bytes(bytes) << std::endl;
+                        export_legendre_ = LegendreCache(bytes);
+                        serialize(reinterpret_cast<char*>(const_cast<void*>(export_legendre_.legendre().data())));
+                        legendre_cachesize_ = export_legendre_.legendre().size();
+                        legendre_cache_     = export_legendre_.legendre().data();
+                    }
+                    std::string file_path = TransParameters(config).write_legendre();
+                    if (file_path.size()) {
+                        ATLAS_TRACE("Write LegendreCache to file");
+                        Log::debug() << "Writing Legendre cache file (butterfly compressed) ..." << std::endl;
+                        Log::debug() << "    path: " << file_path << std::endl;
+                        std::vector<char> buffer(bytes);
+                        serialize(buffer.data());
+                        WriteCache legendre(file_path);
+                        legendre.write(buffer.data(), bytes);
+                        Log::debug() << "    size: " << eckit::Bytes(legendre.pos) << std::endl;
+                    }
+                }
+                legendre_sym_  = nullptr;
+                legendre_asym_ = nullptr;
+            }
+            else if (single_precision_) {
+                // Coefficients are computed in double precision and rounded to single precision.
+                // A Legendre cache may contain either single or double precision coefficients.
+                const size_t bytes_sp = sizeof(float) * (size_sym + size_asym);
+                if (legendre_cache_ && legendre_cachesize_ == bytes_sp) {
+                    ReadCache legendre(legendre_cache_);
+                    legendre_sym_sp_  = legendre.read<float>(size_sym);
+                    legendre_asym_sp_ = legendre.read<float>(size_asym);
+                }
+                else {
+                    const bool from_cache = legendre_cache_;
+                    double* legendre_sym_dp;
+                    double* legendre_asym_dp;
+                    if (from_cache) {
+                        ATLAS_ASSERT(legendre_cachesize_ == sizeof(double) * (size_sym + size_asym));
+                        ReadCache legendre(legendre_cache_);
+                        legendre_sym_dp  = legendre.read<double>(size_sym);
+                        legendre_asym_dp = legendre.read<double>(size_asym);
+                    }
+                    else {
+                        alloc_aligned(legendre_sym_dp, size_sym, "Legendre coeffs symmetric (double precision)");
+                        alloc_aligned(legendre_asym_dp, size_asym, "Legendre coeffs asymmetric (double precision)");
+                        ATLAS_TRACE_SCOPE("Legendre precomputations (structured)") {
+                            compute_legendre_polynomials(truncation_ + 1, nlatsLeg_, lats.data(), legendre_sym_dp,
+                                                         legendre_asym_dp, legendre_sym_begin_.data(),
+                                                         legendre_asym_begin_.data());
+                        }
+                    }
+
+                    if (not from_cache && TransParameters(config).export_legendre()) {
+                        ATLAS_ASSERT(not cache_.legendre());
+                        Log::debug() << "TransLocal: allocating LegendreCache: " << eckit::Bytes(bytes_sp) << std::endl;
+                        export_legendre_    = LegendreCache(bytes_sp);
+                        legendre_cachesize_ = export_legendre_.legendre().size();
+                        legendre_cache_     = export_legendre_.legendre().data();
+                        ReadCache legendre(legendre_cache_);
+                        legendre_sym_sp_  = legendre.read<float>(size_sym);
+                        legendre_asym_sp_ = legendre.read<float>(size_asym);
+                    }
+                    else {
+                        alloc_aligned(legendre_sym_sp_, size_sym, "Legendre coeffs symmetric");
+                        alloc_aligned(legendre_asym_sp_, size_asym, "Legendre coeffs asymmetric");
+                        legendre_sp_owned_ = true;
+                    }
+                    copy_to_single_precision(legendre_sym_dp, size_sym, legendre_sym_sp_);
+                    copy_to_single_precision(legendre_asym_dp, size_asym, legendre_asym_sp_);
+
+                    if (not from_cache) {
+                        free_aligned(legendre_sym_dp, "Legendre coeffs symmetric (double precision)");
+                        free_aligned(legendre_asym_dp, "Legendre coeffs asymmetric (double precision)");
+                        std::string file_path = TransParameters(config).write_legendre();
+                        if (file_path.size()) {
+                            ATLAS_TRACE("Write LegendreCache to file");
+                            Log::debug() << "Writing Legendre cache file (single precision) ..." << std::endl;
+                            Log::debug() << "    path: " << file_path << std::endl;
+                            WriteCache legendre(file_path);
+                            legendre.write(legendre_sym_sp_, size_sym);
+                            legendre.write(legendre_asym_sp_, size_asym);
+                            Log::debug() << "    size: " << eckit::Bytes(legendre.pos) << std::endl;
+                        }
+                    }
+                }
+            }
+            else if (legendre_cache_) {
                 ReadCache legendre(legendre_cache_);
                 legendre_sym_  = legendre.read<double>(size_sym);
                 legendre_asym_ = legendre.read<double>(size_asym);
@@ -619,57 +923,91 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
             {
                 ATLAS_TRACE("Fourier precomputations (FFTW)");
                 int num_complex = (nlonsMaxGlobal_ / 2) + 1;
-                fftw_->in       = fftw_alloc_complex(nlats * num_complex);
-                fftw_->out      = fftw_alloc_real(nlats * nlonsMaxGlobal_);
-
-                if (fft_cache_) {
-                    Log::debug() << "Import FFTW wisdom from cache" << std::endl;
-                    fftw_import_wisdom_from_string(static_cast<const char*>(fft_cache_));
-                }
-                //                std::string wisdomString( "" );
-                //                std::ifstream read( "wisdom.bin" );
-                //                if ( read.is_open() ) {
-                //                    std::getline( read, wisdomString );
-                //                    while ( read ) {
-                //                        std::string line;
-                //                        std::getline( read, line );
-                //                        wisdomString += line;
-                //                    }
-                //                }
-                //                read.close();
-                //                if ( wisdomString.length() > 0 ) { fftw_import_wisdom_from_string( &wisdomString[0u] ); }
-                if (RegularGrid(gridGlobal_)) {
-                    fftw_->plans.resize(1);
-                    fftw_->plans[0] =
-                        fftw_plan_many_dft_c2r(1, &nlonsMaxGlobal_, nlats, fftw_->in, nullptr, 1, num_complex,
-                                               fftw_->out, nullptr, 1, nlonsMaxGlobal_, FFTW_ESTIMATE);
-                }
-                else {
-                    fftw_->plans.resize(nlatsLegDomain_);
-                    for (int j = 0; j < nlatsLegDomain_; j++) {
-                        int nlonsGlobalj = gs_global.nx(jlatMinLeg_ + j);
-                        //ASSERT( nlonsGlobalj > 0 && nlonsGlobalj <= nlonsMaxGlobal_ );
-                        fftw_->plans[j] = fftw_plan_dft_c2r_1d(nlonsGlobalj, fftw_->in, fftw_->out, FFTW_ESTIMATE);
+#if ATLAS_HAVE_FFTW_SINGLE
+                if (single_precision_) {
+                    fftw_->in_sp  = fftwf_alloc_complex(nlats * num_complex);
+                    fftw_->out_sp = fftwf_alloc_real(nlats * nlonsMaxGlobal_);
+                    if (fft_cache_) {
+                        Log::debug() << "Import FFTW wisdom (single precision) from cache" << std::endl;
+                        fftwf_import_wisdom_from_string(static_cast<const char*>(fft_cache_));
+                    }
+                    if (RegularGrid(gridGlobal_)) {
+                        fftw_->plans_sp.resize(1);
+                        fftw_->plans_sp[0] =
+                            fftwf_plan_many_dft_c2r(1, &nlonsMaxGlobal_, nlats, fftw_->in_sp, nullptr, 1, num_complex,
+                                                    fftw_->out_sp, nullptr, 1, nlonsMaxGlobal_, FFTW_ESTIMATE);
+                    }
+                    else {
+                        fftw_->plans_sp.resize(nlatsLegDomain_);
+                        for (int j = 0; j < nlatsLegDomain_; j++) {
+                            int nlonsGlobalj   = gs_global.nx(jlatMinLeg_ + j);
+                            fftw_->plans_sp[j] =
+                                fftwf_plan_dft_c2r_1d(nlonsGlobalj, fftw_->in_sp, fftw_->out_sp, FFTW_ESTIMATE);
+                        }
+                    }
+                    std::string file_path = TransParameters(config).write_fft();
+                    if (file_path.size()) {
+                        Log::debug() << "Write FFTW wisdom (single precision) to file " << file_path << std::endl;
+                        FILE* file_fftw = fopen(file_path.c_str(), "wb");
+                        fftwf_export_wisdom_to_file(file_fftw);
+                        fclose(file_fftw);
                     }
                 }
-                std::string file_path = TransParameters(config).write_fft();
-                if (file_path.size()) {
-                    Log::debug() << "Write FFTW wisdom to file " << file_path << std::endl;
-                    //bool success = fftw_export_wisdom_to_filename( "wisdom.bin" );
-                    //ASSERT( success );
-                    //std::ofstream write( file_path );
-                    //write << FFTW_Wisdom();
-
-                    FILE* file_fftw = fopen(file_path.c_str(), "wb");
-                    fftw_export_wisdom_to_file(file_fftw);
-                    fclose(file_fftw);
+                else
+#endif
+                {
+                    fftw_->in       = fftw_alloc_complex(nlats * num_complex);
+                    fftw_->out      = fftw_alloc_real(nlats * nlonsMaxGlobal_);
+
+                    if (fft_cache_) {
+                        Log::debug() << "Import FFTW wisdom from cache" << std::endl;
+                        fftw_import_wisdom_from_string(static_cast<const char*>(fft_cache_));
+                    }
+                    //                std::string wisdomString( "" );
+                    //                std::ifstream read( "wisdom.bin" );
+                    //                if ( read.is_open() ) {
+                    //                    std::getline( read, wisdomString );
+                    //                    while ( read ) {
+                    //                        std::string line;
+                    //                        std::getline( read, line );
+                    //                        wisdomString += line;
+                    //                    }
+                    //                }
+                    //                read.close();
+                    //                if ( wisdomString.length() > 0 ) { fftw_import_wisdom_from_string( &wisdomString[0u] ); }
+                    if (RegularGrid(gridGlobal_)) {
+                        fftw_->plans.resize(1);
+                        fftw_->plans[0] =
+                            fftw_plan_many_dft_c2r(1, &nlonsMaxGlobal_, nlats, fftw_->in, nullptr, 1, num_complex,
+                                                   fftw_->out, nullptr, 1, nlonsMaxGlobal_, FFTW_ESTIMATE);
+                    }
+                    else {
+                        fftw_->plans.resize(nlatsLegDomain_);
+                        for (int j = 0; j < nlatsLegDomain_; j++) {
+                            int nlonsGlobalj = gs_global.nx(jlatMinLeg_ + j);
+                            //ASSERT( nlonsGlobalj > 0 && nlonsGlobalj <= nlonsMaxGlobal_ );
+                            fftw_->plans[j] = fftw_plan_dft_c2r_1d(nlonsGlobalj, fftw_->in, fftw_->out, FFTW_ESTIMATE);
+                        }
+                    }
+                    std::string file_path = TransParameters(config).write_fft();
+                    if (file_path.size()) {
+                        Log::debug() << "Write FFTW wisdom to file " << file_path << std::endl;
+                        //bool success = fftw_export_wisdom_to_filename( "wisdom.bin" );
+                        //ASSERT( success );
+                        //std::ofstream write( file_path );
+                        //write << FFTW_Wisdom();
+
+                        FILE* file_fftw = fopen(file_path.c_str(), "wb");
+                        fftw_export_wisdom_to_file(file_fftw);
+                        fclose(file_fftw);
+                    }
+                    //                std::string newWisdom( fftw_export_wisdom_to_string() );
+                    //                if ( 1.1 * wisdomString.length() < newWisdom.length() ) {
+                    //                    std::ofstream write( "wisdom.bin" );
+                    //                    write << newWisdom;
+                    //                    write.close();
+                    //                }
                 }
-                //                std::string newWisdom( fftw_export_wisdom_to_string() );
-                //                if ( 1.1 * wisdomString.length() < newWisdom.length() ) {
-                //                    std::ofstream write( "wisdom.bin" );
-                //                    write << newWisdom;
-                //                    write.close();
-                //                }
             }
             // other FFT implementations should be added with #elif statements
 #else
@@ -722,10 +1060,20 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 }
             }
 #endif
+            if (single_precision_) {
+                alloc_aligned(fourier_sp_, 2 * (truncation_ + 1) * nlonsMax, "Fourier coeffs (single precision)");
+                copy_to_single_precision(fourier_, 2 * (truncation_ + 1) * nlonsMax, fourier_sp_);
+                free_aligned(fourier_, "Fourier coeffs");
+            }
         }
     }
     else {
         // unstructured grid
+        if (single_precision_) {
+            throw_NotImplemented(
+                "TransLocal with precision \"single\" is only implemented for structured grids without projection",
+                Here());
+        }
         if (unstruct_precomp_) {
             ATLAS_TRACE("Legendre precomputations (unstructured)");
 
@@ -772,18 +1120,39 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const long truncati
 
 TransLocal::~TransLocal() {
     if (StructuredGrid(grid_) && not grid_.projection()) {
-        if (not legendre_cache_) {
+        if (single_precision_) {
+            if (legendre_sp_owned_) {
+                free_aligned(legendre_sym_sp_, "symmetric");
+                free_aligned(legendre_asym_sp_, "asymmetric");
+            }
+        }
+        else if (not legendre_cache_) {
             free_aligned(legendre_sym_, "symmetric");
             free_aligned(legendre_asym_, "asymmetric");
         }
         if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
-            for (idx_t j = 0, size = static_cast<idx_t>(fftw_->plans.size()); j < size; j++) {
-                fftw_destroy_plan(fftw_->plans[j]);
+#if ATLAS_HAVE_FFTW_SINGLE
+            if (single_precision_) {
+                for (idx_t j = 0, size = static_cast<idx_t>(fftw_->plans_sp.size()); j < size; j++) {
+                    fftwf_destroy_plan(fftw_->plans_sp[j]);
+                }
+                fftwf_free(fftw_->in_sp);
+                fftwf_free(fftw_->out_sp);
             }
-            fftw_free(fftw_->in);
-            fftw_free(fftw_->out);
+            else
 #endif
+            {
+                for (idx_t j = 0, size = static_cast<idx_t>(fftw_->plans.size()); j < size; j++) {
+                    fftw_destroy_plan(fftw_->plans[j]);
+                }
+                fftw_free(fftw_->in);
+                fftw_free(fftw_->out);
+            }
+#endif
+        }
+        else if (single_precision_) {
+            free_aligned(fourier_sp_, "Fourier coeffs (single precision)");
         }
         else {
             free_aligned(fourier_, "Fourier coeffs.");
@@ -924,16 +1293,23 @@ void TransLocal::invtrans(const int nb_scalar_fields, const double scalar_spectr
 
 // --------------------------------------------------------------------------------------------------------------------
 
+template <typename Value>
 void TransLocal::invtrans_legendre(const int truncation, const int nlats, const int nb_fields,
-                                   const int /*nb_vordiv_fields*/, const double scalar_spectra[], double scl_fourier[],
+                                   const int /*nb_vordiv_fields*/, const Value scalar_spectra[], Value scl_fourier[],
                                    const eckit::Configuration&) const {
     // Legendre transform:
     {
-        Log::debug() << "TransLocal::invtrans_legendre: Legendre GEMM with \"" << detect_linalg_backend(linalg_backend_)
-                     << "\" using " << nlatsLegReduced_ - nlat0_[0] << " latitudes out of " << nlatsGlobal_ / 2
-                     << std::endl;
+        if (flt_) {
+            Log::debug() << "TransLocal::invtrans_legendre: fast Legendre transform (butterfly) using "
+                         << nlatsLegReduced_ - nlat0_[0] << " latitudes out of " << nlatsGlobal_ / 2 << std::endl;
+        }
+        else {
+            Log::debug() << "TransLocal::invtrans_legendre: Legendre GEMM with \""
+                         << detect_linalg_backend(linalg_backend_) << "\" using " << nlatsLegReduced_ - nlat0_[0]
+                         << " latitudes out of " << nlatsGlobal_ / 2 << std::endl;
+        }
         linalg::dense::Backend linalg_backend{linalg_backend_};
-        ATLAS_TRACE("Inverse Legendre Transform (GEMM)");
+        ATLAS_TRACE(flt_ ? "Inverse Legendre Transform (butterfly)" : "Inverse Legendre Transform (GEMM)");
         for (int jm = 0; jm <= truncation_; jm++) {
             size_t size_sym  = num_n(truncation_ + 1, jm, true);
             size_t size_asym = num_n(truncation_ + 1, jm, false);
@@ -945,10 +1321,10 @@ void TransLocal::invtrans_legendre(const int truncation, const int nlats, const
                 };
                 // THESE ARE REALLOCATED FOR EACH jm ???
                 // THEY COULD ALLOCATED ONCE BEFORE jm LOOP WITH A MAXIMUM SIZE?
-                double* scalar_sym;
-                double* scalar_asym;
-                double* scl_fourier_sym;
-                double* scl_fourier_asym;
+                Value* scalar_sym;
+                Value* scalar_asym;
+                Value* scl_fourier_sym;
+                Value* scl_fourier_asym;
                 alloc_aligned(scalar_sym, n_imag * nb_fields * size_sym);
                 alloc_aligned(scalar_asym, n_imag * nb_fields * size_asym);
                 alloc_aligned(scl_fourier_sym, size_fourier);
@@ -989,13 +1365,22 @@ void TransLocal::invtrans_legendre(const int truncation, const int nlats, const
                     ATLAS_ASSERT(size_t(ia) == n_imag * nb_fields * size_asym &&
                                  size_t(is) == n_imag * nb_fields * size_sym);
                 }
-                if (nlatsLegReduced_ - nlat0_[jm] > 0) {
+                if (flt_ && nlatsLegReduced_ - nlat0_[jm] > 0) {
+                    if constexpr (std::is_same<Value, double>::value) {
+                        ATLAS_TRACE("butterfly apply");
+                        butterfly_sym_[jm].apply(nb_fields * n_imag, scalar_sym, scl_fourier_sym);
+                        if (size_asym > 0) {
+                            butterfly_asym_[jm].apply(nb_fields * n_imag, scalar_asym, scl_fourier_asym);
+                        }
+                    }
+                }
+                else if (nlatsLegReduced_ - nlat0_[jm] > 0) {
                     ATLAS_TRACE("matrix_multiply (" + std::string(linalg_backend) + ")");
                     {
-                        linalg::Matrix A(scalar_sym, nb_fields * n_imag, size_sym);
-                        linalg::Matrix B(legendre_sym_ + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym, size_sym,
-                                         nlatsLegReduced_ - nlat0_[jm]);
-                        linalg::Matrix C(scl_fourier_sym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        LinalgMatrix<Value> A(scalar_sym, nb_fields * n_imag, size_sym);
+                        LinalgMatrix<Value> B(legendre_sym<Value>() + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym,
+                                              size_sym, nlatsLegReduced_ - nlat0_[jm]);
+                        LinalgMatrix<Value> C(scl_fourier_sym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
                         linalg::matrix_multiply(A, B, C, linalg_backend);
                         /*Log::info() << "sym: ";
                         for ( int j = 0; j < size_sym * ( nlatsLegReduced_ - nlat0_[jm] ); j++ ) {
@@ -1004,10 +1389,11 @@ void TransLocal::invtrans_legendre(const int truncation, const int nlats, const
                         Log::info() << std::endl;*/
                     }
                     if (size_asym > 0) {
-                        linalg::Matrix A(scalar_asym, nb_fields * n_imag, size_asym);
-                        linalg::Matrix B(legendre_asym_ + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym, size_asym,
-                                         nlatsLegReduced_ - nlat0_[jm]);
-                        linalg::Matrix C(scl_fourier_asym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        LinalgMatrix<Value> A(scalar_asym, nb_fields * n_imag, size_asym);
+                        LinalgMatrix<Value> B(legendre_asym<Value>() + legendre_asym_begin_[jm] +
+                                                  nlat0_[jm] * size_asym,
+                                              size_asym, nlatsLegReduced_ - nlat0_[jm]);
+                        LinalgMatrix<Value> C(scl_fourier_asym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
                         linalg::matrix_multiply(A, B, C, linalg_backend);
                         /*Log::info() << "asym: ";
                         for ( int j = 0; j < size_asym * ( nlatsLegReduced_ - nlat0_[jm] ); j++ ) {
@@ -1086,39 +1472,41 @@ void TransLocal::invtrans_legendre(const int truncation, const int nlats, const
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, double scl_fourier[],
+template <typename Value>
+void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, Value scl_fourier[],
                                           double gp_fields[], const eckit::Configuration&) const {
     // Fourier transformation:
     if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
         {
             int num_complex = (nlonsMaxGlobal_ / 2) + 1;
+            auto fftw_in    = FFTW<Value>::in(*fftw_);
+            auto fftw_out   = FFTW<Value>::out(*fftw_);
             {
                 ATLAS_TRACE("Inverse Fourier Transform (FFTW, RegularGrid)");
                 for (int jfld = 0; jfld < nb_fields; jfld++) {
                     int idx = 0;
                     for (int jlat = 0; jlat < nlats; jlat++) {
-                        fftw_->in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
+                        fftw_in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
                         for (int jm = 1; jm < num_complex; jm++, idx++) {
                             for (int imag = 0; imag < 2; imag++) {
                                 if (jm <= truncation_) {
-                                    fftw_->in[idx][imag] =
-                                        scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
+                                    fftw_in[idx][imag] = scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
                                 }
                                 else {
-                                    fftw_->in[idx][imag] = 0.;
+                                    fftw_in[idx][imag] = 0.;
                                 }
                             }
                         }
                     }
-                    fftw_execute_dft_c2r(fftw_->plans[0], fftw_->in, fftw_->out);
+                    FFTW<Value>::execute(*fftw_, 0);
                     for (int jlat = 0; jlat < nlats; jlat++) {
                         for (int jlon = 0; jlon < nlons; jlon++) {
                             int j = jlon + jlonMin_[0];
                             if (j >= nlonsMaxGlobal_) {
                                 j -= nlonsMaxGlobal_;
                             }
-                            gp_fields[jlon + nlons * (jlat + nlats * jfld)] = fftw_->out[j + nlonsMaxGlobal_ * jlat];
+                            gp_fields[jlon + nlons * (jlat + nlats * jfld)] = fftw_out[j + nlonsMaxGlobal_ * jlat];
                         }
                     }
                 }
@@ -1133,23 +1521,33 @@ void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, cons
         {
             ATLAS_TRACE("Inverse Fourier Transform (NoFFT,matrix_multiply=" + detect_linalg_backend(linalg_backend_) +
                         ")");
-            linalg::Matrix A(fourier_, nlons, (truncation_ + 1) * 2);
-            linalg::Matrix B(scl_fourier, (truncation_ + 1) * 2, nb_fields * nlats);
-            linalg::Matrix C(gp_fields, nlons, nb_fields * nlats);
-
-            linalg::matrix_multiply(A, B, C, linalg_backend);
+            LinalgMatrix<Value> A(fourier<Value>(), nlons, (truncation_ + 1) * 2);
+            LinalgMatrix<Value> B(scl_fourier, (truncation_ + 1) * 2, nb_fields * nlats);
+            if constexpr (std::is_same<Value, double>::value) {
+                LinalgMatrix<Value> C(gp_fields, nlons, nb_fields * nlats);
+                linalg::matrix_multiply(A, B, C, linalg_backend);
+            }
+            else {
+                // compute in working precision, then widen into the double precision output
+                Value* gp;
+                alloc_aligned(gp, nb_fields * nlats * nlons);
+                LinalgMatrix<Value> C(gp, nlons, nb_fields * nlats);
+                linalg::matrix_multiply(A, B, C, linalg_backend);
+                std::copy(gp, gp + nb_fields * nlats * nlons, gp_fields);
+                free_aligned(gp);
+            }
         }
 #else
         // dgemm-method 2
         // should be faster for small domains or large truncation
         // but have not found any significant speedup so far
-        double* gp;
+        Value* gp;
         alloc_aligned(gp, nb_fields * grid_.size());
         {
             ATLAS_TRACE("Fourier dgemm method 2");
-            linalg::Matrix A(scl_fourier, nb_fields * nlats, (truncation_ + 1) * 2);
-            linalg::Matrix B(fourier_, (truncation_ + 1) * 2, nlons);
-            linalg::Matrix C(gp, nb_fields * nlats, nlons);
+            LinalgMatrix<Value> A(scl_fourier, nb_fields * nlats, (truncation_ + 1) * 2);
+            LinalgMatrix<Value> B(fourier<Value>(), (truncation_ + 1) * 2, nlons);
+            LinalgMatrix<Value> C(gp, nb_fields * nlats, nlons);
             linalg::matrix_multiply(A, B, C, linalg_backend);
         }
 
@@ -1174,12 +1572,15 @@ void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, cons
 
 // --------------------------------------------------------------------------------------------------------------------
 
+template <typename Value>
 void TransLocal::invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields,
-                                          double scl_fourier[], double gp_fields[], const eckit::Configuration&) const {
+                                          Value scl_fourier[], double gp_fields[], const eckit::Configuration&) const {
     // Fourier transformation:
     if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
         {
+            auto fftw_in  = FFTW<Value>::in(*fftw_);
+            auto fftw_out = FFTW<Value>::out(*fftw_);
             {
                 ATLAS_TRACE("Inverse Fourier Transform (FFTW, ReducedGrid)");
                 int jgp = 0;
@@ -1188,18 +1589,17 @@ void TransLocal::invtrans_fourier_reduced(const int nlats, const StructuredGrid&
                         int idx = 0;
                         //Log::info() << jlat << "in:" << std::endl;
                         int num_complex     = (nlonsGlobal_[jlat] / 2) + 1;
-                        fftw_->in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
-                        //Log::info() << fftw_->in[0][0] << " ";
+                        fftw_in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
+                        //Log::info() << fftw_in[0][0] << " ";
                         for (int jm = 1; jm < num_complex; jm++, idx++) {
                             for (int imag = 0; imag < 2; imag++) {
                                 if (jm <= truncation_) {
-                                    fftw_->in[idx][imag] =
-                                        scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
+                                    fftw_in[idx][imag] = scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
                                 }
                                 else {
-                                    fftw_->in[idx][imag] = 0.;
+                                    fftw_in[idx][imag] = 0.;
                                 }
-                                //Log::info() << fftw_->in[idx][imag] << " ";
+                                //Log::info() << fftw_in[idx][imag] << " ";
                             }
                         }
                         //Log::info() << std::endl;
@@ -1209,15 +1609,15 @@ void TransLocal::invtrans_fourier_reduced(const int nlats, const StructuredGrid&
                             jplan = nlats - 1 + nlatsLegDomain_ - nlatsSH_ - jlat;
                         };
                         //ASSERT( jplan < nlatsLeg_ && jplan >= 0 );
-                        fftw_execute_dft_c2r(fftw_->plans[jplan], fftw_->in, fftw_->out);
+                        FFTW<Value>::execute(*fftw_, jplan);
                         for (int jlon = 0; jlon < g.nx(jlat); jlon++) {
                             int j = jlon + jlonMin_[jlat];
                             if (j >= nlonsGlobal_[jlat]) {
                                 j -= nlonsGlobal_[jlat];
                             }
-                            //Log::info() << fftw_->out[j] << " ";
+                            //Log::info() << fftw_out[j] << " ";
                             ATLAS_ASSERT(j < nlonsMaxGlobal_);
-                            gp_fields[jgp++] = fftw_->out[j];
+                            gp_fields[jgp++] = fftw_out[j];
                         }
                         //Log::info() << std::endl;
                     }
@@ -1428,6 +1828,71 @@ void TransLocal::invtrans_unstructured(const int truncation, const int nb_fields
     free_aligned(zfn);
 }
 
+template <typename Value>
+void TransLocal::invtrans_structured(const int truncation, const int nb_scalar_fields, const int nb_vordiv_fields,
+                                     const double scalar_spectra[], double gp_fields[],
+                                     const eckit::Configuration& config) const {
+    int nb_fields = nb_scalar_fields;
+    auto g        = StructuredGrid(grid_);
+    ATLAS_TRACE("invtrans_uv structured");
+    int nlats            = g.ny();
+    int nlons            = g.nxmax();
+    int size_fourier_max = nb_fields * 2 * nlats;
+    Value* scl_fourier;
+    alloc_aligned(scl_fourier, size_fourier_max * (truncation_ + 1));
+
+    std::vector<Value> spectra_buffer;
+    const Value* spectra =
+        spectra_in_precision(scalar_spectra, 2 * legendre_size(truncation) * nb_fields, spectra_buffer);
+
+    // ATLAS-159 workaround begin
+    for (int i = 0; i < size_fourier_max * (truncation_ + 1); ++i) {
+        scl_fourier[i] = 0.;
+    }
+    // ATLAS-159 workaround end
+
+    // Legendre transformation:
+    invtrans_legendre(truncation, nlats, nb_scalar_fields, nb_vordiv_fields, spectra, scl_fourier, config);
+
+    // Fourier transformation:
+    if (RegularGrid(gridGlobal_)) {
+        invtrans_fourier_regular(nlats, nlons, nb_fields, scl_fourier, gp_fields, config);
+    }
+    else {
+        invtrans_fourier_reduced(nlats, g, nb_fields, scl_fourier, gp_fields, config);
+    }
+
+    // Computing u,v from U,V:
+    {
+        if (nb_vordiv_fields > 0) {
+            ATLAS_TRACE("compute u,v from U,V");
+            std::vector<double> coslatinvs(nlats);
+            for (idx_t j = 0; j < nlats; ++j) {
+                double lat = g.y(j);
+                if (lat > latPole) {
+                    lat = latPole;
+                }
+                if (lat < -latPole) {
+                    lat = -latPole;
+                }
+                double coslat = std::cos(lat * util::Constants::degreesToRadians());
+                coslatinvs[j] = 1. / coslat;
+                //Log::info() << "lat=" << g.y( j ) << " coslat=" << coslat << std::endl;
+            }
+            int idx = 0;
+            for (idx_t jfld = 0; jfld < 2 * nb_vordiv_fields && jfld < nb_fields; jfld++) {
+                for (idx_t jlat = 0; jlat < g.ny(); jlat++) {
+                    for (idx_t jlon = 0; jlon < g.nx(jlat); jlon++) {
+                        gp_fields[idx] *= coslatinvs[jlat];
+                        idx++;
+                    }
+                }
+            }
+        }
+    }
+    free_aligned(scl_fourier);
+}
+
 //-----------------------------------------------------------------------------
 // Routine to compute the spectral transform by using a Local Fourier transformation
 // for a grid (same latitude for all longitudes, allows to compute Legendre functions
@@ -1447,65 +1912,16 @@ void TransLocal::invtrans_uv(const int truncation, const int nb_scalar_fields, c
                              const double scalar_spectra[], double gp_fields[],
                              const eckit::Configuration& config) const {
     if (nb_scalar_fields > 0) {
-        int nb_fields = nb_scalar_fields;
-
         // Transform
         if (StructuredGrid(grid_) && not grid_.projection()) {
-            auto g = StructuredGrid(grid_);
-            ATLAS_TRACE("invtrans_uv structured");
-            int nlats            = g.ny();
-            int nlons            = g.nxmax();
-            int size_fourier_max = nb_fields * 2 * nlats;
-            double* scl_fourier;
-            alloc_aligned(scl_fourier, size_fourier_max * (truncation_ + 1));
-
-            // ATLAS-159 workaround begin
-            for (int i = 0; i < size_fourier_max * (truncation_ + 1); ++i) {
-                scl_fourier[i] = 0.;
-            }
-            // ATLAS-159 workaround end
-
-            // Legendre transformation:
-            invtrans_legendre(truncation, nlats, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, scl_fourier,
-                              config);
-
-            // Fourier transformation:
-            if (RegularGrid(gridGlobal_)) {
-                invtrans_fourier_regular(nlats, nlons, nb_fields, scl_fourier, gp_fields, config);
+            if (single_precision_) {
+                invtrans_structured<float>(truncation, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, gp_fields,
+                                           config);
             }
             else {
-                invtrans_fourier_reduced(nlats, g, nb_fields, scl_fourier, gp_fields, config);
-            }
-
-            // Computing u,v from U,V:
-            {
-                if (nb_vordiv_fields > 0) {
-                    ATLAS_TRACE("compute u,v from U,V");
-                    std::vector<double> coslatinvs(nlats);
-                    for (idx_t j = 0; j < nlats; ++j) {
-                        double lat = g.y(j);
-                        if (lat > latPole) {
-                            lat = latPole;
-                        }
-                        if (lat < -latPole) {
-                            lat = -latPole;
-                        }
-                        double coslat = std::cos(lat * util::Constants::degreesToRadians());
-                        coslatinvs[j] = 1. / coslat;
-                        //Log::info() << "lat=" << g.y( j ) << " coslat=" << coslat << std::endl;
-                    }
-                    int idx = 0;
-                    for (idx_t jfld = 0; jfld < 2 * nb_vordiv_fields && jfld < nb_fields; jfld++) {
-                        for (idx_t jlat = 0; jlat < g.ny(); jlat++) {
-                            for (idx_t jlon = 0; jlon < g.nx(jlat); jlon++) {
-                                gp_fields[idx] *= coslatinvs[jlat];
-                                idx++;
-                            }
-                        }
-                    }
-                }
+                invtrans_structured<double>(truncation, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, gp_fields,
+                                            config);
             }
-            free_aligned(scl_fourier);
         }
         else {
             if (unstruct_precomp_) {
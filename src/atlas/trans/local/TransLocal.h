@@ -18,6 +18,7 @@
 #include "atlas/grid/Grid.h"
 #include "atlas/linalg/dense/Backend.h"
 #include "atlas/trans/detail/TransImpl.h"
+#include "atlas/trans/local/LegendreButterfly.h"
 
 #define TRANSLOCAL_DGEMM2 0
 
@@ -72,6 +73,21 @@ int fourier_truncation(const int truncation,  // truncation
 ///        - "lapack"  : "lapack"  backend for eckit::linalg::LinearAlgebra
 ///        - "openmp"  : "openmp"  backend for eckit::linalg::LinearAlgebra, or "generic" if "openmp" is not available.
 ///        - "eigen"   : "eigen"   backend for eckit::linalg::LinearAlgebra
+///
+/// @note: The precision of the internal buffers, Legendre coefficients and FFTs can be chosen with the "precision" key
+///        in the Configuration argument in the constructor (see atlas::option::precision):
+///        - "double" (default)
+///        - "single" : halves memory use and bandwidth of the Legendre and Fourier stages for structured grids.
+///                     Spectral and gridpoint data are still passed as double. FFTs use fftwf plans if available.
+///                     Legendre caches created with precision "single" contain float coefficients.
+///
+/// @note: The fast Legendre transform can be enabled with the "flt" key (see atlas::option::flt) for structured grids.
+///        The Legendre coefficients of each zonal wavenumber are then compressed with a butterfly algorithm
+///        (see LegendreButterfly), reducing memory and cost of the Legendre stage at high truncations.
+///        Legendre caches created with "flt" contain the compressed coefficients. Only precision "double" is supported.
+///        Grids without projection are required; for regional regular grids "flt" is ignored with a warning.
+///        Compressed caches are regular LegendreCache objects, recognised by a magic header (see
+///        LegendreButterfly::is_cache); passing one to a TransLocal without "flt" throws.
 
 class TransLocal : public trans::TransImpl {
 public:
@@ -181,16 +197,33 @@ private:
 #endif
     }
 
+    template <typename Value>
+    void invtrans_structured(const int truncation, const int nb_scalar_fields, const int nb_vordiv_fields,
+                             const double scalar_spectra[], double gp_fields[],
+                             const eckit::Configuration& config) const;
+
+    template <typename Value>
     void invtrans_legendre(const int truncation, const int nlats, const int nb_fields, const int nb_vordiv_fields,
-                           const double scalar_spectra[], double scl_fourier[],
+                           const Value scalar_spectra[], Value scl_fourier[],
                            const eckit::Configuration& config) const;
 
-    void invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, double scl_fourier[],
+    template <typename Value>
+    void invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, Value scl_fourier[],
                                   double gp_fields[], const eckit::Configuration& config) const;
 
-    void invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields, double scl_fourier[],
+    template <typename Value>
+    void invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields, Value scl_fourier[],
                                   double gp_fields[], const eckit::Configuration& config) const;
 
+    template <typename Value>
+    Value* legendre_sym() const;
+
+    template <typename Value>
+    Value* legendre_asym() const;
+
+    template <typename Value>
+    Value* fourier() const;
+
     void invtrans_unstructured_precomp(const int truncation, const int nb_scalar_fields, const int nb_vordiv_fields,
                                        const double scalar_spectra[], double gp_fields[],
                                        const eckit::Configuration& = util::NoConfig()) const;
@@ -215,6 +248,8 @@ private:
     bool dgemmMethod1_;
     bool unstruct_precomp_;
     bool no_symmetry_;
+    bool single_precision_;
+    bool flt_;
     int truncation_;
     idx_t nlatsNH_;
     idx_t nlatsSH_;
@@ -234,6 +269,12 @@ private:
     double* legendre_asym_;
     double* fourier_;
     double* fouriertp_;
+    float* legendre_sym_sp_{nullptr};
+    float* legendre_asym_sp_{nullptr};
+    float* fourier_sp_{nullptr};
+    bool legendre_sp_owned_{false};
+    std::vector<LegendreButterfly> butterfly_sym_;
+    std::vector<LegendreButterfly> butterfly_asym_;
     std::vector<size_t> legendre_begin_;
     std::vector<size_t> legendre_sym_begin_;
     std::vector<size_t> legendre_asym_begin_;
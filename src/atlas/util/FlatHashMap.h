@@ -0,0 +1,248 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+namespace util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+/// Mix bits of integer keys (splitmix64 finalizer), so that consecutive or strided keys such as
+/// unique identifiers are spread over all buckets
+inline size_t flat_hash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<size_t>(x);
+}
+
+template <typename Key>
+struct FlatHashSetPolicy {
+    using slot_type = Key;
+    static const Key& key(const slot_type& slot) { return slot; }
+    static void init(slot_type& slot, const Key& key) { slot = key; }
+};
+
+template <typename Key, typename Value>
+struct FlatHashMapPolicy {
+    using slot_type = std::pair<Key, Value>;
+    static const Key& key(const slot_type& slot) { return slot.first; }
+    static void init(slot_type& slot, const Key& key) {
+        slot.first  = key;
+        slot.second = Value();
+    }
+};
+
+/// Open addressing hash table with linear probing for integral keys.
+/// Entries are stored contiguously, and the load factor is kept below 1/2.
+/// Entries cannot be erased individually; use clear() which keeps the allocated capacity.
+template <typename Key, typename Policy>
+class FlatHashTable {
+    static_assert(std::is_integral<Key>::value, "FlatHashTable requires integral keys");
+
+public:
+    using key_type  = Key;
+    using slot_type = typename Policy::slot_type;
+
+    template <typename Table, typename Slot>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename std::remove_const<Slot>::type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Slot*;
+        using reference         = Slot&;
+
+        Iterator() = default;
+        Iterator(Table* table, size_t pos): table_(table), pos_(pos) { skip_empty(); }
+        Slot& operator*() const { return table_->slots_[pos_]; }
+        Slot* operator->() const { return &table_->slots_[pos_]; }
+        Iterator& operator++() {
+            ++pos_;
+            skip_empty();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return pos_ == other.pos_; }
+        bool operator!=(const Iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+        void skip_empty() {
+            while (pos_ < table_->used_.size() && not table_->used_[pos_]) {
+                ++pos_;
+            }
+        }
+        Table* table_{nullptr};
+        size_t pos_{0};
+    };
+
+    using iterator       = Iterator<FlatHashTable, slot_type>;
+    using const_iterator = Iterator<const FlatHashTable, const slot_type>;
+
+public:
+    FlatHashTable() = default;
+    explicit FlatHashTable(size_t n) { reserve(n); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return used_.size() / 2; }
+
+    void clear() {
+        used_.assign(used_.size(), 0);
+        size_ = 0;
+    }
+
+    void reserve(size_t n) {
+        if (2 * n > used_.size()) {
+            rehash(2 * n);
+        }
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, used_.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, used_.size()); }
+
+    iterator find(const Key& key) {
+        if (used_.empty()) {
+            return end();
+        }
+        size_t pos = lookup(key);
+        return used_[pos] ? iterator(this, pos) : end();
+    }
+
+    const_iterator find(const Key& key) const {
+        if (used_.empty()) {
+            return end();
+        }
+        size_t pos = lookup(key);
+        return used_[pos] ? const_iterator(this, pos) : end();
+    }
+
+    size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    bool contains(const Key& key) const { return not used_.empty() && used_[lookup(key)]; }
+
+    size_t footprint() const { return sizeof(*this) + used_.capacity() + slots_.capacity() * sizeof(slot_type); }
+
+protected:
+    /// Find position of key, inserting it if not yet present. Returns the position and whether it was inserted.
+    std::pair<size_t, bool> insert_key(const Key& key) {
+        if (2 * (size_ + 1) > used_.size()) {
+            rehash(2 * (size_ + 1));
+        }
+        size_t pos = lookup(key);
+        if (used_[pos]) {
+            return {pos, false};
+        }
+        used_[pos] = 1;
+        Policy::init(slots_[pos], key);
+        ++size_;
+        return {pos, true};
+    }
+
+    /// Position of key, or of the empty slot where it would be inserted
+    size_t lookup(const Key& key) const {
+        const size_t mask = used_.size() - 1;
+        size_t pos        = flat_hash(static_cast<uint64_t>(key)) & mask;
+        while (used_[pos] && Policy::key(slots_[pos]) != key) {
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+    void rehash(size_t min_buckets) {
+        size_t buckets = 16;
+        while (buckets < min_buckets) {
+            buckets *= 2;
+        }
+        std::vector<char> used(buckets, 0);
+        std::vector<slot_type> slots(buckets);
+        used_.swap(used);
+        slots_.swap(slots);
+        for (size_t j = 0; j < used.size(); ++j) {
+            if (used[j]) {
+                size_t pos = lookup(Policy::key(slots[j]));
+                used_[pos] = 1;
+                slots_[pos] = std::move(slots[j]);
+            }
+        }
+    }
+
+    std::vector<char> used_;
+    std::vector<slot_type> slots_;
+    size_t size_{0};
+};
+
+}  // namespace detail
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Flat hash set for integral keys, e.g. unique identifiers (uid) of mesh entities,
+/// as a faster replacement of std::set or std::unordered_set for membership tests and deduplication.
+/// Iteration order is unspecified.
+template <typename Key>
+class FlatHashSet : public detail::FlatHashTable<Key, detail::FlatHashSetPolicy<Key>> {
+    using Base = detail::FlatHashTable<Key, detail::FlatHashSetPolicy<Key>>;
+
+public:
+    using value_type = Key;
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    using Base::Base;
+
+    std::pair<iterator, bool> insert(const Key& key) {
+        auto inserted = this->insert_key(key);
+        return {iterator(this, inserted.first), inserted.second};
+    }
+};
+
+/// Flat hash map for integral keys, e.g. unique identifiers (uid) of mesh entities,
+/// as a faster replacement of std::map or std::unordered_map for lookups.
+/// Iteration order is unspecified.
+template <typename Key, typename Value>
+class FlatHashMap : public detail::FlatHashTable<Key, detail::FlatHashMapPolicy<Key, Value>> {
+    using Base = detail::FlatHashTable<Key, detail::FlatHashMapPolicy<Key, Value>>;
+
+public:
+    using mapped_type = Value;
+    using value_type  = std::pair<Key, Value>;
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    using Base::Base;
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        auto inserted = this->insert_key(value.first);
+        if (inserted.second) {
+            this->slots_[inserted.first].second = value.second;
+        }
+        return {iterator(this, inserted.first), inserted.second};
+    }
+
+    Value& operator[](const Key& key) { return this->slots_[this->insert_key(key).first].second; }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
@@ -0,0 +1,58 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace atlas {
+namespace util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Index of cell (x,y) along the Hilbert curve filling a square of 2^order x 2^order cells, with order <= 32.
+/// The curve starts in cell (0,0) and ends in cell (2^order-1,0), so that squares placed side by side in
+/// the x-direction are traversed continuously by offsetting their indices with 4^order.
+inline uint64_t hilbert_index(uint32_t x, uint32_t y, int order) {
+    uint64_t d = 0;
+    for (uint64_t s = uint64_t(1) << (order - 1); s > 0; s >>= 1) {
+        const uint32_t rx = (x & s) ? 1 : 0;
+        const uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Rotate quadrant
+        if (ry == 0) {
+            if (rx == 1) {
+                x = static_cast<uint32_t>(s - 1) - (x & static_cast<uint32_t>(s - 1));
+                y = static_cast<uint32_t>(s - 1) - (y & static_cast<uint32_t>(s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Index of cell (x,y) along the Morton (Z-order) curve, obtained by interleaving the bits of x and y.
+inline uint64_t morton_index(uint32_t x, uint32_t y) {
+    auto spread = [](uint64_t v) {
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        v = (v | (v << 2)) & 0x3333333333333333ULL;
+        v = (v | (v << 1)) & 0x5555555555555555ULL;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
@@ -0,0 +1,167 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+/// Benchmark the effect of NUMA first-touch placement on memory bandwidth.
+///
+/// A triad kernel a(jnode,jlev) = b(jnode,jlev) + s * c(jnode,jlev) loops with a static OpenMP schedule over
+/// the first dimension, on arrays whose pages were first touched
+///   - serially by the master thread, as without ATLAS_INIT_FIRST_TOUCH
+///   - in parallel with the same static schedule as the kernel
+///   - by atlas itself in Array::create, following the ATLAS_INIT_FIRST_TOUCH setting
+/// On multi-socket nodes the serially touched arrays live on a single NUMA node, and the kernel is limited by
+/// the bandwidth of that one socket. Run with e.g. OMP_NUM_THREADS=<cores> OMP_PROC_BIND=close OMP_PLACES=cores.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+#include "atlas/array.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/library/Library.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+
+using namespace atlas;
+using atlas::util::Config;
+
+namespace {
+
+//------------------------------------------------------------------------------
+
+struct Buffer {
+    Buffer(size_t size) {
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, 4096, size * sizeof(double)) != 0) {
+            throw_Exception("Could not allocate buffer", Here());
+        }
+        data = static_cast<double*>(ptr);
+    }
+    ~Buffer() { free(data); }
+    double* data;
+};
+
+void touch_serial(double* data, idx_t nb_nodes, idx_t nb_levels, double value) {
+    for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        for (idx_t jlev = 0; jlev < nb_levels; ++jlev) {
+            data[jnode * nb_levels + jlev] = value;
+        }
+    }
+}
+
+void touch_parallel(double* data, idx_t nb_nodes, idx_t nb_levels, double value) {
+    atlas_omp_parallel_for_static(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        for (idx_t jlev = 0; jlev < nb_levels; ++jlev) {
+            data[jnode * nb_levels + jlev] = value;
+        }
+    }
+}
+
+/// Returns the best bandwidth in GB/s over given iterations
+double triad(array::Array& a, const array::Array& b, const array::Array& c, size_t iterations) {
+    auto va               = array::make_view<double, 2>(a);
+    const auto vb         = array::make_view<const double, 2>(b);
+    const auto vc         = array::make_view<const double, 2>(c);
+    const idx_t nb_nodes  = va.shape(0);
+    const idx_t nb_levels = va.shape(1);
+    const double scalar   = 3.;
+    const double bytes    = 3. * sizeof(double) * nb_nodes * nb_levels;
+
+    double best = 0.;
+    for (size_t i = 0; i < iterations; ++i) {
+        Trace trace(Here(), "triad");
+        atlas_omp_parallel_for_static(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+            for (idx_t jlev = 0; jlev < nb_levels; ++jlev) {
+                va(jnode, jlev) = vb(jnode, jlev) + scalar * vc(jnode, jlev);
+            }
+        }
+        trace.stop();
+        best = std::max(best, bytes / trace.elapsed() * 1.e-9);
+    }
+    return best;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute(const Args& args) override;
+    std::string briefDescription() override {
+        return "Benchmark memory bandwidth of OpenMP kernels depending on NUMA first-touch placement";
+    }
+    std::string usage() override { return name() + " [--nodes=N] [--levels=N] [--iterations=N] [--help]"; }
+
+public:
+    Tool(int argc, char** argv);
+};
+
+Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
+    add_option(new SimpleOption<long>("nodes", "Size of first dimension, default 4000000"));
+    add_option(new SimpleOption<long>("levels", "Size of second dimension, default 40"));
+    add_option(new SimpleOption<long>("iterations", "Number of iterations of the kernel, default 10"));
+}
+
+int Tool::execute(const Args& args) {
+    const idx_t nb_nodes    = args.getLong("nodes", 4000000);
+    const idx_t nb_levels   = args.getLong("levels", 40);
+    const size_t iterations = args.getLong("iterations", 10);
+    const size_t size       = size_t(nb_nodes) * size_t(nb_levels);
+
+    Log::info() << "Triad on 3 arrays of shape (" << nb_nodes << "," << nb_levels << ") with "
+                << atlas_omp_get_max_threads() << " threads" << std::endl;
+
+    auto run = [&](const std::string& title, void (*touch)(double*, idx_t, idx_t, double)) {
+        ATLAS_TRACE(title);
+        Buffer a(size), b(size), c(size);
+        touch(a.data, nb_nodes, nb_levels, 0.);
+        touch(b.data, nb_nodes, nb_levels, 1.);
+        touch(c.data, nb_nodes, nb_levels, 2.);
+        auto shape = array::make_shape(nb_nodes, nb_levels);
+        std::unique_ptr<array::Array> va{array::Array::wrap<double>(a.data, shape)};
+        std::unique_ptr<array::Array> vb{array::Array::wrap<double>(b.data, shape)};
+        std::unique_ptr<array::Array> vc{array::Array::wrap<double>(c.data, shape)};
+        return triad(*va, *vb, *vc, iterations);
+    };
+
+    const double serial   = run("serial first touch", touch_serial);
+    const double parallel = run("parallel first touch", touch_parallel);
+
+    double created = 0.;
+    ATLAS_TRACE_SCOPE("Array::create") {
+        std::unique_ptr<array::Array> a{array::Array::create<double>(nb_nodes, nb_levels)};
+        std::unique_ptr<array::Array> b{array::Array::create<double>(nb_nodes, nb_levels)};
+        std::unique_ptr<array::Array> c{array::Array::create<double>(nb_nodes, nb_levels)};
+        array::make_view<double, 2>(*b).assign(1.);
+        array::make_view<double, 2>(*c).assign(2.);
+        created = triad(*a, *b, *c, iterations);
+    }
+
+    Log::info() << std::fixed << std::setprecision(1);
+    Log::info() << "  serial first touch    " << std::setw(8) << serial << " GB/s" << std::endl;
+    Log::info() << "  parallel first touch  " << std::setw(8) << parallel << " GB/s" << std::endl;
+    Log::info() << "  Array::create         " << std::setw(8) << created << " GB/s    (ATLAS_INIT_FIRST_TOUCH="
+                << Library::instance().initFirstTouch() << ")" << std::endl;
+
+    Log::info() << Trace::report(Config("indent", 2)("decimals", 3));
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    Tool tool(argc, argv);
+    return tool.start();
+}
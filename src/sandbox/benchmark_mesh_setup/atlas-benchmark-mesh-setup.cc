@@ -0,0 +1,220 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Benchmark of the mesh setup actions which rely on lookups of unique identifiers (uid):
+//   build_parallel_fields, build_periodic_boundaries, build_halo, build_edges, build_edges_parallel_fields
+//
+// With --baseline, the uid containers used by these actions (util::FlatHashMap, util::FlatHashSet) are also timed
+// against the standard containers they replaced, on the node uids of the generated mesh.
+//
+// Example:
+//   mpirun -np 16 atlas-benchmark-mesh-setup --grid=O1280 --halo=3 --iterations=3 --baseline
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "atlas/grid.h"
+#include "atlas/mesh.h"
+#include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
+#include "atlas/meshgenerator.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/FlatHashMap.h"
+#include "atlas/util/Unique.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute(const Args& args) override;
+    std::string briefDescription() override { return "Benchmark of mesh setup actions: halo, parallel fields, edges"; }
+    std::string usage() override {
+        return name() + " [--grid=name] [--halo=N] [--iterations=N] [--baseline] [--help]";
+    }
+
+public:
+    Tool(int argc, char** argv);
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
+    add_option(new SimpleOption<std::string>(
+        "grid", "Grid unique identifier (default=O1280)\n" + indent() + "     Example values: N80, F40, O24, L32"));
+    add_option(new SimpleOption<long>("halo", "Number of halos (default=2)"));
+    add_option(new SimpleOption<long>("iterations", "Number of iterations (default=1)"));
+    add_option(new SimpleOption<std::string>("partitioner", "Partitioner (default=equal_regions)"));
+    add_option(new SimpleOption<bool>("baseline", "Time uid containers against std containers (default=false)"));
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute(const Args& args) {
+    std::string gridname    = args.getString("grid", "O1280");
+    std::string partitioner = args.getString("partitioner", "equal_regions");
+    int halo                = static_cast<int>(args.getLong("halo", 2));
+    long iterations         = args.getLong("iterations", 1);
+    bool baseline           = args.getBool("baseline", false);
+
+    StructuredGrid grid(gridname);
+    if (!grid) {
+        Log::error() << "Grid " << gridname << " is not a structured grid" << std::endl;
+        return failed();
+    }
+
+    Log::info() << "Configuration" << std::endl;
+    Log::info() << "~~~~~~~~~~~~~" << std::endl;
+    Log::info() << "  Grid        : " << grid.name() << std::endl;
+    Log::info() << "  Halo        : " << halo << std::endl;
+    Log::info() << "  Partitioner : " << partitioner << std::endl;
+    Log::info() << "  Iterations  : " << iterations << std::endl;
+    Log::info() << "  MPI         : " << mpi::comm().size() << std::endl;
+    Log::info() << "  OpenMP      : " << atlas_omp_get_max_threads() << std::endl;
+
+    MeshGenerator meshgenerator("structured", util::Config("partitioner", partitioner));
+
+    struct Timings {
+        double parallel_fields{0};
+        double periodic_boundaries{0};
+        double halo{0};
+        double edges{0};
+    } timings;
+
+    auto timed = [](double& accumulated, const std::function<void()>& f) {
+        mpi::comm().barrier();
+        Trace t(Here());
+        f();
+        mpi::comm().barrier();
+        accumulated += t.elapsed();
+    };
+
+    Mesh mesh;
+    Trace timer(Here(), displayName());
+    for (long i = 0; i < iterations; ++i) {
+        ATLAS_TRACE("iteration");
+        mesh = meshgenerator.generate(grid);
+        timed(timings.parallel_fields, [&] { mesh::actions::build_parallel_fields(mesh); });
+        timed(timings.periodic_boundaries, [&] { mesh::actions::build_periodic_boundaries(mesh); });
+        timed(timings.halo, [&] { mesh::actions::build_halo(mesh, halo); });
+        timed(timings.edges, [&] {
+            mesh::actions::build_edges(mesh);
+            mesh::actions::build_edges_parallel_fields(mesh);
+        });
+    }
+    timer.stop();
+    const idx_t nb_nodes = mesh.nodes().size();
+    const idx_t nb_edges = mesh.edges().size();
+
+    auto report = [&](const std::string& action, double accumulated) {
+        Log::info() << "  " << std::setw(20) << std::left << action << " : " << std::fixed << std::setprecision(3)
+                    << accumulated / double(iterations) << " s" << std::endl;
+    };
+    Log::info() << "Average timings on task 0 (" << nb_nodes << " nodes, " << nb_edges << " edges)" << std::endl;
+    Log::info() << "~~~~~~~~~~~~~~~~~~~~~~~~" << std::endl;
+    report("parallel_fields", timings.parallel_fields);
+    report("periodic_boundaries", timings.periodic_boundaries);
+    report("halo", timings.halo);
+    report("edges", timings.edges);
+
+    if (baseline) {
+        // Same access pattern as BuildHalo: build a uid-to-node lookup, look up every uid, and deduplicate uids.
+        std::vector<uidx_t> uids(nb_nodes);
+        util::UniqueLonLat compute_uid(mesh);
+        for (idx_t n = 0; n < nb_nodes; ++n) {
+            uids[n] = compute_uid(n);
+        }
+        auto measure = [&](const std::function<size_t()>& f) {
+            double accumulated = 0;
+            size_t checksum    = 0;
+            for (long i = 0; i < iterations; ++i) {
+                Trace t(Here());
+                checksum += f();
+                accumulated += t.elapsed();
+            }
+            return std::make_pair(accumulated, checksum);
+        };
+        auto lookup = [&](auto& map) {
+            for (idx_t n = 0; n < nb_nodes; ++n) {
+                map[uids[n]] = n;
+            }
+            size_t found = 0;
+            for (idx_t n = 0; n < nb_nodes; ++n) {
+                found += (map.find(uids[n]) != map.end());
+            }
+            return found;
+        };
+        auto deduplicate = [&](auto& set) {
+            size_t inserted = 0;
+            for (int repeat = 0; repeat < 2; ++repeat) {
+                for (idx_t n = 0; n < nb_nodes; ++n) {
+                    inserted += set.insert(uids[n]).second;
+                }
+            }
+            return inserted;
+        };
+        std::vector<std::pair<std::string, std::pair<double, size_t>>> results;
+        results.emplace_back("std::map", measure([&] {
+                                 std::map<uidx_t, idx_t> map;
+                                 return lookup(map);
+                             }));
+        results.emplace_back("std::unordered_map", measure([&] {
+                                 std::unordered_map<uidx_t, idx_t> map(nb_nodes);
+                                 return lookup(map);
+                             }));
+        results.emplace_back("util::FlatHashMap", measure([&] {
+                                 util::FlatHashMap<uidx_t, idx_t> map(nb_nodes);
+                                 return lookup(map);
+                             }));
+        results.emplace_back("std::set", measure([&] {
+                                 std::set<uidx_t> set;
+                                 return deduplicate(set);
+                             }));
+        results.emplace_back("util::FlatHashSet", measure([&] {
+                                 util::FlatHashSet<uidx_t> set(nb_nodes);
+                                 return deduplicate(set);
+                             }));
+        Log::info() << "Average timings of uid containers on task 0 (" << nb_nodes << " uids)" << std::endl;
+        Log::info() << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~" << std::endl;
+        // Maps and sets must agree among themselves on what was found and inserted
+        ATLAS_ASSERT(results[0].second.second == results[1].second.second);
+        ATLAS_ASSERT(results[0].second.second == results[2].second.second);
+        ATLAS_ASSERT(results[3].second.second == results[4].second.second);
+        for (auto& result : results) {
+            report(result.first, result.second.first);
+        }
+    }
+
+    Log::info() << Trace::report() << std::endl;
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    Tool tool(argc, argv);
+    return tool.start();
+}
@@ -16,6 +16,7 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <sstream>
 #include <vector>
 
@@ -29,7 +30,12 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/output/detail/GmshIO.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/radix_sort.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/parallel/omp/unique.h"
 #include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/Config.h"
@@ -175,6 +181,73 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
     // Log::info() << std::endl;
 }
 
+//------------------------------------------------------------------------------
+
+/// Compare the parallel sorting primitives against their std counterparts, on random (uid,index) pairs
+/// with many duplicate uids as found in the mesh actions
+void benchmark_sorting_primitives(size_t size, size_t iterations) {
+    ATLAS_TRACE("sorting primitives");
+    Log::info() << "Sorting " << size << " random (uid,index) pairs with " << atlas_omp_get_max_threads()
+                << " threads" << std::endl;
+
+    std::mt19937_64 engine(size);
+    std::uniform_int_distribution<gidx_t> distribution(-gidx_t(size) / 4, gidx_t(size) / 4);
+    std::vector<Node> input;
+    input.reserve(size);
+    for (size_t j = 0; j < size; ++j) {
+        input.emplace_back(distribution(engine), j);
+    }
+    auto compare = [](const Node& a, const Node& b) { return a.g < b.g; };
+    auto key     = [](const Node& n) { return n.g; };
+
+    std::vector<Node> expected(input);
+    std::stable_sort(expected.begin(), expected.end(), compare);
+    auto check_stable = [&](const std::vector<Node>& sorted, const std::string& name) {
+        for (size_t j = 0; j < size; ++j) {
+            if (sorted[j].g != expected[j].g || sorted[j].i != expected[j].i) {
+                throw_Exception(name + " gives wrong result", Here());
+            }
+        }
+    };
+
+    for (size_t i = 0; i < iterations; ++i) {
+        std::vector<Node> nodes(input);
+        ATLAS_TRACE_SCOPE("std::sort") { std::sort(nodes.begin(), nodes.end(), compare); }
+        nodes = input;
+        ATLAS_TRACE_SCOPE("omp::sort") { omp::sort(nodes.begin(), nodes.end(), compare); }
+        nodes = input;
+        ATLAS_TRACE_SCOPE("std::stable_sort") { std::stable_sort(nodes.begin(), nodes.end(), compare); }
+        nodes = input;
+        ATLAS_TRACE_SCOPE("omp::stable_sort") { omp::stable_sort(nodes.begin(), nodes.end(), compare); }
+        check_stable(nodes, "omp::stable_sort");
+        nodes = input;
+        ATLAS_TRACE_SCOPE("omp::radix_sort") { omp::radix_sort(nodes.begin(), nodes.end(), key); }
+        check_stable(nodes, "omp::radix_sort");
+
+        std::vector<gidx_t> keys(size);
+        std::vector<gidx_t> values(size);
+        for (size_t j = 0; j < size; ++j) {
+            keys[j]   = input[j].g;
+            values[j] = input[j].i;
+        }
+        ATLAS_TRACE_SCOPE("omp::sort_by_key") { omp::sort_by_key(keys.begin(), keys.end(), values.begin()); }
+        for (size_t j = 0; j < size; ++j) {
+            if (values[j] != expected[j].i) {
+                throw_Exception("omp::sort_by_key gives wrong result", Here());
+            }
+        }
+
+        std::vector<gidx_t> uids(keys);
+        size_t nb_unique = 0;
+        ATLAS_TRACE_SCOPE("std::unique") { nb_unique = std::unique(uids.begin(), uids.end()) - uids.begin(); }
+        ATLAS_TRACE_SCOPE("omp::unique") {
+            if (size_t(omp::unique(keys.begin(), keys.end()) - keys.begin()) != nb_unique) {
+                throw_Exception("omp::unique gives wrong result", Here());
+            }
+        }
+    }
+}
+
 }  // namespace atlas
 //-----------------------------------------------------------------------------
 
@@ -184,7 +257,7 @@ class Tool : public AtlasTool {
         return "Tool to generate a python script that plots the grid-distribution "
                "of a given grid";
     }
-    std::string usage() override { return name() + " (--grid=name) [--help]"; }
+    std::string usage() override { return name() + " (--grid=name | --primitives) [--help]"; }
 
 public:
     Tool(int argc, char** argv);
@@ -202,6 +275,9 @@ Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
         "grid", "Grid unique identifier\n" + indent() + "     Example values: N80, F40, O24, L32"));
     add_option(new SimpleOption<long>("halo", "size of halo"));
     add_option(new SimpleOption<bool>("do-all", "Renumber all points"));
+    add_option(new SimpleOption<bool>("primitives", "Compare parallel sorting primitives to std algorithms"));
+    add_option(new SimpleOption<long>("size", "Number of elements sorted with --primitives, default 10000000"));
+    add_option(new SimpleOption<long>("iterations", "Number of iterations with --primitives, default 3"));
 }
 
 //-----------------------------------------------------------------------------
@@ -209,6 +285,13 @@ Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
 int Tool::execute(const Args& args) {
     Trace t(Here(), "main");
 
+    if (args.getBool("primitives", false)) {
+        benchmark_sorting_primitives(args.getLong("size", 10000000), args.getLong("iterations", 3));
+        t.stop();
+        Log::info() << Trace::report(Config("indent", 2)("decimals", 3));
+        return success();
+    }
+
     key = "";
     args.get("grid", key);
 
@@ -73,6 +73,8 @@ Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
     add_option(new SimpleOption<std::string>("matrix_multiply", "backend to use in local trans type"));
     add_option(new SimpleOption<bool>("caching", "caching"));
     add_option(new SimpleOption<long>("niter", "number of iterations"));
+    add_option(new SimpleOption<bool>(
+        "flt", "also run local trans type with fast Legendre transform, and compare with matrix_multiply result"));
 }
 
 //-----------------------------------------------------------------------------
@@ -141,6 +143,7 @@ int Tool::execute(const Args& args) {
     }
 
     bool caching  = false;
+    bool flt      = false;
     int nb_scalar = 1;
     int nb_vordiv = 0;
     int niter     = 1;
@@ -148,6 +151,7 @@ int Tool::execute(const Args& args) {
     args.get("nvordiv", nb_vordiv);
     args.get("niter", niter);
     args.get("caching", caching);
+    args.get("flt", flt);
     int nb_all = nb_scalar + 2 * nb_vordiv;
 
 
@@ -161,6 +165,7 @@ int Tool::execute(const Args& args) {
     Log::info() << "  vor/div fields : " << nb_vordiv << std::endl;
     Log::info() << "  niter          : " << niter << std::endl;
     Log::info() << "  caching        : " << std::boolalpha << caching << std::endl;
+    Log::info() << "  flt            : " << std::boolalpha << flt << std::endl;
     if (caching) {
         Log::info() << "  cache path     : " << atlas::Library::instance().cachePath() << std::endl;
     }
@@ -204,25 +209,27 @@ int Tool::execute(const Args& args) {
     for (auto& type : types) {
         ATLAS_TRACE(type);
 
-        trans::Cache cache;
-
-        if (args.getBool("caching", false)) {
-            trans::LegendreCacheCreator cache_creator(grid, truncation, option::type(type));
-            if (cache_creator.supported()) {
-                auto cachefile =
-                    eckit::PathName(atlas::Library::instance().cachePath() + "/leg_" + cache_creator.uid() + ".bin");
-                if (not cachefile.exists()) {
-                    Log::debug() << "Creating cache: " << cachefile
-                                 << " estimated size: " << eckit::Bytes(cache_creator.estimate()) << std::endl;
-                    cache_creator.create(cachefile);
+        auto create_cache = [&](const Config& config) {
+            trans::Cache cache;
+            if (caching) {
+                trans::LegendreCacheCreator cache_creator(grid, truncation, config);
+                if (cache_creator.supported()) {
+                    auto cachefile = eckit::PathName(atlas::Library::instance().cachePath() + "/leg_" +
+                                                     cache_creator.uid() + ".bin");
+                    if (not cachefile.exists()) {
+                        Log::debug() << "Creating cache: " << cachefile
+                                     << " estimated size: " << eckit::Bytes(cache_creator.estimate()) << std::endl;
+                        cache_creator.create(cachefile);
+                    }
+                    Log::debug() << "Reading cache " << cachefile << " size: " << eckit::Bytes(cachefile.size())
+                                 << std::endl;
+                    cache = trans::LegendreCache(cachefile);
                 }
-                Log::debug() << "Reading cache " << cachefile << " size: " << eckit::Bytes(cachefile.size())
-                             << std::endl;
-                cache = trans::LegendreCache(cachefile);
             }
-        }
+            return cache;
+        };
 
-        trans::Trans trans(cache, grid, domain, truncation, option::type(type));
+        trans::Trans trans(create_cache(option::type(type)), grid, domain, truncation, option::type(type));
 
         for (auto backend : linalg_backends.at(type)) {
             linalg::dense::current_backend(backend);
@@ -255,6 +262,49 @@ int Tool::execute(const Args& args) {
                 print("max", max);
             }
         }
+
+        if (flt && type == "local") {
+            ATLAS_TRACE("flt");
+            auto config = option::type(type) | option::flt(true);
+            trans::Trans trans_flt(create_cache(config), grid, domain, truncation, config);
+
+            std::vector<double> gp_flt(gp.size());
+            auto min     = std::numeric_limits<double>::max();
+            auto max     = 0.;
+            auto zeropad = [](int n) {
+                std::stringstream s;
+                s << std::setw(3) << std::setfill('0') << n;
+                return s.str();
+            };
+            auto print = [&](const std::string& idx, double seconds) {
+                Log::info() << "type=" << std::setw(6) << std::left << type;
+                Log::info() << "      backend=" << std::setw(24) << std::left << "flt";
+                Log::info() << "      invtrans[" << idx << "]: " << seconds << " s" << std::endl;
+            };
+            for (size_t n = 0; n < niter; ++n) {
+                ATLAS_TRACE("invtrans [flt]");
+                auto start = std::chrono::system_clock::now();
+                trans_flt.invtrans(nb_scalar, sp_scalar.data(), nb_vordiv, sp_vorticity.data(), sp_divergence.data(),
+                                   gp_flt.data());
+                auto end                                      = std::chrono::system_clock::now();  //
+                std::chrono::duration<double> elapsed_seconds = end - start;
+                print(zeropad(n), elapsed_seconds.count());
+                min = std::min(min, elapsed_seconds.count());
+                max = std::max(max, elapsed_seconds.count());
+            }
+            print("min", min);
+            print("max", max);
+
+            // gp contains the result of the last matrix_multiply backend
+            double max_value = 0.;
+            double max_error = 0.;
+            for (size_t j = 0; j < gp.size(); ++j) {
+                max_value = std::max(max_value, std::abs(gp[j]));
+                max_error = std::max(max_error, std::abs(gp[j] - gp_flt[j]));
+            }
+            Log::info() << "type=" << std::setw(6) << std::left << type << "      flt max error: " << max_error
+                        << " (relative: " << (max_value > 0. ? max_error / max_value : 0.) << ")" << std::endl;
+        }
     }
 
     timer.stop();
@@ -12,6 +12,7 @@
 
 #include "atlas/array.h"
 #include "atlas/array/MakeView.h"
+#include "atlas/array/MemoryResource.h"
 #include "atlas/library/config.h"
 #include "tests/AtlasTestEnvironment.h"
 
@@ -406,6 +407,89 @@ CASE("test_insert") {
     delete ds;
 }
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+CASE("test_capacity") {
+    SECTION("reserve") {
+        std::unique_ptr<Array> ds{Array::create<int>(3, 2)};
+        EXPECT_EQ(ds->capacity(), 3);
+        ds->reserve(100);
+        EXPECT_EQ(ds->capacity(), 100);
+        make_host_view<int, 2>(*ds).assign(7);
+        const void* data = ds->storage();
+        for (idx_t size0 = 4; size0 <= 100; ++size0) {
+            ds->resize(size0, 2);
+            auto hv = make_host_view<int, 2>(*ds);
+            hv(size0 - 1, 1) = size0;
+        }
+        EXPECT_EQ(ds->storage(), data);
+        EXPECT_EQ(ds->shape(0), 100);
+        EXPECT_EQ(ds->spec().datatype().kind(), ds->datatype().kind());
+        auto hv = make_host_view<int, 2>(*ds);
+        EXPECT_EQ(hv(2, 1), 7);
+        EXPECT_EQ(hv(50, 1), 51);
+        ds->resize(10, 2);
+        EXPECT_EQ(ds->capacity(), 100);
+        EXPECT_EQ(ds->storage(), data);
+    }
+    SECTION("geometric growth") {
+        std::unique_ptr<Array> ds{Array::create<double>(1, 3)};
+        int reallocations = 0;
+        const void* data  = ds->storage();
+        for (idx_t size0 = 2; size0 <= 10000; ++size0) {
+            ds->resize(size0, 3);
+            make_host_view<double, 2>(*ds)(size0 - 1, 2) = size0;
+            if (ds->storage() != data) {
+                data = ds->storage();
+                ++reallocations;
+            }
+        }
+        EXPECT(reallocations < 30);
+        EXPECT(ds->capacity() >= 10000);
+        auto hv = make_host_view<double, 2>(*ds);
+        for (idx_t j = 1; j < 10000; ++j) {
+            EXPECT_EQ(hv(j, 2), double(j + 1));
+        }
+    }
+    SECTION("insert within capacity") {
+        std::unique_ptr<Array> ds{Array::create<double>(7, 5, 8)};
+        ds->reserve(20);
+        const void* data = ds->storage();
+        auto hv          = make_host_view<double, 3>(*ds);
+        hv.assign(-1.);
+        hv(1, 3, 3) = 1.5;
+        hv(3, 3, 3) = 3.5;
+        hv(6, 4, 7) = 6.5;
+        ds->insert(3, 2);
+        EXPECT_EQ(ds->storage(), data);
+        EXPECT_EQ(ds->shape(0), 9);
+        auto hv2 = make_host_view<double, 3>(*ds);
+        EXPECT_EQ(hv2(1, 3, 3), 1.5);
+        EXPECT_EQ(hv2(5, 3, 3), 3.5);
+        EXPECT_EQ(hv2(8, 4, 7), 6.5);
+        EXPECT_EQ(hv2(2, 0, 0), -1.);
+        EXPECT_EQ(hv2(5, 0, 0), -1.);
+    }
+    SECTION("insert beyond capacity") {
+        std::unique_ptr<Array> ds{Array::create<int>(4)};
+        auto hv = make_host_view<int, 1>(*ds);
+        for (idx_t j = 0; j < 4; ++j) {
+            hv(j) = j;
+        }
+        ds->insert(1, 10);
+        EXPECT_EQ(ds->shape(0), 14);
+        auto hv2 = make_host_view<int, 1>(*ds);
+        EXPECT_EQ(hv2(0), 0);
+        EXPECT_EQ(hv2(11), 1);
+        EXPECT_EQ(hv2(13), 3);
+    }
+    SECTION("reserve is ignored for aligned arrays") {
+        ArrayT<double> array{make_shape(10, 5), ArrayAlignment(4)};
+        array.reserve(100);
+        EXPECT_EQ(array.capacity(), 10);
+    }
+}
+#endif
+
 CASE("test_insert_throw") {
     Array* ds = Array::create<double>(7, 5, 8);
 
@@ -599,6 +683,83 @@ CASE("test_aligned_Array") {
 
 //-----------------------------------------------------------------------------
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+CASE("test_memory_resource") {
+    SECTION("pool reuses freed blocks") {
+        ScopedMemoryResource scope("pool");
+        EXPECT_EQ(scope.resource().type(), std::string("pool"));
+        void* data;
+        {
+            std::unique_ptr<Array> array{Array::create<double>(1000, 4)};
+            data = array->storage();
+            EXPECT_EQ(scope.resource().memory().bytes(), 1000 * 4 * sizeof(double));
+        }
+        EXPECT_EQ(scope.resource().memory().bytes(), 0);
+        EXPECT(scope.resource().reserved() >= 1000 * 4 * sizeof(double));
+        std::unique_ptr<Array> array{Array::create<double>(1000, 4)};
+        EXPECT_EQ(array->storage(), data);
+        EXPECT_EQ(scope.resource().memory().high(), 1000 * 4 * sizeof(double));
+    }
+    SECTION("arena scope") {
+        ScopedMemoryResource scope("arena");
+        EXPECT_EQ(scope.resource().type(), std::string("arena"));
+        {
+            std::unique_ptr<Array> a{Array::create<double>(100)};
+            std::unique_ptr<Array> b{Array::create<int>(30, 3)};
+            EXPECT_EQ(reinterpret_cast<size_t>(a->storage()) % 64, 0);
+            EXPECT_EQ(reinterpret_cast<size_t>(b->storage()) % 64, 0);
+            auto va = make_view<double, 1>(*a);
+            auto vb = make_view<int, 2>(*b);
+            va.assign(1.);
+            vb.assign(2);
+            EXPECT_EQ(va(99), 1.);
+            EXPECT_EQ(vb(29, 2), 2);
+            EXPECT_EQ(scope.resource().memory().bytes(), 100 * sizeof(double) + 90 * sizeof(int));
+        }
+        EXPECT_EQ(scope.resource().memory().bytes(), 0);
+        scope.resource().release();
+        EXPECT_EQ(scope.resource().reserved(), 0);
+
+        // Selecting "arena" by name uses the arena of the enclosing scope
+        {
+            ScopedMemoryResource pool("pool");
+            EXPECT_EQ(memory_resource("arena").get(), &scope.resource());
+            ScopedMemoryResource nested(memory_resource("arena"));
+            EXPECT_EQ(current_memory_resource().get(), &scope.resource());
+        }
+        EXPECT_THROWS(current_memory_resource("arena"));
+    }
+    SECTION("arena requires scope") {
+        EXPECT_THROWS(memory_resource("arena"));
+        ScopedMemoryResource a("arena");
+        ScopedMemoryResource b("arena");
+        EXPECT(&a.resource() != &b.resource());
+    }
+    SECTION("scopes nest and restore") {
+        auto outer = current_memory_resource();
+        {
+            ScopedMemoryResource pool("pool");
+            {
+                ScopedMemoryResource huge_pages("huge_pages");
+                EXPECT_EQ(current_memory_resource()->type(), std::string("huge_pages"));
+                std::unique_ptr<Array> array{Array::create<double>(idx_t(HugePageMemoryResource::huge_page_size()))};
+                EXPECT_EQ(reinterpret_cast<size_t>(array->storage()) % HugePageMemoryResource::huge_page_size(), 0);
+            }
+            EXPECT_EQ(current_memory_resource()->type(), std::string("pool"));
+        }
+        EXPECT_EQ(current_memory_resource().get(), outer.get());
+    }
+    SECTION("unknown resource") {
+        EXPECT_THROWS(memory_resource("does-not-exist"));
+    }
+    std::stringstream report;
+    report_memory_resources(report);
+    Log::info() << report.str();
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
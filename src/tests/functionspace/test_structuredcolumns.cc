@@ -8,6 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
 #include "eckit/log/Bytes.h"
 #include "eckit/types/Types.h"
 
@@ -24,6 +28,7 @@
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/MicroDeg.h"
+#include "atlas/util/SpaceFillingCurve.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -318,6 +323,235 @@ CASE("test_functionspace_StructuredColumns_halo checks without output") {
 
 //-----------------------------------------------------------------------------
 
+CASE("test_functionspace_StructuredColumns ordering along space-filling curve") {
+    StructuredGrid grid("O16");
+
+    util::Config config;
+    config.set("halo", 2);
+    config.set("periodic_points", true);
+    functionspace::StructuredColumns fs_ij(grid, grid::Partitioner("equal_regions"), config);
+
+    for (std::string ordering : {"hilbert", "morton"}) {
+        SECTION(ordering) {
+            config.set("ordering", ordering);
+            functionspace::StructuredColumns fs(grid, grid::Partitioner("equal_regions"), config);
+
+            EXPECT_EQ(fs.size(), fs_ij.size());
+            EXPECT_EQ(fs.sizeOwned(), fs_ij.sizeOwned());
+            EXPECT_EQ(fs.ordering(), ordering);
+            EXPECT_EQ(fs_ij.ordering(), std::string("ij"));
+
+            auto glb_idx    = array::make_view<gidx_t, 1>(fs.global_index());
+            auto glb_idx_ij = array::make_view<gidx_t, 1>(fs_ij.global_index());
+            auto ghost      = array::make_view<int, 1>(fs.ghost());
+            auto index_i    = array::make_indexview<idx_t, 1>(fs.index_i());
+            auto index_j    = array::make_indexview<idx_t, 1>(fs.index_j());
+
+            // Same points, owned points first
+            for (idx_t n = 0; n < fs.size(); ++n) {
+                EXPECT_EQ(fs.index(index_i(n), index_j(n)), n);
+                EXPECT_EQ(ghost(n), n < fs.sizeOwned() ? 0 : 1);
+            }
+            for (idx_t j = fs.j_begin_halo(); j < fs.j_end_halo(); ++j) {
+                for (idx_t i = fs.i_begin_halo(j); i < fs.i_end_halo(j); ++i) {
+                    EXPECT_EQ(glb_idx(fs.index(i, j)), glb_idx_ij(fs_ij.index(i, j)));
+                }
+            }
+
+            // Owned points, and halo points, are ordered along the curve through the (i,j) indices
+            auto expect_along_curve = [&](idx_t begin, idx_t end) {
+                idx_t i0 = std::numeric_limits<idx_t>::max();
+                idx_t j0 = std::numeric_limits<idx_t>::max();
+                idx_t extent{1};
+                for (idx_t n = begin; n < end; ++n) {
+                    i0 = std::min(i0, index_i(n));
+                    j0 = std::min(j0, index_j(n));
+                }
+                for (idx_t n = begin; n < end; ++n) {
+                    extent = std::max(extent, std::max(index_i(n) - i0, index_j(n) - j0) + 1);
+                }
+                int order = 1;
+                while ((idx_t{1} << order) < extent) {
+                    ++order;
+                }
+                auto key = [&](idx_t n) {
+                    auto x = uint32_t(index_i(n) - i0);
+                    auto y = uint32_t(index_j(n) - j0);
+                    return ordering == "hilbert" ? util::hilbert_index(x, y, order) : util::morton_index(x, y);
+                };
+                idx_t unordered = 0;
+                for (idx_t n = begin + 1; n < end; ++n) {
+                    if (key(n) < key(n - 1)) {
+                        ++unordered;
+                    }
+                }
+                EXPECT_EQ(unordered, 0);
+            };
+            expect_along_curve(0, fs.sizeOwned());
+            expect_along_curve(fs.sizeOwned(), fs.size());
+
+            if (ordering == "hilbert") {
+                // Most consecutive owned points are neighbours
+                idx_t neighbours = 0;
+                for (idx_t n = 1; n < fs.sizeOwned(); ++n) {
+                    if (std::abs(index_i(n) - index_i(n - 1)) + std::abs(index_j(n) - index_j(n - 1)) == 1) {
+                        ++neighbours;
+                    }
+                }
+                EXPECT(neighbours > fs.sizeOwned() / 2);
+            }
+
+            // Halo exchange gives the same result as with row-major ordering
+            Field field    = fs.createField<double>(option::name("field"));
+            Field field_ij = fs_ij.createField<double>(option::name("field"));
+            auto value     = array::make_view<double, 1>(field);
+            auto value_ij  = array::make_view<double, 1>(field_ij);
+            for (idx_t n = 0; n < fs.sizeOwned(); ++n) {
+                value(n) = double(glb_idx(n));
+            }
+            for (idx_t n = 0; n < fs_ij.sizeOwned(); ++n) {
+                value_ij(n) = double(glb_idx_ij(n));
+            }
+            fs.haloExchange(field);
+            fs_ij.haloExchange(field_ij);
+            for (idx_t j = fs.j_begin_halo(); j < fs.j_end_halo(); ++j) {
+                for (idx_t i = fs.i_begin_halo(j); i < fs.i_end_halo(j); ++i) {
+                    EXPECT_EQ(value(fs.index(i, j)), value_ij(fs_ij.index(i, j)));
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_functionspace_StructuredColumns extended to larger halo") {
+    StructuredGrid grid("O16");
+
+    util::Config config;
+    config.set("levels", 2);
+    config.set("periodic_points", true);
+
+    config.set("halo", 1);
+    functionspace::StructuredColumns fs1(grid, grid::Partitioner("equal_regions"), config);
+    config.set("halo", 3);
+    functionspace::StructuredColumns fs3(grid, grid::Partitioner("equal_regions"), config);
+
+    functionspace::StructuredColumns fs(fs1, util::Config("halo", 3));
+
+    EXPECT_EQ(fs.halo(), 3);
+    EXPECT_EQ(fs.levels(), fs1.levels());
+    EXPECT_EQ(fs.sizeOwned(), fs3.sizeOwned());
+    EXPECT_EQ(fs.size(), fs3.size());
+    EXPECT_EQ(fs.j_begin_halo(), fs3.j_begin_halo());
+    EXPECT_EQ(fs.j_end_halo(), fs3.j_end_halo());
+
+    auto glb_idx  = array::make_view<gidx_t, 1>(fs.global_index());
+    auto glb_idx1 = array::make_view<gidx_t, 1>(fs1.global_index());
+    auto glb_idx3 = array::make_view<gidx_t, 1>(fs3.global_index());
+    auto part     = array::make_view<int, 1>(fs.partition());
+    auto part3    = array::make_view<int, 1>(fs3.partition());
+    auto ghost    = array::make_view<int, 1>(fs.ghost());
+    auto ghost3   = array::make_view<int, 1>(fs3.ghost());
+    auto xy       = array::make_view<double, 2>(fs.xy());
+    auto xy3      = array::make_view<double, 2>(fs3.xy());
+
+    // Points of the existing function space keep their index
+    for (idx_t j = fs1.j_begin_halo(); j < fs1.j_end_halo(); ++j) {
+        for (idx_t i = fs1.i_begin_halo(j); i < fs1.i_end_halo(j); ++i) {
+            EXPECT_EQ(fs.index(i, j), fs1.index(i, j));
+        }
+    }
+    for (idx_t n = 0; n < fs1.size(); ++n) {
+        EXPECT_EQ(glb_idx(n), glb_idx1(n));
+    }
+
+    // Same points as a function space created with the larger halo
+    for (idx_t j = fs3.j_begin_halo(); j < fs3.j_end_halo(); ++j) {
+        EXPECT_EQ(fs.i_begin_halo(j), fs3.i_begin_halo(j));
+        EXPECT_EQ(fs.i_end_halo(j), fs3.i_end_halo(j));
+        for (idx_t i = fs3.i_begin_halo(j); i < fs3.i_end_halo(j); ++i) {
+            idx_t n  = fs.index(i, j);
+            idx_t n3 = fs3.index(i, j);
+            EXPECT_EQ(glb_idx(n), glb_idx3(n3));
+            EXPECT_EQ(part(n), part3(n3));
+            EXPECT_EQ(ghost(n), ghost3(n3));
+            EXPECT_EQ(xy(n, XX), xy3(n3, XX));
+            EXPECT_EQ(xy(n, YY), xy3(n3, YY));
+        }
+    }
+
+    // Halo exchange
+    Field field = fs.createField<double>(option::name("field"));
+    auto value  = array::make_view<double, 2>(field);
+    for (idx_t n = 0; n < fs.size(); ++n) {
+        for (idx_t k = 0; k < fs.levels(); ++k) {
+            value(n, k) = (n < fs.sizeOwned()) ? double(glb_idx(n)) : -1.;
+        }
+    }
+    fs.haloExchange(field);
+    for (idx_t n = 0; n < fs.size(); ++n) {
+        for (idx_t k = 0; k < fs.levels(); ++k) {
+            EXPECT_EQ(value(n, k), double(glb_idx(n)));
+        }
+    }
+
+    EXPECT_THROWS(functionspace::StructuredColumns(fs3, util::Config("halo", 1)));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_functionspace_StructuredColumns extend halo of non-compact distribution") {
+    // The "hilbert" partitioner gives a distribution with one entry per grid point, which is not kept by the
+    // function space and gathered again when extending the halo
+    StructuredGrid grid("O16");
+    grid::Distribution distribution(grid, grid::Partitioner("hilbert"));
+
+    functionspace::StructuredColumns fs1(grid, distribution, util::Config("halo", 1));
+    functionspace::StructuredColumns fs3(grid, distribution, util::Config("halo", 3));
+    functionspace::StructuredColumns fs(fs1, util::Config("halo", 3));
+
+    EXPECT_EQ(fs.size(), fs3.size());
+    EXPECT_EQ(fs.distribution(), fs3.distribution());
+
+    auto part  = array::make_view<int, 1>(fs.partition());
+    auto part3 = array::make_view<int, 1>(fs3.partition());
+    for (idx_t j = fs3.j_begin_halo(); j < fs3.j_end_halo(); ++j) {
+        for (idx_t i = fs3.i_begin_halo(j); i < fs3.i_end_halo(j); ++i) {
+            EXPECT_EQ(part(fs.index(i, j)), part3(fs3.index(i, j)));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_functionspace_StructuredColumns extend halo of space-filling curve ordering") {
+    StructuredGrid grid("O16");
+
+    util::Config config;
+    config.set("halo", 1);
+    config.set("periodic_points", true);
+    config.set("ordering", "hilbert");
+    functionspace::StructuredColumns fs1(grid, grid::Partitioner("equal_regions"), config);
+
+    // Ordering is inherited from the existing function space
+    functionspace::StructuredColumns fs(fs1, util::Config("halo", 3));
+    EXPECT_EQ(fs.ordering(), std::string("hilbert"));
+    for (idx_t j = fs1.j_begin_halo(); j < fs1.j_end_halo(); ++j) {
+        for (idx_t i = fs1.i_begin_halo(j); i < fs1.i_end_halo(j); ++i) {
+            EXPECT_EQ(fs.index(i, j), fs1.index(i, j));
+        }
+    }
+
+    util::Config extend("halo", 3);
+    extend.set("ordering", "hilbert");
+    EXPECT_EQ(functionspace::StructuredColumns(fs1, extend).ordering(), std::string("hilbert"));
+    extend.set("ordering", "ij");
+    EXPECT_THROWS(functionspace::StructuredColumns(fs1, extend));
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("test_functionspace_StructuredColumns halo exchange registration") {
     // Test by observing log with ATLAS_DEBUG=1
     // The HaloExchange Cache should be created twice, already found 4 times,
@@ -12,12 +12,16 @@
 #include <cstdint>
 #include <iomanip>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "atlas/array.h"
 #include "atlas/field.h"
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
 #include "atlas/grid/detail/distribution/BandsDistribution.h"
+#include "atlas/grid/detail/distribution/DistributionRanges.h"
 #include "atlas/grid/detail/distribution/SerialDistribution.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
@@ -139,6 +143,61 @@ CASE("test_regular_bands") {
     }
 }
 
+CASE("test compact distribution") {
+    int nproc = mpi::size();
+
+    std::vector<std::pair<std::string, Config>> partitioners{
+        {"equal_regions", Config()},
+        {"equal_regions", Config("coordinates", "lonlat")},
+        {"checkerboard", Config()},
+        {"checkerboard", Config("regular", true)},
+        {"checkerboard", Config("bands", 1)},
+    };
+    for (std::string gridname : {"O32", "L40x21"}) {
+        for (size_t c = 0; c < partitioners.size(); ++c) {
+            const std::string& type = partitioners[c].first;
+            if (type == "checkerboard" && not RegularGrid(Grid(gridname))) {
+                continue;
+            }
+            SECTION(gridname + " " + type + " " + std::to_string(c)) {
+                auto grid = Grid(gridname);
+                grid::Partitioner partitioner(type, partitioners[c].second);
+                grid::Distribution dist(grid, partitioner);
+
+                std::vector<int> part(grid.size());
+                partitioner.partition(grid, part.data());
+                grid::Distribution dist_array(nproc, grid.size(), part.data());
+
+                if (nproc > 1) {
+                    auto& ranges = dynamic_cast<const grid::detail::distribution::DistributionRanges&>(*dist.get());
+                    Log::info() << type << " : nb_ranges = " << ranges.nb_ranges()
+                                << ", footprint = " << dist.footprint() << " (array: " << dist_array.footprint()
+                                << ")" << std::endl;
+                    EXPECT(dist.footprint() < dist_array.footprint());
+                }
+                EXPECT_EQ(dist.type(), dist_array.type() == "custom" ? type : dist_array.type());
+                EXPECT_EQ(dist.size(), grid.size());
+                EXPECT_EQ(dist.nb_partitions(), nproc);
+                EXPECT(dist.nb_pts() == dist_array.nb_pts());
+                EXPECT_EQ(dist.hash(), dist_array.hash());
+
+                for (gidx_t n = 0; n < grid.size(); ++n) {
+                    EXPECT_EQ(dist.partition(n), part[n]);
+                }
+
+                grid::Distribution::partition_t range(grid.size());
+                for (gidx_t begin : {gidx_t{0}, gidx_t{7}, grid.size() / 3}) {
+                    gidx_t end = grid.size() - begin / 2;
+                    dist.partition(begin, end, range);
+                    for (gidx_t n = begin; n < end; ++n) {
+                        EXPECT_EQ(range[n - begin], part[n]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 CASE("test regular_bands performance test") {
     // auto grid = StructuredGrid( "L40000x20000" );  //-- > test takes too long( less than 15 seconds )
     // Example timings for L40000x20000:
@@ -197,6 +256,18 @@ CASE("test regular_bands with a very large grid") {
     auto dist = grid::Distribution(grid, grid::Partitioner("regular_bands"));
 }
 
+CASE("test equal_regions with a very large grid") {
+    // Computed per row, without a global array of nodes
+    auto grid = StructuredGrid("O8000");
+    auto dist = grid::Distribution(grid, grid::Partitioner("equal_regions"));
+    gidx_t nb_pts{0};
+    for (auto n : dist.nb_pts()) {
+        nb_pts += n;
+    }
+    EXPECT_EQ(nb_pts, grid.size());
+    EXPECT(dist.footprint() < size_t(grid.ny()) * size_t(dist.nb_partitions()) * 16);
+}
+
 
 //-----------------------------------------------------------------------------
 
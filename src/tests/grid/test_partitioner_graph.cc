@@ -0,0 +1,91 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "atlas/grid.h"
+#include "atlas/grid/detail/partitioner/GraphPartitioner.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/util/Config.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using Grid   = atlas::Grid;
+using Config = atlas::util::Config;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE("test graph partitioner") {
+    using detail::partitioner::GraphPartitioner;
+    const int nb_parts = 8;
+
+    for (std::string gridname : {"O32", "L64x33"}) {
+        SECTION(gridname) {
+            auto grid = Grid(gridname);
+
+            GraphPartitioner graph_partitioner(nb_parts);
+            auto graph = graph_partitioner.graph(grid);
+
+            auto edge_cut = [&](const std::vector<int>& part) {
+                size_t cut = 0;
+                for (idx_t u = 0; u < graph.size(); ++u) {
+                    for (size_t e = graph.xadj[u]; e < graph.xadj[u + 1]; ++e) {
+                        cut += (part[u] != part[graph.adjncy[e]]);
+                    }
+                }
+                return cut / 2;
+            };
+            auto imbalance = [&](const std::vector<int>& part, const std::vector<double>& weights) {
+                std::vector<double> w(nb_parts, 0.);
+                for (idx_t u = 0; u < graph.size(); ++u) {
+                    w[part[u]] += weights.empty() ? 1. : weights[u];
+                }
+                double avg = std::accumulate(w.begin(), w.end(), 0.) / nb_parts;
+                return *std::max_element(w.begin(), w.end()) / avg;
+            };
+
+            std::vector<int> part(grid.size());
+            grid::Partitioner("graph", nb_parts).partition(grid, part.data());
+            std::vector<int> part_eqreg(grid.size());
+            grid::Partitioner("equal_regions", nb_parts).partition(grid, part_eqreg.data());
+
+            Log::info() << gridname << " edge-cut graph: " << edge_cut(part)
+                        << ", equal_regions: " << edge_cut(part_eqreg) << std::endl;
+            EXPECT(edge_cut(part) <= edge_cut(part_eqreg));
+            EXPECT(imbalance(part, {}) <= 1.05);
+
+            // Non-uniform cost per point: twice as expensive in the tropics
+            std::vector<double> weights(grid.size());
+            idx_t n = 0;
+            for (const auto& p : grid.lonlat()) {
+                weights[n++] = std::abs(p.lat()) < 30. ? 2. : 1.;
+            }
+            grid::Partitioner("graph", Config("partitions", nb_parts) | Config("weights", weights))
+                .partition(grid, part.data());
+            EXPECT(imbalance(part, weights) <= 1.05);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
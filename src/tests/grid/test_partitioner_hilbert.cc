@@ -0,0 +1,66 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "atlas/domain.h"
+#include "atlas/grid.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using Grid = atlas::Grid;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE("test hilbert partitioner") {
+    const int nb_parts = 7;
+
+    auto check = [&](const Grid& grid) {
+        std::vector<int> part(grid.size(), -1);
+        grid::Partitioner("hilbert", nb_parts).partition(grid, part.data());
+        std::vector<idx_t> nb_pts(nb_parts, 0);
+        for (auto p : part) {
+            EXPECT(p >= 0 && p < nb_parts);
+            ++nb_pts[p];
+        }
+        auto minmax = std::minmax_element(nb_pts.begin(), nb_pts.end());
+        EXPECT(*minmax.second - *minmax.first <= 1);
+
+        grid::Distribution distribution(grid, grid::Partitioner("hilbert", nb_parts));
+        for (idx_t n = 0; n < grid.size(); ++n) {
+            EXPECT_EQ(distribution.partition(n), part[n]);
+        }
+    };
+
+    SECTION("O32") { check(Grid("O32")); }
+    SECTION("H8") { check(Grid("H8")); }
+    SECTION("unstructured") {
+        std::vector<PointXY> points;
+        for (const auto& p : Grid("O16").xy()) {
+            points.emplace_back(p);
+        }
+        check(UnstructuredGrid(std::move(points)));
+    }
+    SECTION("regional") { check(Grid("L40x20", RectangularDomain({-10., 30.}, {40., 50.}))); }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
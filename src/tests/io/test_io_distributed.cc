@@ -0,0 +1,132 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <string>
+
+#include "eckit/config/Resource.h"
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid/Partitioner.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/io/DistributedRecord.h"
+#include "atlas/option.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+std::string suffix() {
+    static std::string suffix = eckit::Resource<std::string>("--suffix", "");
+    return suffix;
+}
+
+// With "--read <suffix>" the record written by another test, e.g. with a different number of tasks, is read
+// instead of writing a new one
+std::string read_suffix() {
+    static std::string suffix = eckit::Resource<std::string>("--read", "");
+    return suffix;
+}
+
+std::string path() {
+    return "distributed.atlas" + (read_suffix().empty() ? suffix() : read_suffix());
+}
+
+double expected(gidx_t g, idx_t level) {
+    return double(g) * 100. + double(level);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("write distributed fields") {
+    if (not read_suffix().empty()) {
+        Log::info() << "Reading record " << path() << " written by another test" << std::endl;
+        return;
+    }
+    functionspace::StructuredColumns fs(Grid("O16"), grid::Partitioner("equal_regions"), option::halo(1));
+
+    Field temperature = fs.createField<double>(option::name("temperature") | option::levels(4));
+    Field mask        = fs.createField<int>(option::name("mask"));
+
+    auto global_index = array::make_view<gidx_t, 1>(fs.global_index());
+    auto t            = array::make_view<double, 2>(temperature);
+    auto m            = array::make_view<int, 1>(mask);
+    for (idx_t j = 0; j < fs.size(); ++j) {
+        for (idx_t k = 0; k < t.shape(1); ++k) {
+            t(j, k) = expected(global_index(j), k);
+        }
+        m(j) = int(global_index(j) % 7);
+    }
+
+    io::DistributedRecordWriter writer;
+    writer.set(temperature);
+    writer.set(mask);
+    EXPECT_NO_THROW(writer.write(path()));
+}
+
+CASE("read distributed fields with different distribution") {
+    functionspace::StructuredColumns fs(Grid("O16"), grid::Partitioner("checkerboard"), option::halo(2));
+
+    Field temperature = fs.createField<double>(option::name("temperature") | option::levels(4));
+    Field mask        = fs.createField<int>(option::name("mask"));
+
+    io::DistributedRecordReader reader(path());
+    reader.read(temperature);
+    reader.read(mask);
+
+    auto global_index = array::make_view<gidx_t, 1>(fs.global_index());
+    auto t            = array::make_view<double, 2>(temperature);
+    auto m            = array::make_view<int, 1>(mask);
+
+    idx_t mismatches = 0;
+    for (idx_t j = 0; j < fs.size(); ++j) {
+        for (idx_t k = 0; k < t.shape(1); ++k) {
+            if (t(j, k) != expected(global_index(j), k)) {
+                ++mismatches;
+            }
+        }
+        if (m(j) != int(global_index(j) % 7)) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+CASE("read unknown field") {
+    functionspace::StructuredColumns fs(Grid("O16"), option::halo(1));
+    Field field = fs.createField<double>(option::name("pressure"));
+
+    io::DistributedRecordReader reader(path());
+    EXPECT_THROWS(reader.read(field));
+}
+
+CASE("read with mismatching shape throws on all tasks") {
+    // Only the tasks reading a segment detect the mismatch; the others must not hang in the data exchange
+    functionspace::StructuredColumns fs(Grid("O16"), option::halo(1));
+    Field field = fs.createField<int>(option::name("mask") | option::levels(2));
+
+    io::DistributedRecordReader reader(path());
+    EXPECT_THROWS(reader.read(field));
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -137,6 +137,34 @@ CASE("matrix matrix multiply (gemm)") {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+CASE("matrix matrix multiply (gemm) in single precision") {
+    // Column-major: A is 3x2, B is 2x4
+    std::vector<float> a{1.f, -4.f, 2.f, -2.f, 2.f, 0.5f};
+    std::vector<float> b{1.f, 0.f, 0.f, 1.f, 2.f, -1.f, -3.f, 4.f};
+    std::vector<float> z(3 * 4);
+    for (size_t j = 0; j < 4; ++j) {
+        for (size_t i = 0; i < 3; ++i) {
+            z[i + 3 * j] = a[i] * b[2 * j] + a[i + 3] * b[1 + 2 * j];
+        }
+    }
+    MatrixFloat A(a.data(), 3, 2);
+    MatrixFloat B(b.data(), 2, 4);
+
+    std::vector<std::string> backends{"eckit_linalg", "generic", "openmp", "lapack", "mkl", "eigen"};
+    for (auto& backend : backends) {
+        if (dense::Backend{backend}.available()) {
+            SECTION(backend) {
+                std::vector<float> y(3 * 4, -42.f);
+                MatrixFloat Y(y.data(), 3, 4);
+                linalg::matrix_multiply(A, B, Y, dense::Backend{backend});
+                EXPECT(y == z);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
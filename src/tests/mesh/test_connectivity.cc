@@ -9,6 +9,7 @@
  */
 
 #include "atlas/library/defines.h"
+#include "atlas/mesh/CompactConnectivity.h"
 #include "atlas/mesh/Connectivity.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -515,6 +516,62 @@ CASE("test_multi_block_connectivity_insert") {
     }
 }
 
+CASE("test_compact_connectivity") {
+    // Irregular connectivity with missing values, small and large ranges of values
+    IrregularConnectivity conn("compact");
+    std::vector<idx_t> row;
+    for (idx_t r = 0; r < 1000; ++r) {
+        idx_t cols = 1 + r % 6;
+        row.resize(cols);
+        for (idx_t c = 0; c < cols; ++c) {
+            row[c] = (r > 500 && r < 540) ? r * 100000 + c : 3 * r + c;
+        }
+        if (r % 7 == 0) {
+            row[cols - 1] = conn.missing_value();
+        }
+        conn.add(1, cols, row.data());
+    }
+
+    CompactConnectivity compact(conn);
+    EXPECT_EQ(compact.rows(), conn.rows());
+    EXPECT_EQ(compact.maxcols(), conn.maxcols());
+    EXPECT_EQ(compact.wide_chunks(), 2);  // chunks containing rows 501 to 539
+    for (idx_t r = 0; r < conn.rows(); ++r) {
+        EXPECT_EQ(compact.cols(r), conn.cols(r));
+        auto compact_row = compact.row(r);
+        for (idx_t c = 0; c < conn.cols(r); ++c) {
+            EXPECT_EQ(compact(r, c), conn(r, c));
+            EXPECT_EQ(compact_row(c), conn(r, c));
+        }
+    }
+    EXPECT(compact.footprint() < conn.footprint());
+
+    IrregularConnectivity expanded("expanded");
+    compact.expand(expanded);
+    EXPECT_EQ(expanded.rows(), conn.rows());
+    for (idx_t r = 0; r < conn.rows(); ++r) {
+        for (idx_t c = 0; c < conn.cols(r); ++c) {
+            EXPECT_EQ(expanded(r, c), conn(r, c));
+        }
+    }
+
+    // Block connectivity
+    idx_t vals[15] = {3, 7, 1, 4, 5, 6, 4, 56, 8, 4, 1, 3, 76, 4, 3};
+    BlockConnectivity block(3, 5, vals);
+    CompactConnectivity compact_block(block);
+    BlockConnectivity expanded_block;
+    compact_block.expand(expanded_block);
+    EXPECT_EQ(expanded_block.rows(), 3);
+    EXPECT_EQ(expanded_block.cols(), 5);
+    for (idx_t r = 0; r < 3; ++r) {
+        for (idx_t c = 0; c < 5; ++c) {
+            EXPECT_EQ(compact_block(r, c), block(r, c));
+            EXPECT_EQ(expanded_block(r, c), block(r, c));
+        }
+    }
+    EXPECT_THROWS_AS(CompactConnectivity(conn).expand(expanded_block), eckit::AssertionFailed);
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
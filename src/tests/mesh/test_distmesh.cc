@@ -27,6 +27,7 @@
 #include "atlas/mesh/actions/WriteLoadBalanceReport.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/CoordinateEnums.h"
 
@@ -131,6 +132,69 @@ CASE("test_distribute_t63") {
 }
 //-----------------------------------------------------------------------------
 
+CASE("test_distribute_graph") {
+    StructuredMeshGenerator generate(util::Config("partitioner", "graph"));
+
+    Grid grid("O16");
+
+    Mesh m(generate(grid));
+
+    mesh::actions::build_parallel_fields(m);
+    mesh::actions::build_periodic_boundaries(m);
+    mesh::actions::build_halo(m, 1);
+    mesh::actions::build_edges(m);
+    mesh::actions::build_edges_parallel_fields(m);
+    mesh::actions::build_median_dual_mesh(m);
+
+    double computed_dual_volume = test::dual_volume(m);
+    EXPECT(eckit::types::is_approximately_equal(computed_dual_volume, 360. * 180., 0.0001));
+
+    std::stringstream report;
+    mesh::actions::write_load_balance_report(m, report);
+    if (mpi::rank() == 0) {
+        Log::info() << report.str() << std::endl;
+        EXPECT(report.str().find("cedges") != std::string::npos);
+    }
+}
+//-----------------------------------------------------------------------------
+
+CASE("test_dual_mesh independent of number of threads") {
+    Grid grid("O16");
+    auto dual_mesh = [&grid](int num_threads) {
+        const int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads(num_threads);
+        Mesh m = StructuredMeshGenerator().generate(grid);
+        mesh::actions::build_parallel_fields(m);
+        mesh::actions::build_periodic_boundaries(m);
+        mesh::actions::build_halo(m, 1);
+        mesh::actions::build_edges(m);
+        mesh::actions::build_edges_parallel_fields(m);
+        mesh::actions::build_median_dual_mesh(m);
+        atlas_omp_set_num_threads(max_threads);
+        return m;
+    };
+
+    Mesh serial   = dual_mesh(1);
+    Mesh threaded = dual_mesh(atlas_omp_get_max_threads());
+
+    auto dual_volumes_serial   = array::make_view<double, 1>(serial.nodes().field("dual_volumes"));
+    auto dual_volumes_threaded = array::make_view<double, 1>(threaded.nodes().field("dual_volumes"));
+    EXPECT_EQ(dual_volumes_threaded.size(), dual_volumes_serial.size());
+    for (idx_t jnode = 0; jnode < dual_volumes_serial.size(); ++jnode) {
+        EXPECT_EQ(dual_volumes_threaded(jnode), dual_volumes_serial(jnode));
+    }
+
+    auto dual_normals_serial   = array::make_view<double, 2>(serial.edges().field("dual_normals"));
+    auto dual_normals_threaded = array::make_view<double, 2>(threaded.edges().field("dual_normals"));
+    EXPECT_EQ(dual_normals_threaded.shape(0), dual_normals_serial.shape(0));
+    for (idx_t jedge = 0; jedge < dual_normals_serial.shape(0); ++jedge) {
+        EXPECT_EQ(dual_normals_threaded(jedge, XX), dual_normals_serial(jedge, XX));
+        EXPECT_EQ(dual_normals_threaded(jedge, YY), dual_normals_serial(jedge, YY));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
@@ -15,9 +15,11 @@
 #include "atlas/field/Field.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/library/config.h"
+#include "atlas/mesh/CompactConnectivity.h"
 #include "atlas/mesh/Connectivity.h"
 #include "atlas/mesh/ElementType.h"
 #include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator.h"
@@ -402,6 +404,52 @@ CASE("cells_add_add") {
     EXPECT(cells.elements(0).node_connectivity()(0, 3) == 3);
 }
 
+CASE("cells_compact") {
+    Mesh mesh = StructuredMeshGenerator().generate(Grid("O16"));
+    HybridElements& cells = mesh.cells();
+    EXPECT(cells.nb_types() == 2);
+
+    const MultiBlockConnectivity& conn = cells.node_connectivity();
+    const idx_t rows                   = conn.rows();
+    std::vector<std::vector<idx_t>> values(rows);
+    for (idx_t r = 0; r < rows; ++r) {
+        for (idx_t c = 0; c < conn.cols(r); ++c) {
+            values[r].push_back(conn(r, c));
+        }
+    }
+    const size_t footprint = cells.footprint();
+
+    cells.compact();
+    EXPECT(cells.compacted());
+    EXPECT(conn.rows() == 0);
+    EXPECT(cells.elements(0).node_connectivity().rows() == 0);
+    EXPECT(cells.footprint() < footprint);
+    const CompactConnectivity& compact = cells.compact_connectivity("node");
+    EXPECT(compact.rows() == rows);
+    for (idx_t r = 0; r < rows; ++r) {
+        EXPECT(compact.cols(r) == idx_t(values[r].size()));
+        for (idx_t c = 0; c < compact.cols(r); ++c) {
+            EXPECT(compact(r, c) == values[r][c]);
+        }
+    }
+    EXPECT_THROWS(cells.add(ElementType::create("Triangle"), 1));
+
+    cells.expand();
+    EXPECT(not cells.compacted());
+    EXPECT_THROWS(cells.compact_connectivity("node"));
+    EXPECT(conn.rows() == rows);
+    EXPECT(conn.blocks() == cells.nb_types());
+    for (idx_t t = 0; t < cells.nb_types(); ++t) {
+        const Elements& elements = cells.elements(t);
+        EXPECT(elements.node_connectivity().rows() == elements.size());
+        for (idx_t e = 0; e < elements.size(); ++e) {
+            for (idx_t n = 0; n < elements.nb_nodes(); ++n) {
+                EXPECT(elements.node_connectivity()(e, n) == values[elements.begin() + e][n]);
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
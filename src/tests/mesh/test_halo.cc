@@ -246,6 +246,44 @@ CASE("test_custom") {
 #endif
 //-----------------------------------------------------------------------------
 
+CASE("test neighbour-only exchange matches exchange with all partitions") {
+    auto build = [](bool all_partitions) {
+        Mesh m = test::generate_mesh(StructuredGrid("O16"));
+        mesh::actions::build_nodes_parallel_fields(m.nodes());
+        mesh::actions::build_periodic_boundaries(m);
+        mesh::actions::BuildHalo build_halo(m);
+        build_halo.all_partitions_ = all_partitions;
+        build_halo(3);
+        return m;
+    };
+    Mesh mesh      = build(false);
+    Mesh reference = build(true);
+
+    EXPECT_EQ(mesh.nodes().size(), reference.nodes().size());
+    EXPECT_EQ(mesh.cells().size(), reference.cells().size());
+
+    auto glb_idx     = array::make_view<gidx_t, 1>(mesh.nodes().global_index());
+    auto glb_idx_ref = array::make_view<gidx_t, 1>(reference.nodes().global_index());
+    auto part        = array::make_view<int, 1>(mesh.nodes().partition());
+    auto part_ref    = array::make_view<int, 1>(reference.nodes().partition());
+    auto xy          = array::make_view<double, 2>(mesh.nodes().xy());
+    auto xy_ref      = array::make_view<double, 2>(reference.nodes().xy());
+    for (idx_t n = 0; n < std::min(mesh.nodes().size(), reference.nodes().size()); ++n) {
+        EXPECT_EQ(glb_idx(n), glb_idx_ref(n));
+        EXPECT_EQ(part(n), part_ref(n));
+        EXPECT_EQ(xy(n, XX), xy_ref(n, XX));
+        EXPECT_EQ(xy(n, YY), xy_ref(n, YY));
+    }
+
+    auto cell_glb_idx     = array::make_view<gidx_t, 1>(mesh.cells().global_index());
+    auto cell_glb_idx_ref = array::make_view<gidx_t, 1>(reference.cells().global_index());
+    for (idx_t e = 0; e < std::min(mesh.cells().size(), reference.cells().size()); ++e) {
+        EXPECT_EQ(cell_glb_idx(e), cell_glb_idx_ref(e));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
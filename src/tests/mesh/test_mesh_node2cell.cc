@@ -20,6 +20,7 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/Unique.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -354,6 +355,36 @@ CASE("test_node2cell_AtlasGrids") {
 
 //-----------------------------------------------------------------------------
 
+CASE("test_node2cell independent of number of threads") {
+    auto grid = Grid("O16");
+    Mesh mesh = StructuredMeshGenerator().generate(grid);
+    mesh::actions::build_parallel_fields(mesh);
+    mesh::actions::build_periodic_boundaries(mesh);
+    mesh::actions::build_halo(mesh, 1);
+
+    auto node_to_cell = [&mesh](int num_threads) {
+        const int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads(num_threads);
+        mesh::actions::build_node_to_cell_connectivity(mesh);
+        atlas_omp_set_num_threads(max_threads);
+        std::vector<idx_t> values;
+        const auto& connectivity = mesh.nodes().cell_connectivity();
+        for (idx_t jnode = 0; jnode < connectivity.rows(); ++jnode) {
+            values.emplace_back(connectivity.cols(jnode));
+            for (idx_t jcell = 0; jcell < connectivity.cols(jnode); ++jcell) {
+                values.emplace_back(connectivity(jnode, jcell));
+            }
+        }
+        return values;
+    };
+
+    auto serial = node_to_cell(1);
+    EXPECT(node_to_cell(atlas_omp_get_max_threads()) == serial);
+    EXPECT(node_to_cell(3) == serial);
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
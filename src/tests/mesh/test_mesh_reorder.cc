@@ -11,7 +11,15 @@
 
 //-----------------------------------------------------------------
 
+#include <algorithm>
 #include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
 
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
@@ -20,6 +28,7 @@
 
 #include "atlas/mesh/actions/BuildEdges.h"
 #include "atlas/mesh/actions/Reorder.h"
+#include "atlas/mesh/actions/WriteLocalityReport.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -360,6 +369,73 @@ CASE("test_none_reordering") {
     test_reordering(reorder_config);
 }
 
+CASE("test_reordering_locality") {
+    auto mesh = StructuredMeshGenerator(util::Config("patch_pole", false)("triangulate", true))(Grid("O16"));
+    mesh::actions::build_edges(mesh);
+
+    auto edges_as_global_node_pairs = [](const Mesh& mesh) {
+        auto glb_idx                  = array::make_view<gidx_t, 1>(mesh.nodes().global_index());
+        const auto& node_connectivity = mesh.edges().node_connectivity();
+        std::set<std::pair<gidx_t, gidx_t>> pairs;
+        for (idx_t e = 0; e < mesh.edges().size(); ++e) {
+            gidx_t g0 = glb_idx(node_connectivity(e, 0));
+            gidx_t g1 = glb_idx(node_connectivity(e, 1));
+            pairs.emplace(std::min(g0, g1), std::max(g0, g1));
+        }
+        return pairs;
+    };
+    const auto edges = edges_as_global_node_pairs(mesh);
+
+    auto stats_default = mesh::actions::compute_locality_statistics(mesh);
+    EXPECT_EQ(stats_default.nb_edges, mesh.edges().size());
+    EXPECT(stats_default.node_bandwidth > 0);
+
+    // Random permutation of the nodes
+    std::vector<idx_t> order(mesh.nodes().size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(0));
+    std::vector<gidx_t> glb_idx_before(order.size());
+    {
+        auto glb_idx = array::make_view<gidx_t, 1>(mesh.nodes().global_index());
+        for (size_t n = 0; n < order.size(); ++n) {
+            glb_idx_before[n] = glb_idx(n);
+        }
+    }
+    mesh::actions::ReorderImpl::reorderNodes(mesh, order);
+    {
+        auto glb_idx = array::make_view<gidx_t, 1>(mesh.nodes().global_index());
+        for (size_t n = 0; n < order.size(); ++n) {
+            EXPECT_EQ(glb_idx(n), glb_idx_before[order[n]]);
+        }
+    }
+    EXPECT(edges_as_global_node_pairs(mesh) == edges);
+
+    auto stats_random = mesh::actions::compute_locality_statistics(mesh);
+    EXPECT(stats_random.node_neighbour_distance > stats_default.node_neighbour_distance);
+
+    for (std::string type : {"hilbert", "reverse_cuthill_mckee"}) {
+        SECTION(type) {
+            mesh::actions::Reorder{option::type(type)}(mesh);
+            EXPECT(edges_as_global_node_pairs(mesh) == edges);
+
+            auto stats = mesh::actions::compute_locality_statistics(mesh);
+            EXPECT(stats.node_neighbour_distance < stats_random.node_neighbour_distance);
+            EXPECT(stats.node2edge_span < stats_random.node2edge_span);
+            EXPECT(stats.cell2node_span < stats_random.cell2node_span);
+            Log::info() << type << std::endl;
+            mesh::actions::write_locality_report(mesh, Log::info());
+
+            // The report does not change the formatting state of the stream
+            std::ostringstream out;
+            out << std::setprecision(7);
+            mesh::actions::write_locality_report(mesh, out);
+            EXPECT(out.str().find("node neighbours") != std::string::npos);
+            EXPECT(out.flags() == std::ostringstream().flags());
+            EXPECT_EQ(out.precision(), 7);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
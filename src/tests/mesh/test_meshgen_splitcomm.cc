@@ -13,6 +13,7 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/grid/Partitioner.h"
+#include "atlas/grid/detail/partitioner/MatchingMeshPartitionerLonLatPolygon.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -240,6 +241,32 @@ CASE("MatchingPartitioner") {
     mesh_B.polygon().outputPythonScript(grid_B().name()+"_polygons_3.py");
 }
 
+CASE("MatchingPartitioner scalable") {
+    Fixture fixture;
+
+    auto mesh_A = Mesh(grid_A(), option::mpi_comm("split"));
+
+    auto distribution = grid::MatchingPartitioner(mesh_A).partition(grid_B());
+
+    grid::MatchingPartitioner partitioner(mesh_A, util::Config("scalable", true));
+    auto distribution_scalable = partitioner.partition(grid_B());
+    for (gidx_t n = 0; n < grid_B().size(); ++n) {
+        EXPECT_EQ(distribution_scalable.partition(n), distribution.partition(n));
+    }
+    EXPECT(distribution_scalable.nb_pts() == distribution.nb_pts());
+    // Stored as ranges of global indices instead of a global partitioning array
+    EXPECT(distribution_scalable.footprint() < distribution.footprint());
+
+    auto matching = dynamic_cast<const grid::detail::partitioner::MatchingMeshPartitionerLonLatPolygon*>(partitioner.get());
+    EXPECT(matching != nullptr);
+    std::vector<gidx_t> local = matching->partition_local(grid_B());
+    int mpi_rank              = mpi::comm("split").rank();
+    EXPECT_EQ(idx_t(local.size()), distribution.nb_pts()[mpi_rank]);
+    for (gidx_t n : local) {
+        EXPECT_EQ(distribution.partition(n), mpi_rank);
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
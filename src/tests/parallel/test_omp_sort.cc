@@ -10,10 +10,13 @@
 
 #include <algorithm>   // generate, is_sorted
 #include <functional>  // bind
+#include <limits>      // numeric_limits
 #include <random>      // mt19937 and uniform_int_distribution
 #include <vector>      // vector
 
+#include "atlas/parallel/omp/radix_sort.h"
 #include "atlas/parallel/omp/sort.h"
+#include "atlas/parallel/omp/unique.h"
 #include "atlas/util/vector.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -85,6 +88,111 @@ CASE("test_merge_blocks") {
     EXPECT(std::is_sorted(integers.begin(), integers.end()));
 }
 
+struct Entity {
+    Entity() = default;
+    Entity(gidx_t _g, idx_t _i): g(_g), i(_i) {}
+    gidx_t g;
+    idx_t i;
+};
+
+std::vector<Entity> create_random_entities(int n, gidx_t range) {
+    auto integers = create_random_data(n);
+    std::vector<Entity> entities;
+    entities.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        entities.emplace_back(integers[i] % range - range / 2, i);
+    }
+    return entities;
+}
+
+CASE("test_stable_sort") {
+    auto entities = create_random_entities(1000000, 1000);
+    auto compare  = [](const Entity& a, const Entity& b) { return a.g < b.g; };
+
+    auto expected = entities;
+    std::stable_sort(expected.begin(), expected.end(), compare);
+
+    omp::stable_sort(entities.begin(), entities.end(), compare);
+    for (size_t j = 0; j < entities.size(); ++j) {
+        EXPECT_EQ(entities[j].g, expected[j].g);
+        EXPECT_EQ(entities[j].i, expected[j].i);
+    }
+}
+
+CASE("test_radix_sort") {
+    SECTION("little") {
+        std::vector<int> integers{5, -3, 7, -100, 0, 2, 2, std::numeric_limits<int>::min()};
+        omp::radix_sort(integers.begin(), integers.end());
+        EXPECT(std::is_sorted(integers.begin(), integers.end()));
+    }
+
+    SECTION("large") {
+        auto integers = create_random_data(1000000);
+        omp::radix_sort(integers.begin(), integers.end());
+        EXPECT(std::is_sorted(integers.begin(), integers.end()));
+    }
+
+    SECTION("stable with key") {
+        // Ties keep their original order, as with std::stable_sort
+        auto entities = create_random_entities(1000000, 1000);
+        auto expected = entities;
+        std::stable_sort(expected.begin(), expected.end(), [](const Entity& a, const Entity& b) { return a.g < b.g; });
+
+        omp::radix_sort(entities.begin(), entities.end(), [](const Entity& e) { return e.g; });
+        for (size_t j = 0; j < entities.size(); ++j) {
+            EXPECT_EQ(entities[j].g, expected[j].g);
+            EXPECT_EQ(entities[j].i, expected[j].i);
+        }
+    }
+}
+
+CASE("test_sort_by_key") {
+    auto keys = create_random_data(1000000);
+    for (auto& key : keys) {
+        key %= 1000;
+    }
+    std::vector<idx_t> values(keys.size());
+    for (size_t j = 0; j < values.size(); ++j) {
+        values[j] = j;
+    }
+
+    SECTION("integral keys") {
+        omp::sort_by_key(keys.begin(), keys.end(), values.begin());
+        EXPECT(std::is_sorted(keys.begin(), keys.end()));
+        for (size_t j = 1; j < values.size(); ++j) {
+            if (keys[j] == keys[j - 1]) {
+                EXPECT(values[j] > values[j - 1]);
+            }
+        }
+    }
+
+    SECTION("with comparison") {
+        auto greater = [](const int& a, const int& b) { return a > b; };
+        omp::sort_by_key(keys.begin(), keys.end(), values.begin(), greater);
+        EXPECT(std::is_sorted(keys.begin(), keys.end(), greater));
+        for (size_t j = 1; j < values.size(); ++j) {
+            if (keys[j] == keys[j - 1]) {
+                EXPECT(values[j] > values[j - 1]);
+            }
+        }
+    }
+}
+
+CASE("test_unique") {
+    auto integers = create_random_data(1000000);
+    for (auto& integer : integers) {
+        integer %= 1000;
+    }
+    omp::sort(integers.begin(), integers.end());
+
+    std::vector<int> expected(integers.begin(), integers.end());
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+    auto end = omp::unique(integers.begin(), integers.end());
+    EXPECT_EQ(static_cast<size_t>(std::distance(integers.begin(), end)), expected.size());
+    EXPECT(std::equal(integers.begin(), end, expected.begin()));
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -9,10 +9,16 @@
  */
 
 #include <chrono>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/Memory.h"
+#include "atlas/util/Config.h"
 #include "tests/AtlasTestEnvironment.h"
 
 
@@ -59,14 +65,59 @@ CASE("test trace OpenMP") {
             work();
 
             trace.stop();
-            if (atlas_omp_get_thread_num() > 0) {
-                EXPECT(trace.elapsed() == 0.);
+            EXPECT(trace.elapsed() != 0.);
+        }
+    }
+}
+
+CASE("test trace OpenMP nesting and report") {
+    {
+        auto outer = Trace(Here(), "omp outer");
+        atlas_omp_parallel_for(int i = 0; i < 20; ++i) {
+            auto inner = Trace(Here(), "omp inner");
+            work();
+        }
+    }
+    auto count = [](const std::string& report, const std::string& title) {
+        int n = 0;
+        for (size_t pos = report.find(title); pos != std::string::npos; pos = report.find(title, pos + 1)) {
+            ++n;
+        }
+        return n;
+    };
+
+    // Traces on all threads are accumulated in a single timer, nested in the enclosing trace
+    std::string report = runtime::trace::Timings::report(util::Config("threads", false));
+    Log::info() << report << std::endl;
+    EXPECT_EQ(count(report, "omp inner"), 1);
+    EXPECT_EQ(count(report, "@thread"), 0);
+    EXPECT(report.find(" : \u2514\u2500omp inner") == std::string::npos);  // not a top-level timer
+    EXPECT(report.find(" : \u251C\u2500omp inner") == std::string::npos);  // not a top-level timer
+
+    // Load balance across threads is reported separately
+    std::string threads_report = runtime::trace::Timings::report(util::Config("threads", true));
+    Log::info() << threads_report << std::endl;
+    EXPECT_EQ(count(threads_report, "omp inner"), 2);
+    EXPECT(threads_report.find("max/avg") != std::string::npos);
+}
+
+CASE("test report while other threads record timings") {
+    std::vector<size_t> report_size(40, 1);
+    {
+        auto outer = Trace(Here(), "omp report outer");
+        atlas_omp_parallel_for(int i = 0; i < 40; ++i) {
+            if (i % 10 == 0) {
+                report_size[i] = runtime::trace::Timings::report().size();
             }
             else {
-                EXPECT(trace.elapsed() != 0.);
+                auto inner = Trace(Here(), "omp report inner");
+                work();
             }
         }
     }
+    for (size_t size : report_size) {
+        EXPECT(size > 0);
+    }
 }
 
 CASE("test barrier") {
@@ -132,6 +183,69 @@ CASE("test report") {
     Log::info() << atlas::Trace::report() << std::endl;
 }
 
+CASE("test memory owners") {
+    using runtime::trace::Memory;
+    auto& owner = Memory::owner("test", "owner");
+    SECTION("explicit accounting") {
+        owner.allocate(1000);
+        owner.allocate(500);
+        owner.deallocate(1000);
+        EXPECT_EQ(owner.bytes(), 500);
+        EXPECT_EQ(owner.high(), 1500);
+        EXPECT_EQ(owner.allocations(), 1);
+        EXPECT_EQ(&Memory::owner("test", "owner"), &owner);
+        EXPECT_EQ(Memory::owner("test", "total").bytes(), 0);  // different from type total
+        owner.deallocate(500);
+    }
+    SECTION("scopes") {
+        auto& outer = Memory::current();
+        {
+            Memory::Scope scope(owner);
+            EXPECT_EQ(&Memory::current(), &owner);
+            EXPECT_EQ(&Memory::current("Field", "x"), &owner);
+            {
+                Memory::Scope nested("test", "nested");
+                EXPECT_EQ(Memory::current().name(), std::string("nested"));
+            }
+            EXPECT_EQ(&Memory::current(), &owner);
+        }
+        EXPECT_EQ(&Memory::current(), &outer);
+        EXPECT_EQ(Memory::current("Field", "x").name(), std::string("x"));
+    }
+    SECTION("bounded number of owners") {
+        for (size_t n = 0; n < Memory::max_owners_per_type; ++n) {
+            Memory::owner("test-bounded", std::to_string(n));
+        }
+        auto& other = Memory::owner("test-bounded", "one too many");
+        EXPECT_EQ(other.name(), std::string("(other)"));
+        EXPECT_EQ(&Memory::owner("test-bounded", "another one"), &other);
+        EXPECT_EQ(Memory::owner("test-bounded", "0").name(), std::string("0"));
+    }
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+    SECTION("fields") {
+        auto& field_owner = Memory::owner("Field", "test_memory_owners");
+        {
+            Field field("test_memory_owners", array::make_datatype<double>(), array::make_shape(100, 10));
+            EXPECT_EQ(field_owner.bytes(), 1000 * sizeof(double));
+            field.resize(array::make_shape(200, 10));
+            EXPECT_EQ(field_owner.bytes(), field.array().capacity() * 10 * sizeof(double));
+            field.rename("test_memory_owners_renamed");
+            EXPECT_EQ(field_owner.bytes(), 0);
+            EXPECT(Memory::owner("Field", "test_memory_owners_renamed").bytes() > 0);
+        }
+        EXPECT_EQ(Memory::owner("Field", "test_memory_owners_renamed").bytes(), 0);
+        EXPECT_EQ(field_owner.high(), 200 * 10 * sizeof(double) + 1000 * sizeof(double));
+        {
+            Memory::Scope scope(owner);
+            Field field("scoped", array::make_datatype<int>(), array::make_shape(50));
+            EXPECT_EQ(owner.bytes(), 50 * sizeof(int));
+        }
+        EXPECT_EQ(owner.bytes(), 0);
+    }
+#endif
+    Log::info() << Memory::report(util::Config("top", 5)) << std::endl;
+}
+
 // --------------------------------------------------------------------------
 
 
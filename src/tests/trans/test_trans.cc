@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/filesystem/PathName.h"
@@ -33,6 +34,9 @@
 #include "atlas/trans/Trans.h"
 #include "atlas/trans/VorDivToUV.h"
 #include "atlas/trans/detail/TransFactory.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/Constants.h"
+#include "atlas/util/CoordinateEnums.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -516,6 +520,55 @@ CASE("test_trans_using_functionspace_StructuredColumns") {
     EXPECT_THROWS_AS(trans.dirtrans(gpfields, spfields), eckit::Exception);
 }
 
+CASE("test_trans_using_functionspace_StructuredColumns with space-filling curve ordering") {
+    Grid grid("O48");
+    functionspace::StructuredColumns gp_ij(grid, grid::Partitioner("ectrans"));
+    functionspace::StructuredColumns gp(grid, grid::Partitioner("ectrans"), util::Config("ordering", "hilbert"));
+    functionspace::Spectral sp(47);
+    EXPECT_EQ(gp.ordering(), std::string("hilbert"));
+
+    trans::Trans trans_ij(gp_ij, sp);
+    trans::Trans trans(gp, sp);
+
+    Field gpf_ij = gp_ij.createField<double>(option::name("gpf"));
+    Field gpf    = gp.createField<double>(option::name("gpf"));
+    Field spf_ij = sp.createField<double>(option::name("spf"));
+    Field spf    = sp.createField<double>(option::name("spf"));
+
+    auto fill = [](const functionspace::StructuredColumns& fs, Field& field) {
+        auto xy    = array::make_view<double, 2>(fs.xy());
+        auto value = array::make_view<double, 1>(field);
+        value.assign(0.);
+        for (idx_t n = 0; n < fs.sizeOwned(); ++n) {
+            const double lon = xy(n, XX) * util::Constants::degreesToRadians();
+            const double lat = xy(n, YY) * util::Constants::degreesToRadians();
+            value(n)         = std::cos(lat) * std::cos(lon) + std::sin(2. * lat);
+        }
+    };
+    fill(gp_ij, gpf_ij);
+    fill(gp, gpf);
+
+    trans_ij.dirtrans(gpf_ij, spf_ij);
+    trans.dirtrans(gpf, spf);
+
+    auto sp_ij = array::make_view<double, 1>(spf_ij);
+    auto sp_h  = array::make_view<double, 1>(spf);
+    for (idx_t n = 0; n < sp_h.size(); ++n) {
+        EXPECT_APPROX_EQ(sp_h(n), sp_ij(n), 1.e-12);
+    }
+
+    trans_ij.invtrans(spf_ij, gpf_ij);
+    trans.invtrans(spf_ij, gpf);
+
+    auto value_ij = array::make_view<double, 1>(gpf_ij);
+    auto value    = array::make_view<double, 1>(gpf);
+    for (idx_t j = gp.j_begin(); j < gp.j_end(); ++j) {
+        for (idx_t i = gp.i_begin(j); i < gp.i_end(j); ++i) {
+            EXPECT_APPROX_EQ(value(gp.index(i, j)), value_ij(gp_ij.index(i, j)), 1.e-12);
+        }
+    }
+}
+
 CASE("test_trans_MIR_lonlat") {
     Log::info() << "test_trans_MIR_lonlat" << std::endl;
 
@@ -12,6 +12,10 @@
 #include <cmath>
 #include <iomanip>
 #include <numeric>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
 
 #include "atlas/array/MakeView.h"
 #include "atlas/field/FieldSet.h"
@@ -29,6 +33,7 @@
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/trans/LegendreCacheCreator.h"
 #include "atlas/trans/Trans.h"
 #include "atlas/trans/ifs/TransIFS.h"
 #include "atlas/trans/local/TransLocal.h"
@@ -1838,6 +1843,125 @@ CASE( "test_trans_fourier_truncation" ) {
     // TODO: create some real criterion to test fourier_truncation. So far only comparison with trans library through print statements.
 }
 #endif
+
+//-----------------------------------------------------------------------------
+
+// Inverse transform the same analytic spectra (2 scalar fields and 1 vor/div pair) with both transforms,
+// check the relative difference against tolerance, and return the gridpoint values of the second transform.
+std::vector<double> compare_invtrans(const Grid& g, const trans::Trans& reference, const trans::Trans& trans,
+                                     double tolerance, const std::string& label) {
+    const int nb_scalar_fields = 2;
+    const int nb_vordiv_fields = 1;
+    const int nb_spec          = reference.spectralCoefficients();
+    std::vector<double> scalar(nb_scalar_fields * nb_spec);
+    std::vector<double> vor(nb_vordiv_fields * nb_spec);
+    std::vector<double> div(nb_vordiv_fields * nb_spec);
+    auto fill = [](std::vector<double>& sp, int seed) {
+        for (size_t k = 0; k < sp.size(); ++k) {
+            sp[k] = std::sin(0.37 * double(k + seed)) / (1. + 0.01 * double(k));
+        }
+    };
+    fill(scalar, 1);
+    fill(vor, 2);
+    fill(div, 3);
+
+    const size_t nb_gp = (nb_scalar_fields + 2 * nb_vordiv_fields) * g.size();
+    std::vector<double> gp_reference(nb_gp);
+    std::vector<double> gp(nb_gp);
+    reference.invtrans(nb_scalar_fields, scalar.data(), nb_vordiv_fields, vor.data(), div.data(), gp_reference.data());
+    trans.invtrans(nb_scalar_fields, scalar.data(), nb_vordiv_fields, vor.data(), div.data(), gp.data());
+
+    double max_value = 0.;
+    double max_error = 0.;
+    for (size_t j = 0; j < nb_gp; ++j) {
+        max_value = std::max(max_value, std::abs(gp_reference[j]));
+        max_error = std::max(max_error, std::abs(gp_reference[j] - gp[j]));
+    }
+    Log::info() << "    relative error " << label << ": " << max_error / max_value << std::endl;
+    EXPECT(max_value > 0.);
+    EXPECT(max_error < tolerance * max_value);
+    return gp;
+}
+
+CASE("test_trans_local_single_precision") {
+    Log::info() << "test_trans_local_single_precision" << std::endl;
+    // compare single precision TransLocal with the double precision path
+
+    const int trc = 47;
+
+    auto compare = [](const Grid& g, const trans::Trans& trans_dp, const trans::Trans& trans_sp) {
+        return compare_invtrans(g, trans_dp, trans_sp, 1.e-4, "single vs double precision");
+    };
+
+    for (std::string gridname : {"F48", "O48"}) {
+        Log::info() << "  grid " << gridname << std::endl;
+        Grid g(gridname);
+        trans::Trans trans_dp(g, trc, option::type("local"));
+        trans::Trans trans_sp(g, trc, option::type("local") | option::precision("single"));
+        auto gp_sp = compare(g, trans_dp, trans_sp);
+
+        // A single precision Legendre cache gives identical results
+        trans::Cache cache =
+            trans::LegendreCacheCreator(g, trc, option::type("local") | option::precision("single")).create();
+        trans::Cache cache_dp = trans::LegendreCacheCreator(g, trc, option::type("local")).create();
+        EXPECT(2 * cache.legendre().size() == cache_dp.legendre().size());
+        trans::Trans trans_sp_cached(cache, g, trc, option::type("local") | option::precision("single"));
+        auto gp_sp_cached = compare(g, trans_dp, trans_sp_cached);
+        EXPECT(gp_sp == gp_sp_cached);
+    }
+
+    {
+        Log::info() << "  grid F48 without FFT" << std::endl;
+        Grid g("F48");
+        trans::Trans trans_dp(g, trc, option::type("local") | option::no_fft());
+        trans::Trans trans_sp(g, trc, option::type("local") | option::no_fft() | option::precision("single"));
+        compare(g, trans_dp, trans_sp);
+    }
+}
+//-----------------------------------------------------------------------------
+
+CASE("test_trans_local_flt") {
+    Log::info() << "test_trans_local_flt" << std::endl;
+    // compare the fast Legendre transform (butterfly compressed) with the dense Legendre transform
+
+    const int trc = 159;
+
+    auto compare = [](const Grid& g, const trans::Trans& trans_dense, const trans::Trans& trans_flt) {
+        return compare_invtrans(g, trans_dense, trans_flt, 1.e-10, "flt vs dense");
+    };
+
+    for (std::string gridname : {"F160", "O160"}) {
+        Log::info() << "  grid " << gridname << std::endl;
+        Grid g(gridname);
+        trans::Trans trans_dense(g, trc, option::type("local"));
+        trans::Trans trans_flt(g, trc, option::type("local") | option::flt(true));
+        auto gp_flt = compare(g, trans_dense, trans_flt);
+
+        // A Legendre cache with compressed coefficients gives identical results, and is smaller
+        trans::Cache cache = trans::LegendreCacheCreator(g, trc, option::type("local") | option::flt(true)).create();
+        trans::Cache cache_dense = trans::LegendreCacheCreator(g, trc, option::type("local")).create();
+        Log::info() << "    cache size flt: " << cache.legendre().size() << " dense: " << cache_dense.legendre().size()
+                    << std::endl;
+        EXPECT(cache.legendre().size() < cache_dense.legendre().size());
+        trans::Trans trans_flt_cached(cache, g, trc, option::type("local") | option::flt(true));
+        auto gp_flt_cached = compare(g, trans_dense, trans_flt_cached);
+        EXPECT(gp_flt == gp_flt_cached);
+
+        // A dense Legendre cache can also be used, the compression happens at setup
+        trans::Trans trans_flt_dense_cache(cache_dense, g, trc, option::type("local") | option::flt(true));
+        compare(g, trans_dense, trans_flt_dense_cache);
+
+        // A compressed Legendre cache is recognised by its header and cannot be used without "flt"
+        EXPECT_THROWS_AS(trans::Trans(cache, g, trc, option::type("local")), eckit::Exception);
+    }
+
+    {
+        // flt is not silently ignored where it cannot be used
+        Grid gu = UnstructuredGrid(new std::vector<PointXY>{{0., 10.}, {20., 30.}, {40., -50.}});
+        EXPECT_THROWS_AS(trans::Trans(gu, 31, option::type("local") | option::flt(true)), eckit::Exception);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
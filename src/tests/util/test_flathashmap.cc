@@ -0,0 +1,85 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "atlas/util/FlatHashMap.h"
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE("test_flathashset") {
+    util::FlatHashSet<int64_t> set;
+    EXPECT(set.empty());
+    EXPECT(not set.contains(0));
+
+    std::set<int64_t> reference;
+    for (int64_t i = 0; i < 10000; ++i) {
+        int64_t uid = (i * 7919) % 3001 - 1500;  // includes duplicates and negative values
+        EXPECT(set.insert(uid).second == reference.insert(uid).second);
+    }
+    EXPECT_EQ(set.size(), reference.size());
+    for (int64_t uid = -2000; uid < 2000; ++uid) {
+        EXPECT_EQ(set.count(uid), reference.count(uid));
+    }
+
+    std::vector<int64_t> values(set.begin(), set.end());
+    std::sort(values.begin(), values.end());
+    EXPECT(values == std::vector<int64_t>(reference.begin(), reference.end()));
+
+    size_t capacity = set.capacity();
+    set.clear();
+    EXPECT(set.empty());
+    EXPECT(set.begin() == set.end());
+    EXPECT_EQ(set.capacity(), capacity);
+    EXPECT(not set.contains(0));
+}
+
+CASE("test_flathashmap") {
+    util::FlatHashMap<int64_t, int> map(100);
+    EXPECT(map.capacity() >= 100);
+
+    std::map<int64_t, int> reference;
+    for (int i = 0; i < 5000; ++i) {
+        int64_t uid = int64_t(i) << 32;  // strided keys
+        map[uid]       = i;
+        reference[uid] = i;
+    }
+    EXPECT(not map.insert({0, -1}).second);
+    EXPECT_EQ(map[0], 0);
+    EXPECT_EQ(map.size(), reference.size());
+
+    for (auto& entry : reference) {
+        auto found = map.find(entry.first);
+        EXPECT(found != map.end());
+        EXPECT_EQ(found->second, entry.second);
+    }
+    EXPECT(map.find(1) == map.end());
+
+    const auto& const_map = map;
+    EXPECT(const_map.find(int64_t(42) << 32) != const_map.end());
+    EXPECT_EQ(const_map.find(int64_t(42) << 32)->second, 42);
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -8,7 +8,11 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <cstdlib>
+#include <vector>
+
 #include "atlas/util/MicroDeg.h"
+#include "atlas/util/SpaceFillingCurve.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -36,6 +40,52 @@ CASE("convert to microdegrees") {
 
 //-----------------------------------------------------------------------------
 
+CASE("space-filling curve indices") {
+    const int order    = 4;
+    const uint32_t n   = uint32_t(1) << order;
+    const uint64_t nxn = uint64_t(n) * n;
+
+    SECTION("hilbert: bijective, and consecutive indices are neighbouring cells") {
+        std::vector<int> x(nxn, -1);
+        std::vector<int> y(nxn, -1);
+        for (uint32_t j = 0; j < n; ++j) {
+            for (uint32_t i = 0; i < n; ++i) {
+                uint64_t d = hilbert_index(i, j, order);
+                EXPECT(d < nxn);
+                EXPECT_EQ(x[d], -1);
+                x[d] = int(i);
+                y[d] = int(j);
+            }
+        }
+        EXPECT_EQ(x.front(), 0);
+        EXPECT_EQ(y.front(), 0);
+        EXPECT_EQ(x.back(), int(n - 1));
+        EXPECT_EQ(y.back(), 0);
+        for (uint64_t d = 1; d < nxn; ++d) {
+            EXPECT_EQ(std::abs(x[d] - x[d - 1]) + std::abs(y[d] - y[d - 1]), 1);
+        }
+    }
+
+    SECTION("morton: interleaved bits") {
+        EXPECT_EQ(morton_index(0, 0), uint64_t(0));
+        EXPECT_EQ(morton_index(1, 0), uint64_t(1));
+        EXPECT_EQ(morton_index(0, 1), uint64_t(2));
+        EXPECT_EQ(morton_index(3, 3), uint64_t(15));
+        EXPECT_EQ(morton_index(0xFFFFFFFF, 0), uint64_t(0x5555555555555555ULL));
+        std::vector<bool> seen(nxn, false);
+        for (uint32_t j = 0; j < n; ++j) {
+            for (uint32_t i = 0; i < n; ++i) {
+                uint64_t d = morton_index(i, j);
+                EXPECT(d < nxn);
+                EXPECT(not seen[d]);
+                seen[d] = true;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 